@@ -2,6 +2,7 @@
 
 #include <boost/signals2/connection.hpp>
 #include <functional>
+#include <span>
 
 namespace scada {
 
@@ -20,6 +21,7 @@ class AddressSpace {
       std::function<void(const ReferenceType& reference_type,
                          const Node& source,
                          const Node& target)>;
+  using NodesCallback = std::function<void(std::span<const Node* const> nodes)>;
 
   virtual ~AddressSpace() {}
 
@@ -48,6 +50,14 @@ class AddressSpace {
   // Notifies after a reference between two nodes has been deleted.
   [[nodiscard]] virtual boost::signals2::scoped_connection
   SubscribeReferenceDeleted(const ReferenceCallback& callback) const = 0;
+  // Notifies once after a bulk load, in place of the ReferenceAdded and
+  // NodeMoved notifications of the references it added. Reports the added
+  // nodes and the nodes that gained references. An address space that never
+  // loads in bulk never notifies.
+  [[nodiscard]] virtual boost::signals2::scoped_connection SubscribeNodesLoaded(
+      const NodesCallback& callback) const {
+    return {};
+  }
 };
 
 }  // namespace scada
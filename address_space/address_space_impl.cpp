@@ -1,16 +1,34 @@
 #include "address_space/address_space_impl.h"
+#include "base/boost_log.h"
 #include "base/check.h"
+#include "base/no_destructor.h"
 
 #include "address_space/address_space_util.h"
+#include "address_space/node_utils.h"
 #include "address_space/object.h"
 #include "address_space/property_ids.h"
 #include "address_space/reference.h"
 #include "address_space/type_definition.h"
 #include "address_space/variable.h"
+#include "model/node_id_util.h"
 #include "scada/attribute_ids.h"
 #include "scada/standard_node_ids.h"
 #include "scada/status.h"
 
+#include <algorithm>
+#include <functional>
+#include <ranges>
+
+namespace {
+
+BoostLogger& Logger() {
+  static scada::base::NoDestructor<BoostLogger> logger{
+      LOG_NAME("AddressSpace")};
+  return *logger;
+}
+
+}  // namespace
+
 AddressSpaceImpl::AddressSpaceImpl(scada::AddressSpace* parent_address_space)
     : parent_address_space_{parent_address_space} {
   if (parent_address_space_)
@@ -44,6 +62,10 @@ void AddressSpaceImpl::ConnectParentAddressSpace() {
                  const scada::Node& source, const scada::Node& target) {
             reference_deleted_signal_(reference_type, source, target);
           }));
+  parent_connections_.push_back(parent_address_space_->SubscribeNodesLoaded(
+      [this](std::span<const scada::Node* const> nodes) {
+        nodes_loaded_signal_(nodes);
+      }));
 }
 
 AddressSpaceImpl::~AddressSpaceImpl() {
@@ -51,9 +73,21 @@ AddressSpaceImpl::~AddressSpaceImpl() {
 }
 
 void AddressSpaceImpl::Clear() {
-  for (auto& p : node_map_)
-    DeleteAllReferences(*this, *p.second);
-  node_map_.clear();
+  bulk_loaded_nodes_.clear();
+  bulk_added_nodes_.clear();
+  // Latest first: a node's references are usually at the back of the lists of
+  // the nodes added before it, where they are found right away.
+  for (auto* node : node_map_.nodes_ | std::views::reverse) {
+    if (node)
+      DeleteAllReferences(*this, *node);
+  }
+  // Start handles over, so a reloaded configuration doesn't keep the ids of
+  // the previous one interned.
+  node_map_.node_ids_.clear();
+  node_map_.nodes_.clear();
+  node_map_.size_ = 0;
+  type_hierarchy_.Clear();
+  static_nodes_.clear();
 }
 
 bool AddressSpaceImpl::ModifyNode(const scada::NodeId& id,
@@ -124,9 +158,25 @@ void AddressSpaceImpl::AddNode(scada::Node& node) {
   scada::base::Check(!node.id().is_null());
   scada::base::Check(!GetNode(node.id()));
 
-  auto& mapped_node = node_map_[node.id()];
+  auto index = static_cast<size_t>(node_map_.node_ids_.Intern(node.id()));
+  if (index >= node_map_.nodes_.size())
+    node_map_.nodes_.resize(index + 1);
+
+  auto& mapped_node = node_map_.nodes_[index];
   scada::base::Check(!mapped_node);
   mapped_node = &node;
+  ++node_map_.size_;
+
+  if (bulk_loading()) {
+    bulk_loaded_nodes_.push_back(&node);
+    bulk_added_nodes_.insert(&node);
+  }
+
+  // A node shared with another address space stays in that one's index.
+  if (auto* type = scada::AsTypeDefinition(&node);
+      type && !type->hierarchy_index()) {
+    type_hierarchy_.AddType(*type);
+  }
 }
 
 void AddNodeAndReference(AddressSpaceImpl& address_space,
@@ -149,12 +199,11 @@ void AddNodeAndReference(AddressSpaceImpl& address_space,
 }
 
 void AddressSpaceImpl::DeleteNode(const scada::NodeId& id) {
-  auto i = node_map_.find(id);
-  if (i == node_map_.end())
+  auto handle = node_map_.FindHandle(id);
+  auto* node = node_map_.Get(handle);
+  if (!node)
     return;
 
-  auto*& node = i->second;
-
   for (;;) {
     auto children = scada::GetChildren(*node);
     if (children.empty())
@@ -167,15 +216,28 @@ void AddressSpaceImpl::DeleteNode(const scada::NodeId& id) {
 
   NotifyNodeDeleted(*node);
 
-  node_map_.erase(i);
+  if (bulk_loading()) {
+    std::erase(bulk_loaded_nodes_, node);
+    bulk_added_nodes_.erase(node);
+  }
+
+  if (auto* type = scada::AsTypeDefinition(node);
+      type && type->hierarchy_index() == &type_hierarchy_) {
+    type_hierarchy_.RemoveType(*type);
+  }
+
+  auto index = static_cast<size_t>(handle);
+  node_map_.nodes_[index] = nullptr;
+  --node_map_.size_;
+  node_map_.node_ids_.Remove(handle);
 
-  static_nodes_.erase(id);
+  if (index < static_nodes_.size())
+    static_nodes_[index].reset();
 }
 
 scada::Node* AddressSpaceImpl::GetMutableNode(const scada::NodeId& node_id) {
-  auto i = node_map_.find(node_id);
-  if (i != node_map_.end())
-    return i->second;
+  if (auto* node = node_map_.Find(node_id))
+    return node;
 
   if (parent_address_space_) {
     if (auto* node = parent_address_space_->GetMutableNode(node_id))
@@ -187,9 +249,8 @@ scada::Node* AddressSpaceImpl::GetMutableNode(const scada::NodeId& node_id) {
 
 const scada::Node* AddressSpaceImpl::GetNode(
     const scada::NodeId& node_id) const {
-  auto i = node_map_.find(node_id);
-  if (i != node_map_.end())
-    return i->second;
+  if (auto* node = node_map_.Find(node_id))
+    return node;
 
   if (parent_address_space_) {
     if (auto* node = parent_address_space_->GetNode(node_id))
@@ -234,6 +295,11 @@ boost::signals2::scoped_connection AddressSpaceImpl::SubscribeReferenceDeleted(
   return reference_deleted_signal_.connect(callback);
 }
 
+boost::signals2::scoped_connection AddressSpaceImpl::SubscribeNodesLoaded(
+    const NodesCallback& callback) const {
+  return nodes_loaded_signal_.connect(callback);
+}
+
 void AddressSpaceImpl::NotifyNodeAdded(const scada::Node& node) const {
   node_created_signal_(node);
 }
@@ -273,16 +339,69 @@ void AddressSpaceImpl::NotifyReference(
 
 void AddressSpaceImpl::AddNode(std::unique_ptr<scada::Node> node) {
   AddNode(*node);
-  static_nodes_.emplace(node->id(), std::move(node));
+
+  auto index = static_cast<size_t>(node_map_.FindHandle(node->id()));
+  if (index >= static_nodes_.size())
+    static_nodes_.resize(index + 1);
+  static_nodes_[index] = std::move(node);
 }
 
 void AddressSpaceImpl::AddReference(const scada::ReferenceType& type,
                                     scada::Node& source,
                                     scada::Node& target) {
-  source.AddReference(type, true, target);
-  target.AddReference(type, false, source);
+  if (bulk_loading()) {
+    if (!LinkBulkReference(type, source, target))
+      return;
+  } else {
+    source.AddReference(type, true, target);
+    target.AddReference(type, false, source);
+  }
 
-  NotifyReference(type, source, target, true);
+  if (type.id() == scada::id::HasSubtype)
+    type_hierarchy_.Invalidate();
+
+  if (!bulk_loading())
+    NotifyReference(type, source, target, true);
+}
+
+bool AddressSpaceImpl::LinkBulkReference(const scada::ReferenceType& type,
+                                         scada::Node& source,
+                                         scada::Node& target) {
+  // An equal reference was either added by this load, or it links two nodes
+  // that both existed before it.
+  bool duplicate =
+      !bulk_references_.insert({&type, &source, &target}).second;
+  if (!duplicate && !bulk_added_nodes_.contains(&source) &&
+      !bulk_added_nodes_.contains(&target)) {
+    duplicate = std::ranges::find(source.forward_references(),
+                                  scada::Reference{&type, &target}) !=
+                source.forward_references().end();
+  }
+
+  // Loads come from configuration files and images.
+  if (duplicate) {
+    LOG_WARNING(Logger()) << "Duplicate reference skipped"
+                          << LOG_TAG("ReferenceTypeId",
+                                     NodeIdToScadaString(type.id()))
+                          << LOG_TAG("SourceId",
+                                     NodeIdToScadaString(source.id()))
+                          << LOG_TAG("TargetId",
+                                     NodeIdToScadaString(target.id()));
+    return false;
+  }
+
+  // TypeDefinition tracks its supertype in AddReference().
+  if (type.id() == scada::id::HasSubtype) {
+    source.AddReference(type, true, target);
+    target.AddReference(type, false, source);
+  } else {
+    source.LinkReference(type, true, target);
+    target.LinkReference(type, false, source);
+  }
+
+  bulk_loaded_nodes_.push_back(&source);
+  bulk_loaded_nodes_.push_back(&target);
+  return true;
 }
 
 void AddressSpaceImpl::DeleteReference(const scada::ReferenceType& type,
@@ -291,5 +410,42 @@ void AddressSpaceImpl::DeleteReference(const scada::ReferenceType& type,
   source.DeleteReference(type, true, target);
   target.DeleteReference(type, false, source);
 
+  if (bulk_loading())
+    bulk_references_.erase({&type, &source, &target});
+
+  if (type.id() == scada::id::HasSubtype)
+    type_hierarchy_.Invalidate();
+
   NotifyReference(type, source, target, false);
-}
\ No newline at end of file
+}
+
+void AddressSpaceImpl::BeginBulkLoad(size_t node_count) {
+  if (bulk_load_depth_++ == 0)
+    type_hierarchy_.BeginUpdate();
+
+  const auto capacity = node_map_.node_ids_.handle_count() + node_count;
+  node_map_.node_ids_.reserve(capacity);
+  node_map_.nodes_.reserve(capacity);
+  static_nodes_.reserve(capacity);
+  bulk_loaded_nodes_.reserve(bulk_loaded_nodes_.size() + node_count);
+  bulk_added_nodes_.reserve(bulk_added_nodes_.size() + node_count);
+}
+
+void AddressSpaceImpl::EndBulkLoad() {
+  scada::base::Check(bulk_loading());
+  if (--bulk_load_depth_ != 0)
+    return;
+
+  type_hierarchy_.EndUpdate();
+
+  bulk_added_nodes_.clear();
+  bulk_references_.clear();
+
+  auto nodes = std::move(bulk_loaded_nodes_);
+  bulk_loaded_nodes_.clear();
+  std::ranges::sort(nodes, std::less<>{});
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  if (!nodes.empty())
+    nodes_loaded_signal_(nodes);
+}
@@ -1,13 +1,18 @@
 #pragma once
 
 #include "address_space/mutable_address_space.h"
+#include "address_space/node_id_table.h"
+#include "address_space/type_hierarchy_index.h"
 #include "base/check.h"
 #include "base/lifetime.h"
 #include "scada/status.h"
 
 #include <boost/signals2/signal.hpp>
-#include <map>
-#include <unordered_map>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace scada {
@@ -23,13 +28,135 @@ class AddressSpaceImpl : public MutableAddressSpace {
   AddressSpaceImpl(const AddressSpaceImpl&) = delete;
   AddressSpaceImpl& operator=(const AddressSpaceImpl&) = delete;
 
-  // Hashed rather than ordered: every access is a point lookup by NodeId, and
-  // no consumer depends on sorted iteration (the XML serializer re-sorts its
-  // own snapshot). This trades O(log n) NodeId comparisons for O(1) hashing on
-  // the hottest address-space path.
-  typedef std::unordered_map<scada::NodeId, scada::Node*> NodeMap;
+  // Nodes keyed by interned NodeId handle. A lookup hashes the NodeId once in
+  // the interning table and then indexes a vector; the handle can be kept to
+  // skip even that. Iterates as (NodeId, Node*) pairs in handle order, and
+  // offers the const lookups of a map. The pairs are made on dereference, so
+  // bind them by value or const reference.
+  class NodeMap {
+   public:
+    using key_type = scada::NodeId;
+    using mapped_type = scada::Node*;
+    using value_type = std::pair<const scada::NodeId&, scada::Node*>;
+
+    class const_iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = NodeMap::value_type;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type;
+
+      // Holds the pair for `->`.
+      struct pointer {
+        value_type value;
+        const value_type* operator->() const { return &value; }
+      };
+
+      const_iterator() = default;
+
+      value_type operator*() const {
+        return {map_->node_ids_.Get(static_cast<NodeHandle>(index_)),
+                map_->nodes_[index_]};
+      }
+
+      pointer operator->() const { return pointer{**this}; }
+
+      const_iterator& operator++() {
+        ++index_;
+        SkipDeleted();
+        return *this;
+      }
+
+      const_iterator operator++(int) {
+        auto old = *this;
+        ++*this;
+        return old;
+      }
+
+      bool operator==(const const_iterator& other) const = default;
+
+     private:
+      friend class NodeMap;
+
+      const_iterator(const NodeMap* map, uint32_t index)
+          : map_{map}, index_{index} {
+        SkipDeleted();
+      }
+
+      void SkipDeleted() {
+        while (index_ < map_->nodes_.size() && !map_->nodes_[index_])
+          ++index_;
+      }
+
+      const NodeMap* map_ = nullptr;
+      uint32_t index_ = 0;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const { return const_iterator{this, 0}; }
+    const_iterator end() const {
+      return const_iterator{this, static_cast<uint32_t>(nodes_.size())};
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    // Returns |kInvalidNodeHandle| if |node_id| was never added.
+    NodeHandle FindHandle(const scada::NodeId& node_id) const {
+      return node_ids_.Find(node_id);
+    }
+
+    scada::Node* Get(NodeHandle handle) const {
+      auto index = static_cast<size_t>(handle);
+      return index < nodes_.size() ? nodes_[index] : nullptr;
+    }
+
+    scada::Node* Find(const scada::NodeId& node_id) const {
+      return Get(FindHandle(node_id));
+    }
+
+    const_iterator find(const scada::NodeId& node_id) const {
+      auto handle = FindHandle(node_id);
+      return Get(handle) ? const_iterator{this, static_cast<uint32_t>(handle)}
+                         : end();
+    }
+
+    bool contains(const scada::NodeId& node_id) const {
+      return Find(node_id) != nullptr;
+    }
+
+    size_t count(const scada::NodeId& node_id) const {
+      return contains(node_id) ? 1 : 0;
+    }
+
+   private:
+    friend class AddressSpaceImpl;
+
+    NodeIdTable node_ids_;
+
+    // Indexed by handle. Null for deleted nodes.
+    std::vector<scada::Node*> nodes_;
+
+    size_t size_ = 0;
+  };
+
   const NodeMap& node_map() const SCADA_LIFETIME_BOUND { return node_map_; }
 
+  // Subtype checks for the type definitions added to this address space.
+  const scada::TypeHierarchyIndex& type_hierarchy() const SCADA_LIFETIME_BOUND {
+    return type_hierarchy_;
+  }
+
+  // While a bulk load runs, AddReference links references without scanning
+  // the endpoints for an equal one and without notifications; a reference the
+  // load adds twice is logged and skipped. When the outermost load ends, all
+  // the nodes it touched are reported by a single NodesLoaded notification.
+  virtual void BeginBulkLoad(size_t node_count) override;
+  virtual void EndBulkLoad() override;
+
+  bool bulk_loading() const { return bulk_load_depth_ != 0; }
+
   // Add not-owned node.
   void AddNode(scada::Node& node);
 
@@ -86,11 +213,19 @@ class AddressSpaceImpl : public MutableAddressSpace {
       const ReferenceCallback& callback) const override;
   [[nodiscard]] boost::signals2::scoped_connection SubscribeReferenceDeleted(
       const ReferenceCallback& callback) const override;
+  [[nodiscard]] boost::signals2::scoped_connection SubscribeNodesLoaded(
+      const NodesCallback& callback) const override;
 
  private:
   void NotifyNodeMoved(const scada::Node& node, const scada::Node* top) const;
   void NotifyNodeTitleChanged(const scada::Node& node) const;
 
+  // Links a reference of the current bulk load. Returns false for a duplicate,
+  // which is left out.
+  bool LinkBulkReference(const scada::ReferenceType& type,
+                         scada::Node& source,
+                         scada::Node& target);
+
   // Forwards all change notifications of |parent_address_space_| through this
   // instance's own signals, so subscribers observe the parent chain with a
   // single subscription.
@@ -100,7 +235,36 @@ class AddressSpaceImpl : public MutableAddressSpace {
 
   NodeMap node_map_;
 
-  std::map<scada::NodeId, std::unique_ptr<scada::Node>> static_nodes_;
+  // Owned nodes, indexed by handle like |node_map_|.
+  std::vector<std::unique_ptr<scada::Node>> static_nodes_;
+
+  // Declared after |static_nodes_|, so it detaches from the owned types
+  // before they are destroyed.
+  scada::TypeHierarchyIndex type_hierarchy_;
+
+  struct BulkReference {
+    const scada::ReferenceType* type;
+    const scada::Node* source;
+    const scada::Node* target;
+
+    bool operator==(const BulkReference&) const = default;
+  };
+
+  struct BulkReferenceHash {
+    size_t operator()(const BulkReference& reference) const {
+      const std::hash<const void*> hash;
+      return hash(reference.type) ^ (hash(reference.source) * 31) ^
+             (hash(reference.target) * 961);
+    }
+  };
+
+  size_t bulk_load_depth_ = 0;
+  // Nodes added or linked during the current bulk load, with repeats.
+  std::vector<const scada::Node*> bulk_loaded_nodes_;
+  // Nodes added during the current bulk load.
+  std::unordered_set<const scada::Node*> bulk_added_nodes_;
+  // References linked during the current bulk load.
+  std::unordered_set<BulkReference, BulkReferenceHash> bulk_references_;
 
   mutable boost::signals2::signal<void(const scada::Node&)>
       node_created_signal_;
@@ -118,6 +282,8 @@ class AddressSpaceImpl : public MutableAddressSpace {
   mutable boost::signals2::signal<
       void(const scada::ReferenceType&, const scada::Node&, const scada::Node&)>
       reference_deleted_signal_;
+  mutable boost::signals2::signal<void(std::span<const scada::Node* const>)>
+      nodes_loaded_signal_;
 
   std::vector<boost::signals2::scoped_connection> parent_connections_;
 };
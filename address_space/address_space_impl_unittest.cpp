@@ -0,0 +1,95 @@
+#include "address_space/address_space_impl.h"
+
+#include "address_space/object.h"
+#include "address_space/type_definition.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+using namespace testing;
+
+namespace {
+
+const scada::NodeId kNodeId1{"Node.1", 2};
+const scada::NodeId kNodeId2{"Node.2", 2};
+
+}  // namespace
+
+TEST(AddressSpaceImpl, NodeMapLookups) {
+  AddressSpaceImpl address_space;
+  auto& node = address_space.AddStaticNode<scada::GenericObject>(
+      kNodeId1, "Node1", u"Node 1");
+
+  const auto& node_map = address_space.node_map();
+  auto i = node_map.find(kNodeId1);
+  ASSERT_NE(i, node_map.end());
+  EXPECT_EQ(i->first, kNodeId1);
+  EXPECT_EQ(i->second, &node);
+  EXPECT_TRUE(node_map.contains(kNodeId1));
+  EXPECT_EQ(node_map.count(kNodeId1), 1u);
+
+  EXPECT_EQ(node_map.find(kNodeId2), node_map.end());
+  EXPECT_FALSE(node_map.contains(kNodeId2));
+  EXPECT_EQ(node_map.count(kNodeId2), 0u);
+}
+
+TEST(AddressSpaceImpl, DeletedNodeReleasesItsHandle) {
+  AddressSpaceImpl address_space;
+  address_space.AddStaticNode<scada::GenericObject>(kNodeId1, "Node1",
+                                                    u"Node 1");
+  const auto handle = address_space.node_map().FindHandle(kNodeId1);
+
+  address_space.DeleteNode(kNodeId1);
+  EXPECT_EQ(address_space.node_map().FindHandle(kNodeId1), kInvalidNodeHandle);
+
+  auto& node = address_space.AddStaticNode<scada::GenericObject>(
+      kNodeId2, "Node2", u"Node 2");
+  EXPECT_EQ(address_space.node_map().FindHandle(kNodeId2), handle);
+  EXPECT_EQ(address_space.GetNode(kNodeId2), &node);
+  EXPECT_EQ(address_space.GetNode(kNodeId1), nullptr);
+  EXPECT_EQ(address_space.node_map().size(), 1u);
+}
+
+TEST(AddressSpaceImpl, ClearForgetsNodeIds) {
+  AddressSpaceImpl address_space;
+  address_space.AddStaticNode<scada::GenericObject>(kNodeId1, "Node1",
+                                                    u"Node 1");
+  address_space.AddStaticNode<scada::GenericObject>(kNodeId2, "Node2",
+                                                    u"Node 2");
+
+  address_space.Clear();
+  EXPECT_TRUE(address_space.node_map().empty());
+  EXPECT_EQ(address_space.node_map().FindHandle(kNodeId1), kInvalidNodeHandle);
+
+  address_space.AddStaticNode<scada::GenericObject>(kNodeId2, "Node2",
+                                                    u"Node 2");
+  EXPECT_EQ(address_space.node_map().FindHandle(kNodeId2), NodeHandle{0});
+}
+
+// Bulk loads take references from configuration files; a duplicate is
+// skipped rather than linked twice.
+TEST(AddressSpaceImpl, BulkLoadSkipsDuplicateReferences) {
+  AddressSpaceImpl address_space;
+  auto& organizes = address_space.AddStaticNode<scada::ReferenceType>(
+      scada::id::Organizes, scada::QualifiedName{"Organizes"});
+  auto& node1 = address_space.AddStaticNode<scada::GenericObject>(
+      kNodeId1, "Node1", u"Node 1");
+
+  // Between nodes that existed before the load.
+  address_space.AddReference(organizes, organizes, node1);
+
+  {
+    MutableAddressSpace::BulkLoad bulk_load{address_space, 1};
+    auto& node2 = address_space.AddStaticNode<scada::GenericObject>(
+        kNodeId2, "Node2", u"Node 2");
+    address_space.AddReference(organizes, organizes, node1);
+    address_space.AddReference(organizes, node1, node2);
+    address_space.AddReference(organizes, node1, node2);
+  }
+
+  EXPECT_FALSE(address_space.bulk_loading());
+  EXPECT_EQ(organizes.forward_references().size(), 1u);
+  EXPECT_EQ(node1.inverse_references().size(), 1u);
+  EXPECT_EQ(node1.forward_references().size(), 1u);
+  EXPECT_EQ(address_space.GetNode(kNodeId2)->inverse_references().size(), 1u);
+}
@@ -0,0 +1,207 @@
+#include "address_space/address_space_snapshot.h"
+
+#include "address_space/address_space_impl.h"
+#include "address_space/node.h"
+#include "address_space/node_utils.h"
+#include "address_space/reference.h"
+#include "address_space/type_definition.h"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
+
+namespace scada {
+
+namespace {
+
+void AppendReferences(const References& references,
+                      std::vector<NodeSnapshot::Reference>& snapshots) {
+  snapshots.reserve(references.size());
+  for (const auto& reference : references) {
+    // Same as the live services: dangling references are never browsed.
+    if (reference.type && reference.node) {
+      snapshots.push_back({.reference_type_id = reference.type->id(),
+                           .node_id = reference.node->id()});
+    }
+  }
+}
+
+std::shared_ptr<const NodeSnapshot> MakeNodeSnapshot(const Node& node) {
+  auto snapshot = std::make_shared<NodeSnapshot>();
+  snapshot->node_id = node.id();
+  snapshot->node_class = node.GetNodeClass();
+  snapshot->browse_name = node.GetBrowseName();
+  snapshot->display_name = node.GetDisplayName();
+  if (auto* type_definition = node.type_definition()) {
+    snapshot->type_definition_id = type_definition->id();
+  }
+  if (auto* type = AsTypeDefinition(&node)) {
+    if (auto* supertype = type->supertype()) {
+      snapshot->supertype_id = supertype->id();
+    }
+  }
+  AppendReferences(node.forward_references(), snapshot->forward_references);
+  AppendReferences(node.inverse_references(), snapshot->inverse_references);
+  return snapshot;
+}
+
+}  // namespace
+
+// AddressSpaceSnapshot
+
+// static
+size_t AddressSpaceSnapshot::GetShardIndex(const NodeId& node_id) {
+  return std::hash<NodeId>{}(node_id) % kShardCount;
+}
+
+const NodeSnapshot* AddressSpaceSnapshot::GetNode(
+    const NodeId& node_id) const {
+  const auto& shard = *shards_[GetShardIndex(node_id)];
+  auto i = shard.find(node_id);
+  return i != shard.end() ? i->second.get() : nullptr;
+}
+
+bool AddressSpaceSnapshot::IsSubtypeOf(const NodeId& type_id,
+                                       const NodeId& supertype_id) const {
+  for (auto* type = GetNode(type_id); type;
+       type = type->supertype_id.is_null() ? nullptr
+                                           : GetNode(type->supertype_id)) {
+    if (type->node_id == supertype_id) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace scada
+
+// AddressSpaceSnapshotPublisher
+
+AddressSpaceSnapshotPublisher::AddressSpaceSnapshotPublisher(
+    AddressSpaceSnapshotPublisherContext&& context)
+    : AddressSpaceSnapshotPublisherContext{std::move(context)} {
+  using Shard = scada::AddressSpaceSnapshot::Shard;
+
+  auto snapshot = std::make_shared<scada::AddressSpaceSnapshot>();
+  std::array<std::shared_ptr<Shard>, scada::AddressSpaceSnapshot::kShardCount>
+      shards;
+  for (auto& shard : shards) {
+    shard = std::make_shared<Shard>();
+  }
+  for (const auto& [node_id, node] : address_space_.node_map()) {
+    shards[scada::AddressSpaceSnapshot::GetShardIndex(node_id)]->emplace(
+        node_id, scada::MakeNodeSnapshot(*node));
+  }
+  std::ranges::copy(shards, snapshot->shards_.begin());
+  snapshot->size_ = address_space_.node_map().size();
+  snapshot_.store(std::move(snapshot), std::memory_order_release);
+
+  connections_.emplace_back(address_space_.SubscribeNodeCreated(
+      [this](const scada::Node& node) { InvalidateWithNeighbors(node); }));
+  // Neighbors lose their references to the deleted node.
+  connections_.emplace_back(address_space_.SubscribeNodeDeleted(
+      [this](const scada::Node& node) { InvalidateWithNeighbors(node); }));
+  connections_.emplace_back(address_space_.SubscribeNodeModified(
+      [this](const scada::Node& node, const scada::PropertyIds&) {
+        Invalidate(node);
+      }));
+  connections_.emplace_back(address_space_.SubscribeNodeTitleChanged(
+      [this](const scada::Node& node) { Invalidate(node); }));
+  connections_.emplace_back(address_space_.SubscribeNodeMoved(
+      [this](const scada::Node& node) { InvalidateWithNeighbors(node); }));
+
+  const auto invalidate_reference = [this](const scada::ReferenceType&,
+                                           const scada::Node& source,
+                                           const scada::Node& target) {
+    Invalidate(source);
+    Invalidate(target);
+  };
+  connections_.emplace_back(
+      address_space_.SubscribeReferenceAdded(invalidate_reference));
+  connections_.emplace_back(
+      address_space_.SubscribeReferenceDeleted(invalidate_reference));
+  // A bulk load reports the nodes on both ends of its references.
+  connections_.emplace_back(address_space_.SubscribeNodesLoaded(
+      [this](std::span<const scada::Node* const> nodes) {
+        for (const auto* node : nodes) {
+          Invalidate(*node);
+        }
+      }));
+}
+
+AddressSpaceSnapshotPublisher::~AddressSpaceSnapshotPublisher() {
+  cancelation_.Cancel();
+}
+
+void AddressSpaceSnapshotPublisher::Invalidate(const scada::Node& node) {
+  dirty_node_ids_.emplace(node.id());
+
+  if (publish_posted_) {
+    return;
+  }
+
+  publish_posted_ = true;
+
+  CoSpawn(executor_, cancelation_,
+          [this, cancelation = cancelation_.ref()]() -> Awaitable<void> {
+            co_await boost::asio::post(boost::asio::use_awaitable);
+            if (cancelation.canceled()) {
+              co_return;
+            }
+            Publish();
+          });
+}
+
+void AddressSpaceSnapshotPublisher::InvalidateWithNeighbors(
+    const scada::Node& node) {
+  Invalidate(node);
+  for (const auto* references :
+       {&node.forward_references(), &node.inverse_references()}) {
+    for (const auto& reference : *references) {
+      if (reference.node) {
+        Invalidate(*reference.node);
+      }
+    }
+  }
+}
+
+void AddressSpaceSnapshotPublisher::Publish() {
+  using Shard = scada::AddressSpaceSnapshot::Shard;
+
+  publish_posted_ = false;
+
+  if (dirty_node_ids_.empty()) {
+    return;
+  }
+
+  const auto current = snapshot();
+  auto next = std::make_shared<scada::AddressSpaceSnapshot>(*current);
+  next->version_ = current->version_ + 1;
+
+  // Shards copied for |next|, so each is copied at most once.
+  std::array<std::shared_ptr<Shard>, scada::AddressSpaceSnapshot::kShardCount>
+      copied_shards;
+
+  for (const auto& node_id : dirty_node_ids_) {
+    const auto shard_index = scada::AddressSpaceSnapshot::GetShardIndex(node_id);
+    auto& shard = copied_shards[shard_index];
+    if (!shard) {
+      shard = std::make_shared<Shard>(*current->shards_[shard_index]);
+      next->shards_[shard_index] = shard;
+    }
+
+    if (auto* node = address_space_.GetNode(node_id)) {
+      auto [i, inserted] =
+          shard->insert_or_assign(node_id, scada::MakeNodeSnapshot(*node));
+      if (inserted) {
+        ++next->size_;
+      }
+    } else if (shard->erase(node_id)) {
+      --next->size_;
+    }
+  }
+
+  dirty_node_ids_.clear();
+  snapshot_.store(std::move(next), std::memory_order_release);
+}
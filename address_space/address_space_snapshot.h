@@ -0,0 +1,133 @@
+#pragma once
+
+#include "base/any_executor.h"
+#include "base/awaitable.h"
+#include "scada/localized_text.h"
+#include "scada/node_class.h"
+#include "scada/node_id.h"
+#include "scada/qualified_name.h"
+
+#include <boost/signals2/connection.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class AddressSpaceImpl;
+class AddressSpaceSnapshotPublisher;
+
+namespace scada {
+
+class Node;
+
+// An immutable copy of what browsing needs from a node. References name their
+// targets by id; a target is looked up in the same snapshot, so everything a
+// reader sees comes from one consistent version.
+struct NodeSnapshot {
+  struct Reference {
+    NodeId reference_type_id;
+    NodeId node_id;
+  };
+
+  NodeId node_id;
+  NodeClass node_class = NodeClass::Object;
+  QualifiedName browse_name;
+  LocalizedText display_name;
+  NodeId type_definition_id;
+  // Type definitions only.
+  NodeId supertype_id;
+  std::vector<Reference> forward_references;
+  std::vector<Reference> inverse_references;
+};
+
+// One published version of an address space. Never changes once published,
+// so any number of threads may read it without locking.
+//
+// Node snapshots are kept in shards. A new version copies only the shards it
+// changes and shares the rest, and the node snapshots themselves, with the
+// previous version.
+class AddressSpaceSnapshot {
+ public:
+  // Increments with every published version.
+  uint64_t version() const { return version_; }
+
+  size_t size() const { return size_; }
+
+  const NodeSnapshot* GetNode(const NodeId& node_id) const;
+
+  // Walks the supertypes of the type definition |type_id|.
+  bool IsSubtypeOf(const NodeId& type_id, const NodeId& supertype_id) const;
+
+ private:
+  friend class ::AddressSpaceSnapshotPublisher;
+
+  static constexpr size_t kShardCount = 256;
+
+  using Shard =
+      std::unordered_map<NodeId, std::shared_ptr<const NodeSnapshot>>;
+
+  static size_t GetShardIndex(const NodeId& node_id);
+
+  std::array<std::shared_ptr<const Shard>, kShardCount> shards_;
+  uint64_t version_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace scada
+
+struct AddressSpaceSnapshotPublisherContext {
+  AnyExecutor executor_;
+  // Observed and snapshotted on |executor_| only.
+  const AddressSpaceImpl& address_space_;
+};
+
+// Publishes snapshots of an address space for readers on other threads, so
+// Browse can be served from a thread pool while the address space keeps being
+// mutated in place on its own executor.
+//
+// Changes are collected as the address space reports them and published as one
+// new version on the next executor tick, so a burst of changes - like a
+// configuration load - costs one publication. A reader holding a snapshot
+// keeps seeing its version; the next snapshot() call returns the latest one.
+class AddressSpaceSnapshotPublisher
+    : private AddressSpaceSnapshotPublisherContext {
+ public:
+  // Publishes the initial snapshot of all nodes.
+  explicit AddressSpaceSnapshotPublisher(
+      AddressSpaceSnapshotPublisherContext&& context);
+  ~AddressSpaceSnapshotPublisher();
+
+  AddressSpaceSnapshotPublisher(const AddressSpaceSnapshotPublisher&) = delete;
+  AddressSpaceSnapshotPublisher& operator=(
+      const AddressSpaceSnapshotPublisher&) = delete;
+
+  // Thread-safe.
+  std::shared_ptr<const scada::AddressSpaceSnapshot> snapshot() const {
+    return snapshot_.load(std::memory_order_acquire);
+  }
+
+  // Publishes pending changes right away instead of on the next tick. Must be
+  // called on |executor_|.
+  void Publish();
+
+  // Diagnostics.
+  size_t pending_change_count() const { return dirty_node_ids_.size(); }
+
+ private:
+  void Invalidate(const scada::Node& node);
+  void InvalidateWithNeighbors(const scada::Node& node);
+
+  std::atomic<std::shared_ptr<const scada::AddressSpaceSnapshot>> snapshot_;
+
+  // Nodes whose snapshots are outdated in the published version.
+  std::unordered_set<scada::NodeId> dirty_node_ids_;
+  bool publish_posted_ = false;
+
+  std::vector<boost::signals2::scoped_connection> connections_;
+
+  Cancelation cancelation_;
+};
@@ -0,0 +1,257 @@
+#include "address_space/address_space_snapshot.h"
+
+#include "address_space/snapshot_view_service.h"
+#include "address_space/test/test_address_space.h"
+#include "base/test/test_executor.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+#include <set>
+#include <string>
+
+using namespace testing;
+
+namespace {
+
+class AddressSpaceSnapshotTest : public Test {
+ protected:
+  // Browses both the snapshot and the address space itself. Both run the same
+  // NodeBrowser, so the references come in the same order.
+  void ExpectBrowseMatches(
+      std::span<const scada::BrowseDescription> inputs) {
+    auto results = snapshot_view_service_.Browse(inputs);
+    auto expected = address_space_.sync_view_service_impl.Browse(inputs);
+    EXPECT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < std::min(results.size(), expected.size()); ++i) {
+      EXPECT_EQ(results[i].status_code, expected[i].status_code);
+      EXPECT_THAT(results[i].references,
+                  ElementsAreArray(expected[i].references));
+    }
+  }
+
+  TestExecutor executor_;
+  TestAddressSpace address_space_;
+  AddressSpaceSnapshotPublisher publisher_{{
+      .executor_ = executor_,
+      .address_space_ = address_space_,
+  }};
+  SnapshotViewService snapshot_view_service_{
+      {.snapshot_publisher_ = publisher_}};
+};
+
+}  // namespace
+
+TEST_F(AddressSpaceSnapshotTest, BrowseMatchesAddressSpace) {
+  const std::vector<scada::BrowseDescription> inputs{
+      {.node_id = scada::id::RootFolder,
+       .direction = scada::BrowseDirection::Forward,
+       .reference_type_id = scada::id::HierarchicalReferences,
+       .include_subtypes = true},
+      {.node_id = address_space_.kTestNode3Id,
+       .direction = scada::BrowseDirection::Both,
+       .reference_type_id = scada::id::References,
+       .include_subtypes = true},
+      {.node_id = address_space_.kTestNode3Id,
+       .direction = scada::BrowseDirection::Forward,
+       .reference_type_id = scada::id::Organizes,
+       .include_subtypes = false},
+      {.node_id = address_space_.kTestTypeId,
+       .direction = scada::BrowseDirection::Forward,
+       .reference_type_id = scada::id::HasProperty,
+       .include_subtypes = true,
+       .node_class_mask = static_cast<scada::UInt32>(
+           scada::NodeClass::Variable)},
+      {.node_id = address_space_.MakeNestedNodeId(address_space_.kTestNode1Id,
+                                                  address_space_.kTestProp1Id),
+       .direction = scada::BrowseDirection::Both,
+       .reference_type_id = scada::id::References,
+       .include_subtypes = true},
+      {.node_id = scada::NodeId{999, TestAddressSpace::kNamespaceIndex},
+       .direction = scada::BrowseDirection::Forward,
+       .reference_type_id = scada::id::References,
+       .include_subtypes = true},
+  };
+
+  ExpectBrowseMatches(inputs);
+}
+
+TEST_F(AddressSpaceSnapshotTest, BrowseResultMaskMatchesAddressSpace) {
+  std::vector<scada::BrowseDescription> inputs;
+  for (scada::UInt32 result_mask :
+       {scada::UInt32{0}, scada::UInt32{scada::kBrowseResultReferenceType},
+        scada::UInt32{scada::kBrowseResultIsForward |
+                      scada::kBrowseResultBrowseName},
+        scada::UInt32{scada::kBrowseResultDisplayName |
+                      scada::kBrowseResultTypeDefinition}}) {
+    inputs.push_back({.node_id = address_space_.kTestNode3Id,
+                      .direction = scada::BrowseDirection::Both,
+                      .reference_type_id = scada::id::References,
+                      .include_subtypes = true,
+                      .result_mask = result_mask});
+  }
+
+  ExpectBrowseMatches(inputs);
+}
+
+TEST_F(AddressSpaceSnapshotTest, TranslateBrowsePathsMatchesAddressSpace) {
+  const std::vector<scada::BrowsePath> inputs{
+      {.node_id = address_space_.kTestNode3Id,
+       .relative_path = {{.reference_type_id = scada::id::HasComponent,
+                          .include_subtypes = true,
+                          .target_name = scada::QualifiedName{
+                              "TestNode5", TestAddressSpace::kNamespaceIndex}},
+                         {.reference_type_id = scada::id::Organizes,
+                          .include_subtypes = false,
+                          .target_name = scada::QualifiedName{
+                              "TestNode6", TestAddressSpace::kNamespaceIndex}}}},
+      {.node_id = address_space_.kTestNode3Id,
+       .relative_path = {{.reference_type_id = scada::id::Organizes,
+                          .include_subtypes = false,
+                          .target_name = scada::QualifiedName{
+                              "Missing", TestAddressSpace::kNamespaceIndex}}}},
+      {.node_id = address_space_.kTestNode3Id,
+       .relative_path = {{.reference_type_id =
+                              scada::id::HierarchicalReferences,
+                          .inverse = true,
+                          .include_subtypes = true,
+                          .target_name = scada::QualifiedName{"Root"}}}},
+      {.node_id = address_space_.kTestNode3Id},
+  };
+
+  auto results = snapshot_view_service_.TranslateBrowsePaths(inputs);
+  auto expected =
+      address_space_.sync_view_service_impl.TranslateBrowsePaths(inputs);
+
+  ASSERT_EQ(results.size(), expected.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].status_code, expected[i].status_code);
+    ASSERT_EQ(results[i].targets.size(), expected[i].targets.size());
+    for (size_t j = 0; j < results[i].targets.size(); ++j) {
+      EXPECT_EQ(results[i].targets[j].target_id,
+                expected[i].targets[j].target_id);
+    }
+  }
+}
+
+TEST_F(AddressSpaceSnapshotTest, ReaderKeepsItsVersion) {
+  const auto old_snapshot = publisher_.snapshot();
+  const auto old_size = old_snapshot->size();
+
+  address_space_.AddReference(scada::id::Organizes,
+                              address_space_.kTestNode1Id,
+                              address_space_.kTestNode2Id);
+  address_space_.DeleteNode(address_space_.kTestNode4Id);
+
+  // Not published until the executor runs.
+  EXPECT_EQ(publisher_.snapshot(), old_snapshot);
+  EXPECT_GT(publisher_.pending_change_count(), 0u);
+
+  Drain(executor_);
+
+  const auto new_snapshot = publisher_.snapshot();
+  EXPECT_EQ(new_snapshot->version(), old_snapshot->version() + 1);
+  EXPECT_EQ(publisher_.pending_change_count(), 0u);
+  EXPECT_EQ(new_snapshot->size(), old_size - 1);
+
+  // The old version is untouched.
+  EXPECT_EQ(old_snapshot->size(), old_size);
+  ASSERT_TRUE(old_snapshot->GetNode(address_space_.kTestNode4Id));
+  EXPECT_THAT(old_snapshot->GetNode(address_space_.kTestNode1Id)
+                  ->forward_references,
+              Not(Contains(Field(&scada::NodeSnapshot::Reference::node_id,
+                                 address_space_.kTestNode2Id))));
+
+  EXPECT_FALSE(new_snapshot->GetNode(address_space_.kTestNode4Id));
+  EXPECT_THAT(new_snapshot->GetNode(address_space_.kTestNode1Id)
+                  ->forward_references,
+              Contains(Field(&scada::NodeSnapshot::Reference::node_id,
+                             address_space_.kTestNode2Id)));
+  EXPECT_THAT(new_snapshot->GetNode(address_space_.kTestNode3Id)
+                  ->forward_references,
+              Not(Contains(Field(&scada::NodeSnapshot::Reference::node_id,
+                                 address_space_.kTestNode4Id))));
+
+  ExpectBrowseMatches(std::vector<scada::BrowseDescription>{
+      {.node_id = address_space_.kTestNode3Id,
+       .direction = scada::BrowseDirection::Both,
+       .reference_type_id = scada::id::References,
+       .include_subtypes = true},
+      {.node_id = address_space_.kTestNode2Id,
+       .direction = scada::BrowseDirection::Inverse,
+       .reference_type_id = scada::id::Organizes,
+       .include_subtypes = false}});
+}
+
+TEST_F(AddressSpaceSnapshotTest, IsSubtypeOf) {
+  const auto snapshot = publisher_.snapshot();
+  EXPECT_TRUE(snapshot->IsSubtypeOf(scada::id::Organizes,
+                                    scada::id::HierarchicalReferences));
+  EXPECT_TRUE(snapshot->IsSubtypeOf(address_space_.kTestTypeId,
+                                    scada::id::BaseObjectType));
+  EXPECT_FALSE(snapshot->IsSubtypeOf(scada::id::HasProperty,
+                                     scada::id::NonHierarchicalReferences));
+  EXPECT_FALSE(snapshot->IsSubtypeOf(address_space_.kTestTypeId,
+                                     scada::id::FolderType));
+}
+
+// A bulk load reports its references by one NodesLoaded notification, which is
+// enough for the snapshot to pick them all up.
+TEST_F(AddressSpaceSnapshotTest, PublishesBulkLoad) {
+  const scada::NodeId kFolderId{1000, TestAddressSpace::kNamespaceIndex};
+  constexpr unsigned kChildCount = 100;
+
+  size_t reference_added_count = 0;
+  size_t nodes_loaded_count = 0;
+  std::vector<const scada::Node*> loaded_nodes;
+  auto reference_added_connection = address_space_.SubscribeReferenceAdded(
+      [&](const scada::ReferenceType&, const scada::Node&,
+          const scada::Node&) { ++reference_added_count; });
+  auto nodes_loaded_connection = address_space_.SubscribeNodesLoaded(
+      [&](std::span<const scada::Node* const> nodes) {
+        ++nodes_loaded_count;
+        loaded_nodes.assign(nodes.begin(), nodes.end());
+      });
+
+  {
+    MutableAddressSpace::BulkLoad bulk_load{address_space_, kChildCount + 1};
+    address_space_.CreateNode(
+        {kFolderId, scada::NodeClass::Object, scada::id::FolderType,
+         scada::id::RootFolder, scada::id::Organizes,
+         scada::NodeAttributes{}.set_browse_name("Folder")});
+    for (unsigned i = 0; i < kChildCount; ++i) {
+      address_space_.CreateNode(
+          {scada::NodeId{1001 + i, TestAddressSpace::kNamespaceIndex},
+           scada::NodeClass::Object, scada::id::BaseObjectType, kFolderId,
+           scada::id::Organizes,
+           scada::NodeAttributes{}.set_browse_name("Child" +
+                                                   std::to_string(i))});
+    }
+    EXPECT_EQ(nodes_loaded_count, 0u);
+  }
+
+  EXPECT_FALSE(address_space_.bulk_loading());
+  EXPECT_EQ(reference_added_count, 0u);
+  EXPECT_EQ(nodes_loaded_count, 1u);
+  // The new nodes, their parents and their type definitions, once each.
+  EXPECT_GE(loaded_nodes.size(), kChildCount + 4);
+  EXPECT_EQ(std::set(loaded_nodes.begin(), loaded_nodes.end()).size(),
+            loaded_nodes.size());
+  EXPECT_THAT(loaded_nodes,
+              IsSupersetOf({address_space_.GetNode(scada::id::RootFolder),
+                            address_space_.GetNode(kFolderId),
+                            address_space_.GetNode(scada::id::FolderType)}));
+
+  Drain(executor_);
+
+  EXPECT_EQ(publisher_.snapshot()->size(), address_space_.node_map().size());
+  ExpectBrowseMatches(std::vector<scada::BrowseDescription>{
+      {.node_id = scada::id::RootFolder,
+       .direction = scada::BrowseDirection::Forward,
+       .reference_type_id = scada::id::HierarchicalReferences,
+       .include_subtypes = true},
+      {.node_id = kFolderId,
+       .direction = scada::BrowseDirection::Both,
+       .reference_type_id = scada::id::References,
+       .include_subtypes = true}});
+}
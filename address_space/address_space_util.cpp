@@ -269,11 +269,7 @@ bool IsSubtypeOf(const AddressSpace& address_space,
                  const NodeId& type_id,
                  const NodeId& supertype_id) {
   const auto* type = AsTypeDefinition(address_space.GetNode(type_id));
-  for (; type; type = type->supertype()) {
-    if (type->id() == supertype_id)
-      return true;
-  }
-  return false;
+  return type && IsSubtypeOf(*type, supertype_id);
 }
 
 void AddReference(MutableAddressSpace& address_space,
@@ -11,16 +11,22 @@
 #include "model/node_id_util.h"
 #include "scada/node_attributes.h"
 
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
 #include <pugixml.hpp>
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <charconv>
 #include <filesystem>
 #include <format>
+#include <iterator>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <vector>
@@ -590,27 +596,6 @@ Status ReadNodeState(pugi::xml_node node, NodeState& node_state) {
   return OkStatus();
 }
 
-// Reads every <Node> element from a parsed document, appending the decoded
-// NodeStates to `out`. Multiple documents can be parsed into a single vector so
-// they are materialized together (see ApplyNodeStates /
-// LoadStaticAddressSpace).
-Status ParseNodeStates(const pugi::xml_document& document,
-                       std::vector<NodeState>& out) {
-  auto root = document.child(kRootTag);
-  if (!root) {
-    return StatusCode::Bad_CantParseString;
-  }
-
-  for (auto node : root.children(kNodeTag)) {
-    auto& node_state = out.emplace_back();
-    auto status = ReadNodeState(node, node_state);
-    if (!status) {
-      return status;
-    }
-  }
-  return OkStatus();
-}
-
 // The per-node parsers recognize only the namespace-0 container references
 // (HasComponent/HasProperty/Organizes) as parent edges, so an instance node
 // parented through a model-defined hierarchical ReferenceType (e.g. a
@@ -665,25 +650,33 @@ void PromoteHierarchicalParents(std::vector<NodeState>& node_states) {
   }
 }
 
-// Materializes parsed NodeStates into the address space: first creates every
+// Puts parsed NodeStates in the shape CreateNodes expects: parents resolved and
+// every node after its parent and supertype. Properties are not materialized,
+// so they are dropped.
+void PrepareNodeStates(std::vector<NodeState>& node_states) {
+  PromoteHierarchicalParents(node_states);
+  SortNodesHierarchically(node_states);
+  for (auto& node_state : node_states) {
+    node_state.properties.clear();
+  }
+}
+
+// Materializes prepared NodeStates into the address space: first creates every
 // node, then resolves supertype and reference links. Resolution runs only after
 // all nodes exist, so references may target nodes parsed from any input file —
 // this lets a static address space be split across multiple files without
 // regard to inter-file ordering.
-Status ApplyNodeStates(std::vector<NodeState> node_states,
-                       MutableAddressSpace& address_space,
-                       NodeFactory& node_factory) {
-  PromoteHierarchicalParents(node_states);
-  SortNodesHierarchically(node_states);
+Status CreateNodes(std::span<const NodeState> node_states,
+                   MutableAddressSpace& address_space,
+                   NodeFactory& node_factory) {
+  MutableAddressSpace::BulkLoad bulk_load{address_space, node_states.size()};
 
   for (const auto& node_state : node_states) {
     if (address_space.GetNode(node_state.node_id)) {
       continue;
     }
 
-    NodeState create_state = node_state;
-    create_state.properties.clear();
-    auto [status, node] = node_factory.CreateNode(create_state);
+    auto [status, node] = node_factory.CreateNode(node_state);
     if (!status) {
       return status;
     }
@@ -722,14 +715,11 @@ Status ApplyNodeStates(std::vector<NodeState> node_states,
   return OkStatus();
 }
 
-Status LoadAddressSpaceXmlDocument(const pugi::xml_document& document,
-                                   MutableAddressSpace& address_space,
-                                   NodeFactory& node_factory) {
-  std::vector<NodeState> node_states;
-  if (auto status = ParseNodeStates(document, node_states); !status) {
-    return status;
-  }
-  return ApplyNodeStates(std::move(node_states), address_space, node_factory);
+Status ApplyNodeStates(std::vector<NodeState> node_states,
+                       MutableAddressSpace& address_space,
+                       NodeFactory& node_factory) {
+  PrepareNodeStates(node_states);
+  return CreateNodes(node_states, address_space, node_factory);
 }
 
 // ---------------------------------------------------------------------------
@@ -967,41 +957,198 @@ Status ReadUaNodeState(pugi::xml_node node,
   return OkStatus();
 }
 
-Status ParseUaNodeStates(const pugi::xml_document& document,
-                         std::vector<NodeState>& out) {
-  auto root = document.child(kUaRootTag);
-  if (!root) {
+// ---------------------------------------------------------------------------
+// Parallel nodeset parsing. Every file is loaded and its node elements decoded
+// into NodeStates on a thread pool; large files are decoded in element chunks.
+// pugixml documents are only read once loaded, which is safe from many
+// threads. The decoded states are then committed single-threaded by
+// ApplyNodeStates.
+// ---------------------------------------------------------------------------
+
+enum class NodesetFormat {
+  // Detected from the root element.
+  Auto,
+  // Repo-owned scada-node-state-v1.
+  AddressSpace,
+  // OPC UA UANodeSet2.
+  UANodeSet,
+};
+
+// Node elements are decoded in chunks of this many, so a single large file
+// keeps the whole pool busy.
+constexpr size_t kParseChunkNodeCount = 2048;
+
+struct NodesetDocument {
+  pugi::xml_document document;
+  bool ua = false;
+  UaNamespaceMap ns_map;
+  UaAliasMap aliases;
+  // Node elements in document order.
+  std::vector<pugi::xml_node> elements;
+};
+
+Status LoadNodesetDocument(const std::filesystem::path& path,
+                           NodesetFormat format,
+                           NodesetDocument& out) {
+  const auto path_string = path.string();
+  if (!out.document.load_file(path_string.c_str())) {
     return StatusCode::Bad_CantParseString;
   }
-  const UaNamespaceMap ns_map = ReadNamespaceMap(root);
-  const UaAliasMap aliases = ReadAliasMap(root);
 
-  for (auto node : root.children()) {
-    if (!ParseUaElementClass(node.name())) {
-      continue;  // NamespaceUris, Models, Aliases, etc.
+  if (auto root = out.document.child(kUaRootTag);
+      root && format != NodesetFormat::AddressSpace) {
+    out.ua = true;
+    out.ns_map = ReadNamespaceMap(root);
+    out.aliases = ReadAliasMap(root);
+    for (auto node : root.children()) {
+      // Skips NamespaceUris, Models, Aliases, etc.
+      if (ParseUaElementClass(node.name())) {
+        out.elements.emplace_back(node);
+      }
     }
+    return OkStatus();
+  }
+
+  auto root = out.document.child(kRootTag);
+  if (!root || format == NodesetFormat::UANodeSet) {
+    return StatusCode::Bad_CantParseString;
+  }
+  for (auto node : root.children(kNodeTag)) {
+    out.elements.emplace_back(node);
+  }
+  return OkStatus();
+}
+
+// Frees the parsed tree once its elements are read.
+void ReleaseNodesetDocument(NodesetDocument& document) {
+  document.document.reset();
+  document.elements = {};
+  document.ns_map = {};
+  document.aliases = {};
+}
+
+Status ReadNodeElements(const NodesetDocument& document,
+                        std::span<const pugi::xml_node> elements,
+                        std::vector<NodeState>& out) {
+  out.reserve(elements.size());
+  for (auto element : elements) {
     auto& node_state = out.emplace_back();
-    if (auto status = ReadUaNodeState(node, ns_map, aliases, node_state);
-        !status) {
+    auto status = document.ua ? ReadUaNodeState(element, document.ns_map,
+                                                document.aliases, node_state)
+                              : ReadNodeState(element, node_state);
+    if (!status) {
       return status;
     }
   }
   return OkStatus();
 }
 
+// Parses every file into one NodeState set. Node order, and the error
+// reported for malformed input, are the same as parsing the files one by one.
+Status ParseNodesets(std::span<const std::filesystem::path> paths,
+                     NodesetFormat format,
+                     std::vector<NodeState>& node_states) {
+  struct Chunk {
+    std::span<const pugi::xml_node> elements;
+    std::vector<NodeState> node_states;
+    Status status = OkStatus();
+  };
+
+  // One slot per file, written only by that file's tasks.
+  std::vector<NodesetDocument> documents(paths.size());
+  std::vector<Status> load_statuses(paths.size(), OkStatus());
+  std::vector<std::vector<Chunk>> chunks(paths.size());
+  // Chunks of each file still being read. The last one to finish frees the
+  // file's document, so the parsed trees of all files don't pile up.
+  std::vector<std::atomic<size_t>> remaining_chunks(paths.size());
+
+  {
+    boost::asio::thread_pool pool{
+        std::max(1u, std::thread::hardware_concurrency())};
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+      boost::asio::post(pool, [&, i] {
+        auto& document = documents[i];
+        load_statuses[i] = LoadNodesetDocument(paths[i], format, document);
+        if (!load_statuses[i]) {
+          ReleaseNodesetDocument(document);
+          return;
+        }
+
+        // Sized before any chunk is posted and never resized after.
+        const std::span<const pugi::xml_node> elements{document.elements};
+        auto& file_chunks = chunks[i];
+        file_chunks.resize((elements.size() + kParseChunkNodeCount - 1) /
+                           kParseChunkNodeCount);
+        if (file_chunks.empty()) {
+          ReleaseNodesetDocument(document);
+          return;
+        }
+
+        remaining_chunks[i] = file_chunks.size();
+        for (size_t c = 0; c < file_chunks.size(); ++c) {
+          auto& chunk = file_chunks[c];
+          const size_t offset = c * kParseChunkNodeCount;
+          chunk.elements = elements.subspan(
+              offset, std::min(kParseChunkNodeCount, elements.size() - offset));
+          boost::asio::post(pool, [&document, &chunk,
+                                   &remaining = remaining_chunks[i]] {
+            chunk.status =
+                ReadNodeElements(document, chunk.elements, chunk.node_states);
+            chunk.elements = {};
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+              ReleaseNodesetDocument(document);
+            }
+          });
+        }
+      });
+    }
+
+    // Returns once all the work, including chunks posted by file tasks, is
+    // done.
+    pool.join();
+  }
+
+  size_t node_count = node_states.size();
+  for (const auto& file_chunks : chunks) {
+    for (const auto& chunk : file_chunks) {
+      node_count += chunk.node_states.size();
+    }
+  }
+  node_states.reserve(node_count);
+
+  for (size_t i = 0; i < paths.size(); ++i) {
+    if (!load_statuses[i]) {
+      return load_statuses[i];
+    }
+    for (auto& chunk : chunks[i]) {
+      if (!chunk.status) {
+        return chunk.status;
+      }
+      std::ranges::move(chunk.node_states, std::back_inserter(node_states));
+    }
+  }
+  return OkStatus();
+}
+
+Status LoadNodesets(std::span<const std::filesystem::path> paths,
+                    NodesetFormat format,
+                    MutableAddressSpace& address_space,
+                    NodeFactory& node_factory) {
+  std::vector<NodeState> node_states;
+  if (auto status = ParseNodesets(paths, format, node_states); !status) {
+    return status;
+  }
+  return ApplyNodeStates(std::move(node_states), address_space, node_factory);
+}
+
 }  // namespace
 
 Status LoadAddressSpaceXml(const std::filesystem::path& path,
                            MutableAddressSpace& address_space,
                            NodeFactory& node_factory) {
-  pugi::xml_document document;
-  const auto path_string = path.string();
-  auto result = document.load_file(path_string.c_str());
-  if (!result) {
-    return StatusCode::Bad_CantParseString;
-  }
-
-  return LoadAddressSpaceXmlDocument(document, address_space, node_factory);
+  return LoadNodesets(std::span{&path, 1}, NodesetFormat::AddressSpace,
+                      address_space, node_factory);
 }
 
 Status LoadStaticAddressSpace(std::span<const std::filesystem::path> paths,
@@ -1012,53 +1159,21 @@ Status LoadStaticAddressSpace(std::span<const std::filesystem::path> paths,
   // lives in another partition) resolve regardless of load order. Each file's
   // format (repo-owned scada-node-state-v1 or standard UANodeSet2) is detected
   // from its root element, so the two coexist during the migration.
-  std::vector<NodeState> node_states;
-  for (const auto& path : paths) {
-    pugi::xml_document document;
-    const auto path_string = path.string();
-    if (!document.load_file(path_string.c_str())) {
-      return StatusCode::Bad_CantParseString;
-    }
-    const Status status = document.child(kUaRootTag)
-                              ? ParseUaNodeStates(document, node_states)
-                              : ParseNodeStates(document, node_states);
-    if (!status) {
-      return status;
-    }
-  }
-  return ApplyNodeStates(std::move(node_states), address_space, node_factory);
+  return LoadNodesets(paths, NodesetFormat::Auto, address_space, node_factory);
 }
 
 Status LoadUANodeSetXml(const std::filesystem::path& path,
                         MutableAddressSpace& address_space,
                         NodeFactory& node_factory) {
-  pugi::xml_document document;
-  const auto path_string = path.string();
-  if (!document.load_file(path_string.c_str())) {
-    return StatusCode::Bad_CantParseString;
-  }
-  std::vector<NodeState> node_states;
-  if (auto status = ParseUaNodeStates(document, node_states); !status) {
-    return status;
-  }
-  return ApplyNodeStates(std::move(node_states), address_space, node_factory);
+  return LoadNodesets(std::span{&path, 1}, NodesetFormat::UANodeSet,
+                      address_space, node_factory);
 }
 
 Status LoadStaticUANodeSet(std::span<const std::filesystem::path> paths,
                            MutableAddressSpace& address_space,
                            NodeFactory& node_factory) {
-  std::vector<NodeState> node_states;
-  for (const auto& path : paths) {
-    pugi::xml_document document;
-    const auto path_string = path.string();
-    if (!document.load_file(path_string.c_str())) {
-      return StatusCode::Bad_CantParseString;
-    }
-    if (auto status = ParseUaNodeStates(document, node_states); !status) {
-      return status;
-    }
-  }
-  return ApplyNodeStates(std::move(node_states), address_space, node_factory);
+  return LoadNodesets(paths, NodesetFormat::UANodeSet, address_space,
+                      node_factory);
 }
 
 Status LoadStaticNodesets(std::span<const std::filesystem::path> paths,
@@ -1069,6 +1184,22 @@ Status LoadStaticNodesets(std::span<const std::filesystem::path> paths,
   return LoadStaticAddressSpace(paths, address_space, node_factory);
 }
 
+Status ParseStaticNodesets(std::span<const std::filesystem::path> paths,
+                           std::vector<NodeState>& node_states) {
+  if (auto status = ParseNodesets(paths, NodesetFormat::Auto, node_states);
+      !status) {
+    return status;
+  }
+  PrepareNodeStates(node_states);
+  return OkStatus();
+}
+
+Status CreateParsedNodes(std::span<const NodeState> node_states,
+                         MutableAddressSpace& address_space,
+                         NodeFactory& node_factory) {
+  return CreateNodes(node_states, address_space, node_factory);
+}
+
 Status SaveAddressSpaceXml(const std::filesystem::path& path,
                            const AddressSpace& address_space) {
   pugi::xml_document document;
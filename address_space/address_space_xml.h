@@ -4,9 +4,11 @@
 
 #include <filesystem>
 #include <span>
+#include <vector>
 
 namespace scada {
 class AddressSpace;
+struct NodeState;
 }  // namespace scada
 
 class MutableAddressSpace;
@@ -14,12 +16,18 @@ class NodeFactory;
 
 namespace scada {
 
+// The loaders add their nodes and references in a MutableAddressSpace::BulkLoad,
+// so subscribers get one NodesLoaded notification per load instead of one
+// notification per reference. Calling them inside a caller's BulkLoad defers
+// it to the end of that one.
+
 // Loads static address-space nodes from a repo-owned XML representation.
 Status LoadAddressSpaceXml(const std::filesystem::path& path,
                            MutableAddressSpace& address_space,
                            NodeFactory& node_factory);
 
-// Loads multiple static address-space XML files in order.
+// Loads multiple static address-space XML files in order. Files are parsed in
+// parallel, then materialized together on the calling thread.
 Status LoadStaticAddressSpace(std::span<const std::filesystem::path> paths,
                               MutableAddressSpace& address_space,
                               NodeFactory& node_factory);
@@ -47,6 +55,18 @@ Status LoadStaticNodesets(std::span<const std::filesystem::path> paths,
                           MutableAddressSpace& address_space,
                           NodeFactory& node_factory);
 
+// Parses static nodeset files like LoadStaticNodesets, without materializing
+// them. `node_states` come out with parents resolved and in creation order;
+// properties are dropped, as the loaders don't materialize them. Used to build
+// precompiled nodeset images (see nodeset_image.h).
+Status ParseStaticNodesets(std::span<const std::filesystem::path> paths,
+                           std::vector<NodeState>& node_states);
+
+// Materializes node states returned by ParseStaticNodesets.
+Status CreateParsedNodes(std::span<const NodeState> node_states,
+                         MutableAddressSpace& address_space,
+                         NodeFactory& node_factory);
+
 // Saves all reachable nodes from `address_space` to the static XML format.
 Status SaveAddressSpaceXml(const std::filesystem::path& path,
                            const AddressSpace& address_space);
@@ -0,0 +1,126 @@
+#include "address_space/address_space_xml.h"
+
+#include "address_space/address_space_impl2.h"
+#include "address_space/generic_node_factory.h"
+#include "common/node_state.h"
+#include "model/static_nodesets.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+namespace scada {
+namespace {
+
+// Spans several parse chunks.
+constexpr int kNodeCount = 5000;
+
+class AddressSpaceXmlTest : public Test {
+ protected:
+  ~AddressSpaceXmlTest() override {
+    for (const auto& path : paths_)
+      std::filesystem::remove(path);
+  }
+
+  // Writes `node_count` objects under the Objects folder, with ids starting at
+  // `first_id` in namespace 2. The object at `bad_index`, if any, gets an
+  // unknown node class.
+  std::filesystem::path WriteNodeset(int first_id,
+                                     int node_count,
+                                     int bad_index = -1) {
+    auto path = std::filesystem::temp_directory_path() /
+                std::format("address_space_xml_test_{}.xml", paths_.size());
+    std::ofstream file{path};
+    file << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         << "<AddressSpace format=\"scada-node-state-v1\">\n";
+    for (int i = 0; i < node_count; ++i) {
+      file << std::format(
+          "  <Node id=\"NS2.{}\" class=\"{}\" parent=\"NS0.85\" "
+          "parentReference=\"NS0.35\" browseName=\"Node{}\" />\n",
+          first_id + i, i == bad_index ? "Bogus" : "Object", first_id + i);
+    }
+    file << "</AddressSpace>\n";
+    paths_.emplace_back(path);
+    return path;
+  }
+
+  std::vector<std::filesystem::path> paths_;
+};
+
+}  // namespace
+
+TEST_F(AddressSpaceXmlTest, ChunksKeepDocumentOrder) {
+  WriteNodeset(1, kNodeCount);
+  WriteNodeset(kNodeCount + 1, kNodeCount);
+
+  std::vector<NodeState> node_states;
+  ASSERT_TRUE(ParseStaticNodesets(paths_, node_states));
+
+  ASSERT_EQ(node_states.size(), 2u * kNodeCount);
+  for (size_t i = 0; i < node_states.size(); ++i) {
+    ASSERT_EQ(node_states[i].node_id,
+              (NodeId{static_cast<NumericId>(i + 1), 2}))
+        << i;
+  }
+}
+
+TEST_F(AddressSpaceXmlTest, LaterChunkErrorFailsParse) {
+  WriteNodeset(1, kNodeCount, /*bad_index=*/kNodeCount - 1);
+
+  std::vector<NodeState> node_states;
+  auto status = ParseStaticNodesets(paths_, node_states);
+  EXPECT_FALSE(status);
+  EXPECT_EQ(status.code(), StatusCode::Bad_WrongNodeClass);
+}
+
+TEST_F(AddressSpaceXmlTest, LaterFileErrorFailsParse) {
+  WriteNodeset(1, kNodeCount);
+  WriteNodeset(kNodeCount + 1, kNodeCount, /*bad_index=*/kNodeCount / 2);
+
+  std::vector<NodeState> node_states;
+  EXPECT_EQ(ParseStaticNodesets(paths_, node_states).code(),
+            StatusCode::Bad_WrongNodeClass);
+}
+
+// A load is reported by one NodesLoaded notification, at the end of the
+// outermost BulkLoad.
+TEST_F(AddressSpaceXmlTest, LoadsInBulk) {
+  AddressSpaceImpl2 address_space;
+  GenericNodeFactory node_factory{address_space};
+  ASSERT_TRUE(LoadStaticNodesets(GetScadaStaticNodesetSourcePaths(),
+                                 address_space, node_factory));
+
+  int references_added = 0;
+  int nodes_loaded = 0;
+  auto reference_added_connection = address_space.SubscribeReferenceAdded(
+      [&](const ReferenceType&, const Node&, const Node&) {
+        ++references_added;
+      });
+  auto nodes_loaded_connection = address_space.SubscribeNodesLoaded(
+      [&](std::span<const Node* const>) { ++nodes_loaded; });
+
+  WriteNodeset(1, 2);
+  ASSERT_TRUE(LoadAddressSpaceXml(paths_[0], address_space, node_factory));
+  EXPECT_EQ(references_added, 0);
+  EXPECT_EQ(nodes_loaded, 1);
+  EXPECT_FALSE(address_space.bulk_loading());
+
+  WriteNodeset(3, 2);
+  {
+    MutableAddressSpace::BulkLoad bulk_load{address_space, 2};
+    ASSERT_TRUE(LoadAddressSpaceXml(paths_[1], address_space, node_factory));
+    EXPECT_EQ(nodes_loaded, 1);
+  }
+  EXPECT_EQ(references_added, 0);
+  EXPECT_EQ(nodes_loaded, 2);
+  EXPECT_NE(address_space.GetNode(NodeId{4, 2}), nullptr);
+}
+
+}  // namespace scada
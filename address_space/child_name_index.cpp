@@ -0,0 +1,45 @@
+#include "address_space/child_name_index.h"
+
+#include "address_space/node.h"
+
+#include <algorithm>
+
+namespace scada {
+
+ChildNameIndex::ChildNameIndex(const Node& node) {
+  references_by_name_.reserve(node.forward_references().size());
+  for (const auto& reference : node.forward_references())
+    Add(reference);
+}
+
+void ChildNameIndex::Add(const Reference& reference) {
+  if (!reference.type || !reference.node)
+    return;
+  references_by_name_[reference.node->GetBrowseName().name()].push_back(
+      reference);
+}
+
+void ChildNameIndex::Remove(const Reference& reference) {
+  if (!reference.type || !reference.node)
+    return;
+  auto i = references_by_name_.find(reference.node->GetBrowseName().name());
+  if (i == references_by_name_.end())
+    return;
+  auto& references = i->second;
+  // The last equal one, as Node::DeleteReference() removes.
+  auto j = std::find(references.rbegin(), references.rend(), reference);
+  if (j == references.rend())
+    return;
+  references.erase(--j.base());
+  if (references.empty())
+    references_by_name_.erase(i);
+}
+
+std::span<const Reference> ChildNameIndex::Find(std::string_view name) const {
+  auto i = references_by_name_.find(name);
+  if (i == references_by_name_.end())
+    return {};
+  return i->second;
+}
+
+}  // namespace scada
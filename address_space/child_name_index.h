@@ -0,0 +1,54 @@
+#pragma once
+
+#include "address_space/reference.h"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace scada {
+
+class Node;
+
+// A node's forward references grouped by the browse name of their targets,
+// so resolving a child by name doesn't scan and copy the name of every
+// target.
+//
+// Built by Node once it has |kMinReferenceCount| forward references, and
+// kept up to date as they or the browse names of their targets change, so
+// readers never build it.
+class ChildNameIndex {
+ public:
+  static constexpr size_t kMinReferenceCount = 16;
+
+  explicit ChildNameIndex(const Node& node);
+
+  // |reference| was appended to the node's forward references.
+  void Add(const Reference& reference);
+  // |reference| was removed from the node's forward references.
+  void Remove(const Reference& reference);
+
+  // Forward references whose target is named |name| in any namespace, in
+  // reference order.
+  std::span<const Reference> Find(std::string_view name) const;
+
+ private:
+  struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+
+  std::unordered_map<std::string,
+                     std::vector<Reference>,
+                     NameHash,
+                     std::equal_to<>>
+      references_by_name_;
+};
+
+}  // namespace scada
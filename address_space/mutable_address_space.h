@@ -1,9 +1,11 @@
 #pragma once
 
 #include "address_space/address_space.h"
+#include "base/lifetime.h"
 #include "common/node_state.h"
 #include "scada/node_attributes.h"
 
+#include <cstddef>
 #include <memory>
 
 namespace scada {
@@ -28,4 +30,29 @@ class MutableAddressSpace : public scada::AddressSpace {
   virtual void DeleteReference(const scada::ReferenceType& type,
                                scada::Node& source,
                                scada::Node& target) = 0;
+
+  // Bracket adding many nodes and references at once, like a configuration
+  // load, so an implementation may defer per-reference work and notifications
+  // until the load ends. |node_count| is the number of nodes about to be
+  // added, if known. Loads may nest; the outermost one ends the load.
+  virtual void BeginBulkLoad(size_t node_count) {}
+  virtual void EndBulkLoad() {}
+
+  // Runs BeginBulkLoad() and EndBulkLoad() for a scope.
+  class BulkLoad {
+   public:
+    explicit BulkLoad(MutableAddressSpace& address_space SCADA_LIFETIME_BOUND,
+                      size_t node_count = 0)
+        : address_space_{address_space} {
+      address_space_.BeginBulkLoad(node_count);
+    }
+
+    ~BulkLoad() { address_space_.EndBulkLoad(); }
+
+    BulkLoad(const BulkLoad&) = delete;
+    BulkLoad& operator=(const BulkLoad&) = delete;
+
+   private:
+    MutableAddressSpace& address_space_;
+  };
 };
@@ -1,5 +1,6 @@
 #include "node.h"
 
+#include "address_space/child_name_index.h"
 #include "address_space/node_utils.h"
 #include "address_space/type_definition.h"
 #include "base/check.h"
@@ -30,10 +31,24 @@ void Node::SetRolePermissions(
 void Node::AddReference(const ReferenceType& reference_type,
                         bool forward,
                         Node& node) {
-  Reference ref{&reference_type, &node};
-  auto& refs = forward ? forward_references_ : inverse_references_;
+  const Reference ref{&reference_type, &node};
+  const auto& refs = forward ? forward_references_ : inverse_references_;
   base::Check(std::find(refs.begin(), refs.end(), ref) == refs.end());
-  refs.emplace_back(ref);
+  LinkReference(reference_type, forward, node);
+}
+
+void Node::LinkReference(const ReferenceType& reference_type,
+                         bool forward,
+                         Node& node) {
+  auto& refs = forward ? forward_references_ : inverse_references_;
+  refs.push_back({&reference_type, &node});
+
+  if (forward) {
+    if (child_name_index_)
+      child_name_index_->Add(refs.back());
+    else if (refs.size() >= ChildNameIndex::kMinReferenceCount)
+      child_name_index_ = std::make_unique<ChildNameIndex>(*this);
+  }
 
   if (forward && reference_type.id() == scada::id::HasTypeDefinition) {
     base::Check(!type_definition_);
@@ -55,6 +70,21 @@ void Node::DeleteReference(const ReferenceType& reference_type,
   auto i = std::find(refs.rbegin(), refs.rend(), ref);
   base::Check(i != refs.rend());
   refs.erase(--i.base());
+
+  if (forward && child_name_index_)
+    child_name_index_->Remove(ref);
+}
+
+void Node::SetBrowseName(QualifiedName browse_name) {
+  browse_name_ = std::move(browse_name);
+
+  // The nodes referencing this one may have indexed it by its old name.
+  for (const auto& ref : inverse_references_) {
+    if (ref.node && ref.node->child_name_index_) {
+      ref.node->child_name_index_ =
+          std::make_unique<ChildNameIndex>(*ref.node);
+    }
+  }
 }
 
 QualifiedName Node::GetBrowseName() const {
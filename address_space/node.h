@@ -11,8 +11,11 @@
 #include <memory>
 #include <vector>
 
+class AddressSpaceImpl;
+
 namespace scada {
 
+class ChildNameIndex;
 class Node;
 class ReferenceType;
 class TypeDefinition;
@@ -35,9 +38,7 @@ class Node {
   virtual NodeClass GetNodeClass() const = 0;
 
   virtual QualifiedName GetBrowseName() const;
-  void SetBrowseName(QualifiedName browse_name) {
-    browse_name_ = std::move(browse_name);
-  }
+  void SetBrowseName(QualifiedName browse_name);
 
   virtual LocalizedText GetDisplayName() const;
   void SetDisplayName(LocalizedText display_name) {
@@ -63,6 +64,12 @@ class Node {
   TypeDefinition* type_definition() { return type_definition_; }
   const TypeDefinition* type_definition() const { return type_definition_; }
 
+  // Forward references by target browse name. Null for nodes with few forward
+  // references, which are scanned instead.
+  const ChildNameIndex* child_name_index() const SCADA_LIFETIME_BOUND {
+    return child_name_index_.get();
+  }
+
   virtual void Startup() {}
   virtual void Shutdown() {}
 
@@ -79,7 +86,16 @@ class Node {
                                bool forward,
                                Node& node);
 
+ protected:
+  // AddReference() without its scan for an equal reference and without
+  // overrides. Only for a bulk load, which rules duplicates out itself.
+  void LinkReference(const ReferenceType& reference_type,
+                     bool forward,
+                     Node& node);
+
  private:
+  friend class ::AddressSpaceImpl;
+
   NodeId id_;
 
   QualifiedName browse_name_;
@@ -91,6 +107,9 @@ class Node {
   References inverse_references_;
 
   TypeDefinition* type_definition_ = nullptr;
+
+  // Built and updated by the mutations below, never by a reader.
+  std::unique_ptr<ChildNameIndex> child_name_index_;
 };
 
 }  // namespace scada
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "scada/view_service.h"
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+// Browse and TranslateBrowsePaths over any node store, so the live address
+// space and its snapshots answer them the same way. |NodeAccessor| adapts the
+// store:
+//
+//   using Node = ...;
+//   const Node* GetNode(const scada::NodeId& node_id) const;
+//   // Resolves a node id that may name a property nested in a node.
+//   const Node* GetNestedNode(const scada::NodeId& node_id,
+//                             std::string_view& nested_name) const;
+//   // Returns a predicate on references of type |reference_type_id|.
+//   auto MakeReferenceMatcher(const scada::NodeId& reference_type_id,
+//                             bool include_subtypes) const;
+//   // References of |node|, in browse order.
+//   const auto& GetReferences(const Node& node, bool forward) const;
+//   // Null if the target is not in the store.
+//   const Node* GetTarget(const Reference& reference) const;
+//   scada::NodeId GetReferenceTypeId(const Reference& reference) const;
+//   // The attributes a reference description reports of a target.
+//   scada::NodeId GetNodeId(const Node& node) const;
+//   scada::NodeClass GetNodeClass(const Node& node) const;
+//   scada::QualifiedName GetBrowseName(const Node& node) const;
+//   scada::LocalizedText GetDisplayName(const Node& node) const;
+//   scada::NodeId GetTypeDefinitionId(const Node& node) const;
+//   // Whether the type definition of |node| declares property |name|.
+//   bool HasPropertyDeclaration(const Node& node, std::string_view name) const;
+//   bool IsSubtypeOf(const scada::NodeId& type_id,
+//                    const scada::NodeId& supertype_id) const;
+//   // Looks up the forward child |name| of |node| matching |matcher| in a
+//   // browse name index. std::nullopt if |node| has no index.
+//   std::optional<const Node*> FindIndexedChild(
+//       const Node& node, std::string_view name, const Matcher& matcher) const;
+//
+// Translated path steps are remembered, so the paths of one batch that start
+// at the same node share the steps of their common prefix; a browser is meant
+// to live for one batch.
+template <class NodeAccessor>
+class NodeBrowser {
+ public:
+  using Node = typename NodeAccessor::Node;
+
+  explicit NodeBrowser(const NodeAccessor& accessor) : accessor_{accessor} {}
+
+  scada::BrowseResult Browse(
+      const scada::BrowseDescription& description) const;
+
+  scada::BrowsePathResult Translate(const scada::BrowsePath& input);
+
+ private:
+  // Refers to an element of the batch being translated.
+  struct Step {
+    const Node* node;
+    const scada::RelativePathElement* element;
+
+    bool operator==(const Step& other) const {
+      return node == other.node &&
+             element->reference_type_id == other.element->reference_type_id &&
+             element->inverse == other.element->inverse &&
+             element->include_subtypes == other.element->include_subtypes &&
+             element->target_name == other.element->target_name;
+    }
+  };
+
+  struct StepHash {
+    size_t operator()(const Step& step) const {
+      return std::hash<const void*>{}(step.node) ^
+             (std::hash<std::string_view>{}(step.element->target_name.name()) *
+              31);
+    }
+  };
+
+  scada::BrowseResult BrowseNode(
+      const Node& node,
+      const scada::BrowseDescription& description) const;
+
+  scada::BrowseResult BrowseProperty(
+      const Node& node,
+      std::string_view nested_name,
+      const scada::BrowseDescription& description) const;
+
+  const Node* Resolve(const Node& node,
+                      const scada::RelativePathElement& element);
+
+  const Node* FindTarget(const Node& node,
+                         const scada::RelativePathElement& element) const;
+
+  const NodeAccessor& accessor_;
+  std::unordered_map<Step, const Node*, StepHash> resolved_steps_;
+};
+
+template <class NodeAccessor>
+inline scada::BrowseResult NodeBrowser<NodeAccessor>::Browse(
+    const scada::BrowseDescription& description) const {
+  std::string_view nested_name;
+  auto* node = accessor_.GetNestedNode(description.node_id, nested_name);
+  if (!node)
+    return {scada::StatusCode::Bad_WrongNodeId};
+
+  if (nested_name.empty())
+    return BrowseNode(*node, description);
+
+  return BrowseProperty(*node, nested_name, description);
+}
+
+template <class NodeAccessor>
+inline scada::BrowseResult NodeBrowser<NodeAccessor>::BrowseNode(
+    const Node& node,
+    const scada::BrowseDescription& description) const {
+  scada::BrowseResult result;
+  result.status_code = scada::StatusCode::Good;
+
+  // OPC UA Part 4 §7.3: nodeClassMask filters returned references by the target
+  // node's NodeClass (0 = any).
+  // https://reference.opcfoundation.org/Core/Part4/v105/docs/7.3
+  const auto matches_node_class = [&](scada::NodeClass node_class) {
+    return description.node_class_mask == 0 ||
+           (description.node_class_mask &
+            static_cast<scada::UInt32>(node_class)) != 0;
+  };
+
+  // OPC UA Part 4 §7.3: resultMask selects which ReferenceDescription fields to
+  // populate; unrequested fields stay at their defaults.
+  const auto mask = description.result_mask;
+  const auto make_reference = [&](const auto& ref, const Node& target,
+                                  bool forward) {
+    scada::ReferenceDescription desc;
+    if (mask & scada::kBrowseResultReferenceType)
+      desc.reference_type_id = accessor_.GetReferenceTypeId(ref);
+    desc.forward = (mask & scada::kBrowseResultIsForward) ? forward : false;
+    desc.node_id = accessor_.GetNodeId(target);
+    if (mask & scada::kBrowseResultNodeClass)
+      desc.node_class = accessor_.GetNodeClass(target);
+    if (mask & scada::kBrowseResultBrowseName)
+      desc.browse_name = accessor_.GetBrowseName(target);
+    if (mask & scada::kBrowseResultDisplayName)
+      desc.display_name = accessor_.GetDisplayName(target);
+    if (mask & scada::kBrowseResultTypeDefinition)
+      desc.type_definition = accessor_.GetTypeDefinitionId(target);
+    return desc;
+  };
+
+  const auto matches_type = accessor_.MakeReferenceMatcher(
+      description.reference_type_id, description.include_subtypes);
+
+  const auto append_references = [&](bool forward) {
+    for (const auto& ref : accessor_.GetReferences(node, forward)) {
+      // Skip references to targets not present in the store rather than
+      // dereferencing a null node.
+      auto* target = accessor_.GetTarget(ref);
+      if (!target || !matches_type(ref) ||
+          !matches_node_class(accessor_.GetNodeClass(*target))) {
+        continue;
+      }
+      result.references.push_back(make_reference(ref, *target, forward));
+    }
+  };
+
+  if (description.direction == scada::BrowseDirection::Forward ||
+      description.direction == scada::BrowseDirection::Both) {
+    append_references(/*forward=*/true);
+  }
+
+  if (description.direction == scada::BrowseDirection::Inverse ||
+      description.direction == scada::BrowseDirection::Both) {
+    append_references(/*forward=*/false);
+  }
+
+  return result;
+}
+
+template <class NodeAccessor>
+inline scada::BrowseResult NodeBrowser<NodeAccessor>::BrowseProperty(
+    const Node& node,
+    std::string_view nested_name,
+    const scada::BrowseDescription& description) const {
+  scada::BrowseResult result;
+
+  if (!description.include_subtypes) {
+    // Browse descriptions arrive in service requests (external input).
+    result.status_code = scada::StatusCode::Bad;
+    return result;
+  }
+
+  if (!accessor_.HasPropertyDeclaration(node, nested_name)) {
+    result.status_code = scada::StatusCode::Bad_WrongNodeId;
+    return result;
+  }
+
+  if (description.direction == scada::BrowseDirection::Forward ||
+      description.direction == scada::BrowseDirection::Both) {
+    if (accessor_.IsSubtypeOf(scada::id::HasTypeDefinition,
+                              description.reference_type_id))
+      result.references.emplace_back(scada::id::HasTypeDefinition,
+                                     /*forward=*/true, scada::id::PropertyType,
+                                     scada::NodeClass::VariableType);
+  }
+
+  if (description.direction == scada::BrowseDirection::Inverse ||
+      description.direction == scada::BrowseDirection::Both) {
+    if (accessor_.IsSubtypeOf(scada::id::HasProperty,
+                              description.reference_type_id))
+      result.references.emplace_back(
+          scada::id::HasProperty, /*forward=*/false, accessor_.GetNodeId(node),
+          accessor_.GetNodeClass(node));
+  }
+
+  return result;
+}
+
+template <class NodeAccessor>
+inline scada::BrowsePathResult NodeBrowser<NodeAccessor>::Translate(
+    const scada::BrowsePath& input) {
+  auto* node = accessor_.GetNode(input.node_id);
+  if (!node)
+    return {scada::StatusCode::Bad_WrongNodeId};
+
+  const auto& relative_path = input.relative_path;
+  if (relative_path.empty())
+    return {scada::StatusCode::Bad_NothingToDo, {}};
+
+  auto* current_node = Resolve(*node, relative_path[0]);
+  if (!current_node)
+    return {scada::StatusCode::Bad_BrowseNameInvalid};
+
+  size_t i = 1;
+  for (; i < relative_path.size(); ++i) {
+    auto* next_node = Resolve(*current_node, relative_path[i]);
+    if (!next_node)
+      break;
+    current_node = next_node;
+  }
+
+  return {scada::StatusCode::Good, {{accessor_.GetNodeId(*current_node), i}}};
+}
+
+template <class NodeAccessor>
+inline const typename NodeAccessor::Node* NodeBrowser<NodeAccessor>::Resolve(
+    const Node& node,
+    const scada::RelativePathElement& element) {
+  auto [i, inserted] = resolved_steps_.try_emplace(Step{&node, &element});
+  if (inserted)
+    i->second = FindTarget(node, element);
+  return i->second;
+}
+
+template <class NodeAccessor>
+inline const typename NodeAccessor::Node* NodeBrowser<NodeAccessor>::FindTarget(
+    const Node& node,
+    const scada::RelativePathElement& element) const {
+  const auto matches_type = accessor_.MakeReferenceMatcher(
+      element.reference_type_id, element.include_subtypes);
+  const auto name = element.target_name.name();
+
+  // TODO: Compare namespace indexes.
+  if (!element.inverse) {
+    if (auto target = accessor_.FindIndexedChild(node, name, matches_type))
+      return *target;
+  }
+
+  for (const auto& ref : accessor_.GetReferences(node, !element.inverse)) {
+    if (!matches_type(ref))
+      continue;
+    auto* target = accessor_.GetTarget(ref);
+    if (target && accessor_.GetBrowseName(*target).name() == name)
+      return target;
+  }
+  return nullptr;
+}
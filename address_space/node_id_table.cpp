@@ -0,0 +1,52 @@
+#include "address_space/node_id_table.h"
+
+#include "base/check.h"
+
+NodeIdTable::NodeIdTable() : index_{0, Hash{this}, Equal{this}} {}
+
+NodeHandle NodeIdTable::Intern(const scada::NodeId& node_id) {
+  if (auto i = index_.find(node_id); i != index_.end())
+    return NodeHandle{*i};
+
+  if (!free_handles_.empty()) {
+    auto index = free_handles_.back();
+    free_handles_.pop_back();
+    node_ids_[index] = node_id;
+    hashes_[index] = Hash{this}(node_id);
+    index_.insert(index);
+    return NodeHandle{index};
+  }
+
+  scada::base::Check(node_ids_.size() < UINT32_MAX);
+  auto index = static_cast<uint32_t>(node_ids_.size());
+  node_ids_.emplace_back(node_id);
+  hashes_.emplace_back(Hash{this}(node_id));
+  index_.insert(index);
+  return NodeHandle{index};
+}
+
+void NodeIdTable::Remove(NodeHandle handle) {
+  auto index = static_cast<uint32_t>(handle);
+  // Erased while the id and its cached hash are still in place.
+  scada::base::Check(index_.erase(index) == 1);
+  node_ids_[index] = scada::NodeId{};
+  free_handles_.emplace_back(index);
+}
+
+NodeHandle NodeIdTable::Find(const scada::NodeId& node_id) const {
+  auto i = index_.find(node_id);
+  return i != index_.end() ? NodeHandle{*i} : kInvalidNodeHandle;
+}
+
+void NodeIdTable::reserve(size_t count) {
+  node_ids_.reserve(count);
+  hashes_.reserve(count);
+  index_.reserve(count);
+}
+
+void NodeIdTable::clear() {
+  index_.clear();
+  node_ids_.clear();
+  hashes_.clear();
+  free_handles_.clear();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "base/lifetime.h"
+#include "scada/node_id.h"
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+// Compact handle of a NodeId interned in a `NodeIdTable`. Handles are dense,
+// starting at zero, so they can index plain vectors.
+enum class NodeHandle : uint32_t {};
+
+inline constexpr NodeHandle kInvalidNodeHandle{UINT32_MAX};
+
+// Interns NodeIds: each distinct id is stored once and gets a 32-bit handle
+// that stays valid until the id is removed. Removed handles are handed out
+// again to ids interned later, so the table doesn't grow with node churn.
+//
+// Lookups hash a NodeId once; everything keyed by the returned handle is then
+// a vector index or an integer hash, with no string hashing or comparison.
+class NodeIdTable {
+ public:
+  NodeIdTable();
+
+  // The index refers back to this table; it's neither copied nor moved.
+  NodeIdTable(const NodeIdTable&) = delete;
+  NodeIdTable& operator=(const NodeIdTable&) = delete;
+
+  // Returns the handle of |node_id|, interning it on first use.
+  NodeHandle Intern(const scada::NodeId& node_id);
+
+  // Returns |kInvalidNodeHandle| if |node_id| was never interned.
+  NodeHandle Find(const scada::NodeId& node_id) const;
+
+  const scada::NodeId& Get(NodeHandle handle) const SCADA_LIFETIME_BOUND {
+    return node_ids_[static_cast<size_t>(handle)];
+  }
+
+  // Releases |handle| for reuse. It must not be used afterwards.
+  void Remove(NodeHandle handle);
+
+  // Number of interned ids.
+  size_t size() const { return node_ids_.size() - free_handles_.size(); }
+
+  // Upper bound of the handles in use, for sizing vectors indexed by handle.
+  size_t handle_count() const { return node_ids_.size(); }
+
+  void reserve(size_t count);
+
+  void clear();
+
+ private:
+  // Handles are hashed and compared through the ids they refer to. Hashes are
+  // cached, so rehashing never re-hashes string ids.
+  struct Hash {
+    using is_transparent = void;
+    size_t operator()(uint32_t index) const { return table->hashes_[index]; }
+    size_t operator()(const scada::NodeId& node_id) const {
+      return std::hash<scada::NodeId>{}(node_id);
+    }
+    const NodeIdTable* table;
+  };
+
+  struct Equal {
+    using is_transparent = void;
+    bool operator()(uint32_t a, uint32_t b) const { return a == b; }
+    bool operator()(uint32_t index, const scada::NodeId& node_id) const {
+      return table->node_ids_[index] == node_id;
+    }
+    bool operator()(const scada::NodeId& node_id, uint32_t index) const {
+      return table->node_ids_[index] == node_id;
+    }
+    const NodeIdTable* table;
+  };
+
+  std::vector<scada::NodeId> node_ids_;
+  std::vector<size_t> hashes_;
+  std::unordered_set<uint32_t, Hash, Equal> index_;
+  // Removed handles, reused latest first.
+  std::vector<uint32_t> free_handles_;
+};
@@ -0,0 +1,82 @@
+#include "address_space/node_id_table.h"
+
+#include <gmock/gmock.h>
+
+#include <string>
+
+TEST(NodeIdTable, InternsOnce) {
+  NodeIdTable table;
+
+  const scada::NodeId node_id1{"Node.1", 2};
+  const scada::NodeId node_id2{"Node.2", 2};
+
+  auto handle1 = table.Intern(node_id1);
+  auto handle2 = table.Intern(node_id2);
+
+  EXPECT_NE(handle1, handle2);
+  EXPECT_EQ(table.Intern(node_id1), handle1);
+  EXPECT_EQ(table.size(), 2u);
+  EXPECT_EQ(table.Get(handle1), node_id1);
+  EXPECT_EQ(table.Get(handle2), node_id2);
+}
+
+TEST(NodeIdTable, FindDoesNotIntern) {
+  NodeIdTable table;
+
+  const scada::NodeId node_id{"Node", 2};
+
+  EXPECT_EQ(table.Find(node_id), kInvalidNodeHandle);
+  EXPECT_EQ(table.size(), 0u);
+
+  auto handle = table.Intern(node_id);
+  EXPECT_EQ(table.Find(node_id), handle);
+}
+
+TEST(NodeIdTable, HandlesAreDenseAndStable) {
+  NodeIdTable table;
+
+  // Enough ids to force several rehashes.
+  for (int i = 0; i < 10000; ++i) {
+    scada::NodeId node_id{"Node." + std::to_string(i), 2};
+    EXPECT_EQ(table.Intern(node_id), static_cast<NodeHandle>(i));
+  }
+
+  for (int i = 0; i < 10000; ++i) {
+    scada::NodeId node_id{"Node." + std::to_string(i), 2};
+    EXPECT_EQ(table.Find(node_id), static_cast<NodeHandle>(i));
+  }
+}
+
+TEST(NodeIdTable, RemovedHandleIsReused) {
+  NodeIdTable table;
+
+  const scada::NodeId node_id1{"Node.1", 2};
+  const scada::NodeId node_id2{"Node.2", 2};
+  const scada::NodeId node_id3{"Node.3", 2};
+
+  auto handle1 = table.Intern(node_id1);
+  auto handle2 = table.Intern(node_id2);
+
+  table.Remove(handle1);
+  EXPECT_EQ(table.Find(node_id1), kInvalidNodeHandle);
+  EXPECT_EQ(table.Find(node_id2), handle2);
+  EXPECT_EQ(table.size(), 1u);
+
+  EXPECT_EQ(table.Intern(node_id3), handle1);
+  EXPECT_EQ(table.Get(handle1), node_id3);
+  EXPECT_EQ(table.Find(node_id3), handle1);
+  EXPECT_EQ(table.size(), 2u);
+  EXPECT_EQ(table.handle_count(), 2u);
+}
+
+TEST(NodeIdTable, ClearStartsOver) {
+  NodeIdTable table;
+
+  table.Intern(scada::NodeId{"Node.1", 2});
+  table.Intern(scada::NodeId{"Node.2", 2});
+  table.clear();
+
+  EXPECT_EQ(table.size(), 0u);
+  EXPECT_EQ(table.Find(scada::NodeId{"Node.1", 2}), kInvalidNodeHandle);
+  EXPECT_EQ(table.Intern(scada::NodeId{"Node.2", 2}), NodeHandle{0});
+}
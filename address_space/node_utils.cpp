@@ -2,8 +2,10 @@
 #include "base/check.h"
 
 #include "address_space/address_space.h"
+#include "address_space/child_name_index.h"
 #include "address_space/object.h"
 #include "address_space/type_definition.h"
+#include "address_space/type_hierarchy_index.h"
 #include "address_space/variable.h"
 #include "base/range_util.h"
 #include "scada/standard_node_ids.h"
@@ -256,8 +258,10 @@ bool IsRefSubtypeOf::operator()(const Reference& ref) const {
   // address space rather than crashing.
   if (!ref.type)
     return false;
-  if (include_subtypes_)
-    return IsSubtypeOf(*ref.type, reference_type_id_);
+  if (include_subtypes_) {
+    return reference_type_ ? IsSubtypeOf(*ref.type, *reference_type_)
+                           : IsSubtypeOf(*ref.type, reference_type_id_);
+  }
   else
     return ref.type->id() == reference_type_id_;
 }
@@ -268,7 +272,23 @@ bool IsNonPropReference::operator()(const Reference& ref) const {
   return !IsSubtypeOf(*ref.type, id::NonHierarchicalReferences);
 }
 
+bool IsSubtypeOf(const TypeDefinition& type, const TypeDefinition& supertype) {
+  if (auto* index = type.hierarchy_index();
+      index && index == supertype.hierarchy_index()) {
+    return index->IsSubtypeOf(type, supertype);
+  }
+  for (auto* t = &type; t; t = t->supertype()) {
+    if (t == &supertype)
+      return true;
+  }
+  return false;
+}
+
 bool IsSubtypeOf(const TypeDefinition& type, const NodeId& supertype_id) {
+  if (auto* index = type.hierarchy_index()) {
+    if (auto* supertype = index->FindType(supertype_id))
+      return index->IsSubtypeOf(type, *supertype);
+  }
   for (auto* supertype = &type; supertype; supertype = supertype->supertype()) {
     if (supertype->id() == supertype_id)
       return true;
@@ -400,6 +420,14 @@ Status SetPropertyValueHelper(Node& node,
 }
 
 Node* FindChild(const Node& parent, std::string_view browse_name) {
+  if (const auto* index = parent.child_name_index()) {
+    for (const auto& ref : index->Find(browse_name)) {
+      if (IsSubtypeOf(*ref.type, id::HierarchicalReferences))
+        return ref.node;
+    }
+    return nullptr;
+  }
+
   for (auto* child : GetChildren(parent)) {
     if (child->GetBrowseName().name() == browse_name)
       return child;
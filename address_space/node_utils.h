@@ -75,6 +75,9 @@ inline scada::NodeId GetDeclarationId(const Node& node) {
   return GetNodeId(GetDeclaration(node));
 }
 
+// Constant time when both types are registered in the same address space's
+// TypeHierarchyIndex; walks the supertype chain otherwise.
+bool IsSubtypeOf(const TypeDefinition& type, const TypeDefinition& supertype);
 bool IsSubtypeOf(const TypeDefinition& type, const NodeId& supertype_id);
 bool IsInstanceOf(const Node* node, const NodeId& type_id);
 bool IsChildOf(const Node* node, const NodeId& parent_id);
@@ -110,6 +113,9 @@ struct IsRefSubtypeOf {
 
   const NodeId reference_type_id_;
   bool include_subtypes_ = true;
+  // The node of |reference_type_id_|, when the caller has looked it up, so
+  // subtype checks don't resolve the id once per reference.
+  const TypeDefinition* reference_type_ = nullptr;
 };
 
 inline auto GetNonPropReferences(const Node& node) {
@@ -124,9 +130,11 @@ struct RefNode {
 template <class References>
 inline auto FilterReferences(const References& references,
                              const NodeId& reference_type_id,
-                             bool include_subtypes = true) {
-  return references | boost::adaptors::filtered(
-                          IsRefSubtypeOf{reference_type_id, include_subtypes});
+                             bool include_subtypes = true,
+                             const TypeDefinition* reference_type = nullptr) {
+  return references |
+         boost::adaptors::filtered(IsRefSubtypeOf{
+             reference_type_id, include_subtypes, reference_type});
 }
 
 template <class References>
@@ -0,0 +1,811 @@
+#include "address_space/nodeset_image.h"
+
+#include "address_space/address_space_xml.h"
+#include "common/node_state.h"
+#include "scada/localized_text.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+#include <unordered_map>
+
+// Image layout, little-endian, every section 4-byte aligned:
+//
+//   header:      Header
+//   nodes:       node_count * NodeRecord
+//   references:  reference_count * ReferenceRecord, each node's references
+//                contiguous
+//   strings:     (string_count + 1) * u32 offsets into the string data
+//   values:      value_data_size bytes of encoded node values
+//   string data: string_data_size bytes
+//
+// Strings - browse and display names, byte and text values, string node IDs -
+// are interned: records refer to them by index, and index 0 is
+// the empty string. Bump kVersion on any layout change.
+
+namespace scada {
+namespace {
+
+static_assert(std::endian::native == std::endian::little,
+              "Nodeset images are little-endian");
+
+constexpr char kMagic[4] = {'S', 'N', 'S', 'I'};
+constexpr uint32_t kVersion = 1;
+
+constexpr uint32_t kNoValue = UINT32_MAX;
+
+struct Header {
+  char magic[4];
+  uint32_t version;
+  uint32_t node_count;
+  uint32_t reference_count;
+  uint32_t string_count;
+  uint32_t string_data_size;
+  uint32_t value_data_size;
+  uint32_t reserved;
+};
+
+enum class IdKind : uint16_t {
+  Null,
+  // |value| is the numeric ID.
+  Numeric,
+  // |value| is the string index of the string ID.
+  String,
+};
+
+struct IdRecord {
+  uint16_t namespace_index;
+  IdKind kind;
+  uint32_t value;
+};
+
+struct NodeRecord {
+  IdRecord node_id;
+  IdRecord type_definition_id;
+  IdRecord parent_id;
+  IdRecord reference_type_id;
+  IdRecord supertype_id;
+  IdRecord data_type;
+  uint32_t node_class;
+  uint32_t browse_name_namespace;
+  uint32_t browse_name;
+  uint32_t display_name;
+  uint32_t inverse_name;
+  // Offset into the value data, or kNoValue.
+  uint32_t value;
+  uint32_t first_reference;
+  uint32_t reference_count;
+};
+
+struct ReferenceRecord {
+  IdRecord reference_type_id;
+  IdRecord node_id;
+  uint32_t forward;
+  uint32_t node_class;
+};
+
+static_assert(sizeof(Header) == 32);
+static_assert(sizeof(IdRecord) == 8);
+static_assert(sizeof(NodeRecord) == 80);
+static_assert(sizeof(ReferenceRecord) == 24);
+
+size_t AlignedSize(size_t size) {
+  return (size + 3) & ~size_t{3};
+}
+
+class ImageWriter {
+ public:
+  ImageWriter() { string_offsets_.push_back(0); }
+
+  Status PutNode(const NodeState& node_state);
+
+  std::string Finish();
+
+ private:
+  uint32_t Intern(std::string_view value);
+  IdRecord MakeId(const NodeId& node_id);
+
+  template <class T>
+  void PutValueData(const T& value) {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    value_data_.append(bytes, sizeof(value));
+  }
+
+  void PutString(std::string_view value) { PutValueData(Intern(value)); }
+  void PutText(const LocalizedText& value) { PutString(ToString(value)); }
+  void PutNodeId(const NodeId& value) { PutValueData(MakeId(value)); }
+  void PutByteString(const ByteString& value) {
+    PutString({value.data(), value.size()});
+  }
+
+  template <class T, class Put>
+  void PutArray(const std::vector<T>& values, Put put) {
+    PutValueData(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+      (this->*put)(value);
+    }
+  }
+
+  bool PutValue(const Variant& value);
+
+  std::vector<NodeRecord> nodes_;
+  std::vector<ReferenceRecord> references_;
+  std::vector<uint32_t> string_offsets_;
+  std::string string_data_;
+  std::unordered_map<std::string, uint32_t> string_indexes_;
+  std::string value_data_;
+  bool unsupported_node_id_ = false;
+};
+
+uint32_t ImageWriter::Intern(std::string_view value) {
+  if (value.empty()) {
+    return 0;
+  }
+
+  auto [i, inserted] = string_indexes_.try_emplace(
+      std::string{value}, static_cast<uint32_t>(string_offsets_.size()));
+  if (inserted) {
+    string_data_.append(value);
+    string_offsets_.push_back(static_cast<uint32_t>(string_data_.size()));
+  }
+  return i->second;
+}
+
+IdRecord ImageWriter::MakeId(const NodeId& node_id) {
+  if (node_id.is_null()) {
+    return {.namespace_index = 0, .kind = IdKind::Null, .value = 0};
+  }
+  if (node_id.type() == NodeIdType::Numeric) {
+    return {.namespace_index = node_id.namespace_index(),
+            .kind = IdKind::Numeric,
+            .value = node_id.numeric_id()};
+  }
+  if (node_id.type() != NodeIdType::String) {
+    // The static nodesets only use numeric and string IDs.
+    unsupported_node_id_ = true;
+    return {.namespace_index = 0, .kind = IdKind::Null, .value = 0};
+  }
+  return {.namespace_index = node_id.namespace_index(),
+          .kind = IdKind::String,
+          .value = Intern(node_id.string_id())};
+}
+
+bool ImageWriter::PutValue(const Variant& value) {
+  PutValueData(static_cast<uint8_t>(value.type()));
+  PutValueData(static_cast<uint8_t>(value.is_array()));
+
+  if (value.is_array()) {
+    switch (value.type()) {
+      case Variant::BYTE_STRING:
+        PutArray(value.get<std::vector<ByteString>>(),
+                 &ImageWriter::PutByteString);
+        return true;
+      case Variant::STRING:
+        PutArray(value.get<std::vector<String>>(), &ImageWriter::PutString);
+        return true;
+      case Variant::LOCALIZED_TEXT:
+        PutArray(value.get<std::vector<LocalizedText>>(),
+                 &ImageWriter::PutText);
+        return true;
+      case Variant::NODE_ID:
+        PutArray(value.get<std::vector<NodeId>>(), &ImageWriter::PutNodeId);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  switch (value.type()) {
+    case Variant::EMPTY:
+      return true;
+    case Variant::BOOL:
+      PutValueData(static_cast<uint8_t>(value.as_bool()));
+      return true;
+    case Variant::INT8:
+      PutValueData(value.get<Int8>());
+      return true;
+    case Variant::UINT8:
+      PutValueData(value.get<UInt8>());
+      return true;
+    case Variant::INT16:
+      PutValueData(value.get<Int16>());
+      return true;
+    case Variant::UINT16:
+      PutValueData(value.get<UInt16>());
+      return true;
+    case Variant::INT32:
+      PutValueData(value.get<Int32>());
+      return true;
+    case Variant::UINT32:
+      PutValueData(value.get<UInt32>());
+      return true;
+    case Variant::INT64:
+      PutValueData(value.get<Int64>());
+      return true;
+    case Variant::UINT64:
+      PutValueData(value.get<UInt64>());
+      return true;
+    case Variant::DOUBLE:
+      PutValueData(value.get<Double>());
+      return true;
+    case Variant::BYTE_STRING:
+      PutByteString(value.get<ByteString>());
+      return true;
+    case Variant::STRING:
+      PutString(value.as_string());
+      return true;
+    case Variant::LOCALIZED_TEXT:
+      PutText(value.as_localized_text());
+      return true;
+    case Variant::NODE_ID:
+      PutNodeId(value.as_node_id());
+      return true;
+    case Variant::DATE_TIME:
+      PutValueData(value.get<DateTime>().ToInternalValue());
+      return true;
+    default:
+      return false;
+  }
+}
+
+Status ImageWriter::PutNode(const NodeState& node_state) {
+  const auto& attributes = node_state.attributes;
+
+  uint32_t value_offset = kNoValue;
+  if (attributes.value) {
+    value_offset = static_cast<uint32_t>(value_data_.size());
+    if (!PutValue(*attributes.value)) {
+      return StatusCode::Bad_WrongTypeId;
+    }
+  }
+
+  nodes_.push_back(NodeRecord{
+      .node_id = MakeId(node_state.node_id),
+      .type_definition_id = MakeId(node_state.type_definition_id),
+      .parent_id = MakeId(node_state.parent_id),
+      .reference_type_id = MakeId(node_state.reference_type_id),
+      .supertype_id = MakeId(node_state.supertype_id),
+      .data_type = MakeId(attributes.data_type),
+      .node_class = static_cast<uint32_t>(node_state.node_class),
+      .browse_name_namespace = attributes.browse_name.namespace_index(),
+      .browse_name = Intern(attributes.browse_name.name()),
+      .display_name = Intern(ToString(attributes.display_name)),
+      .inverse_name = Intern(ToString(attributes.inverse_name)),
+      .value = value_offset,
+      .first_reference = static_cast<uint32_t>(references_.size()),
+      .reference_count =
+          static_cast<uint32_t>(node_state.references.size())});
+
+  for (const auto& reference : node_state.references) {
+    references_.push_back(ReferenceRecord{
+        .reference_type_id = MakeId(reference.reference_type_id),
+        .node_id = MakeId(reference.node_id),
+        .forward = reference.forward,
+        .node_class = static_cast<uint32_t>(reference.node_class)});
+  }
+
+  if (unsupported_node_id_) {
+    return StatusCode::Bad_WrongNodeId;
+  }
+  return OkStatus();
+}
+
+std::string ImageWriter::Finish() {
+  const Header header{
+      .magic = {kMagic[0], kMagic[1], kMagic[2], kMagic[3]},
+      .version = kVersion,
+      .node_count = static_cast<uint32_t>(nodes_.size()),
+      .reference_count = static_cast<uint32_t>(references_.size()),
+      .string_count = static_cast<uint32_t>(string_offsets_.size() - 1),
+      .string_data_size = static_cast<uint32_t>(string_data_.size()),
+      .value_data_size = static_cast<uint32_t>(value_data_.size()),
+      .reserved = 0};
+
+  auto append = [](std::string& image, const auto& values) {
+    image.append(reinterpret_cast<const char*>(values.data()),
+                 values.size() * sizeof(values[0]));
+  };
+
+  std::string image;
+  image.reserve(sizeof(header) + nodes_.size() * sizeof(NodeRecord) +
+                references_.size() * sizeof(ReferenceRecord) +
+                string_offsets_.size() * sizeof(uint32_t) +
+                AlignedSize(value_data_.size()) + string_data_.size());
+  image.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  append(image, nodes_);
+  append(image, references_);
+  append(image, string_offsets_);
+  image.append(value_data_);
+  image.resize(AlignedSize(image.size()));
+  image.append(string_data_);
+  return image;
+}
+
+class ImageReader {
+ public:
+  // Returns false if the sections don't fit `image`.
+  bool Open(std::string_view image);
+
+  uint32_t node_count() const { return header_.node_count; }
+
+  bool GetNode(uint32_t index, NodeState& node_state) const;
+
+ private:
+  template <class T>
+  T Record(size_t offset, size_t index) const {
+    T record;
+    std::memcpy(&record, image_.data() + offset + index * sizeof(T),
+                sizeof(T));
+    return record;
+  }
+
+  std::optional<std::string_view> GetString(uint32_t index) const;
+  std::optional<NodeId> GetNodeId(const IdRecord& record) const;
+  std::optional<LocalizedText> GetText(uint32_t index) const;
+  bool GetReference(uint32_t index, ReferenceDescription& reference) const;
+
+  class ValueCursor;
+  bool GetValue(uint32_t offset, Variant& value) const;
+
+  std::string_view image_;
+  Header header_{};
+  size_t nodes_offset_ = 0;
+  size_t references_offset_ = 0;
+  size_t string_offsets_offset_ = 0;
+  std::string_view value_data_;
+  std::string_view string_data_;
+};
+
+bool ImageReader::Open(std::string_view image) {
+  if (image.size() < sizeof(Header)) {
+    return false;
+  }
+  std::memcpy(&header_, image.data(), sizeof(Header));
+  if (std::memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header_.version != kVersion) {
+    return false;
+  }
+
+  // Counts are 32-bit, so none of this overflows a 64-bit size_t.
+  nodes_offset_ = sizeof(Header);
+  references_offset_ =
+      nodes_offset_ + size_t{header_.node_count} * sizeof(NodeRecord);
+  string_offsets_offset_ = references_offset_ + size_t{header_.reference_count} *
+                                                    sizeof(ReferenceRecord);
+  const size_t value_data_offset =
+      string_offsets_offset_ +
+      (size_t{header_.string_count} + 1) * sizeof(uint32_t);
+  const size_t string_data_offset =
+      AlignedSize(value_data_offset + header_.value_data_size);
+  if (string_data_offset + header_.string_data_size != image.size()) {
+    return false;
+  }
+
+  image_ = image;
+  value_data_ = image.substr(value_data_offset, header_.value_data_size);
+  string_data_ = image.substr(string_data_offset, header_.string_data_size);
+
+  // Checked once here, so GetString() only checks the index.
+  uint32_t previous = 0;
+  for (uint32_t i = 0; i <= header_.string_count; ++i) {
+    const auto offset = Record<uint32_t>(string_offsets_offset_, i);
+    if (offset < previous || offset > string_data_.size() ||
+        (i == 0 && offset != 0)) {
+      return false;
+    }
+    previous = offset;
+  }
+  return previous == string_data_.size();
+}
+
+std::optional<std::string_view> ImageReader::GetString(uint32_t index) const {
+  if (index > header_.string_count) {
+    return std::nullopt;
+  }
+  if (index == 0) {
+    return std::string_view{};
+  }
+  const auto begin = Record<uint32_t>(string_offsets_offset_, index - 1);
+  const auto end = Record<uint32_t>(string_offsets_offset_, index);
+  return string_data_.substr(begin, end - begin);
+}
+
+std::optional<NodeId> ImageReader::GetNodeId(const IdRecord& record) const {
+  switch (record.kind) {
+    case IdKind::Null:
+      return NodeId{};
+    case IdKind::Numeric:
+      return NodeId{record.value, record.namespace_index};
+    case IdKind::String:
+      if (auto text = GetString(record.value)) {
+        return NodeId{std::string{*text}, record.namespace_index};
+      }
+      return std::nullopt;
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<LocalizedText> ImageReader::GetText(uint32_t index) const {
+  auto text = GetString(index);
+  if (!text) {
+    return std::nullopt;
+  }
+  return ToLocalizedText(*text);
+}
+
+bool ImageReader::GetReference(uint32_t index,
+                               ReferenceDescription& reference) const {
+  const auto record = Record<ReferenceRecord>(references_offset_, index);
+  auto reference_type_id = GetNodeId(record.reference_type_id);
+  auto node_id = GetNodeId(record.node_id);
+  if (!reference_type_id || !node_id) {
+    return false;
+  }
+  reference.reference_type_id = std::move(*reference_type_id);
+  reference.forward = record.forward != 0;
+  reference.node_id = std::move(*node_id);
+  reference.node_class = static_cast<NodeClass>(record.node_class);
+  return true;
+}
+
+bool ImageReader::GetNode(uint32_t index, NodeState& node_state) const {
+  const auto record = Record<NodeRecord>(nodes_offset_, index);
+  if (size_t{record.first_reference} + record.reference_count >
+      header_.reference_count) {
+    return false;
+  }
+
+  auto node_id = GetNodeId(record.node_id);
+  auto type_definition_id = GetNodeId(record.type_definition_id);
+  auto parent_id = GetNodeId(record.parent_id);
+  auto reference_type_id = GetNodeId(record.reference_type_id);
+  auto supertype_id = GetNodeId(record.supertype_id);
+  auto data_type = GetNodeId(record.data_type);
+  auto browse_name = GetString(record.browse_name);
+  auto display_name = GetText(record.display_name);
+  auto inverse_name = GetText(record.inverse_name);
+  if (!node_id || !type_definition_id || !parent_id || !reference_type_id ||
+      !supertype_id || !data_type || !browse_name || !display_name ||
+      !inverse_name) {
+    return false;
+  }
+
+  node_state.node_id = std::move(*node_id);
+  node_state.node_class = static_cast<NodeClass>(record.node_class);
+  node_state.type_definition_id = std::move(*type_definition_id);
+  node_state.parent_id = std::move(*parent_id);
+  node_state.reference_type_id = std::move(*reference_type_id);
+  node_state.supertype_id = std::move(*supertype_id);
+
+  auto& attributes = node_state.attributes;
+  attributes.browse_name = QualifiedName{
+      std::string{*browse_name},
+      static_cast<NamespaceIndex>(record.browse_name_namespace)};
+  attributes.display_name = std::move(*display_name);
+  attributes.inverse_name = std::move(*inverse_name);
+  attributes.data_type = std::move(*data_type);
+  if (record.value != kNoValue) {
+    Variant value;
+    if (!GetValue(record.value, value)) {
+      return false;
+    }
+    attributes.value = std::move(value);
+  }
+
+  node_state.references.resize(record.reference_count);
+  for (uint32_t i = 0; i < record.reference_count; ++i) {
+    if (!GetReference(record.first_reference + i, node_state.references[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class ImageReader::ValueCursor {
+ public:
+  ValueCursor(const ImageReader& reader, std::string_view data)
+      : reader_{reader}, data_{data} {}
+
+  template <class T>
+  bool Get(T& value) {
+    if (data_.size() < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, data_.data(), sizeof(value));
+    data_.remove_prefix(sizeof(value));
+    return true;
+  }
+
+  bool GetString(String& value) {
+    uint32_t index = 0;
+    std::optional<std::string_view> text;
+    if (!Get(index) || !(text = reader_.GetString(index))) {
+      return false;
+    }
+    value.assign(*text);
+    return true;
+  }
+
+  bool GetByteString(ByteString& value) {
+    String bytes;
+    if (!GetString(bytes)) {
+      return false;
+    }
+    value = ByteString{bytes.begin(), bytes.end()};
+    return true;
+  }
+
+  bool GetText(LocalizedText& value) {
+    uint32_t index = 0;
+    std::optional<LocalizedText> text;
+    if (!Get(index) || !(text = reader_.GetText(index))) {
+      return false;
+    }
+    value = std::move(*text);
+    return true;
+  }
+
+  bool GetNodeId(NodeId& value) {
+    IdRecord record;
+    std::optional<NodeId> node_id;
+    if (!Get(record) || !(node_id = reader_.GetNodeId(record))) {
+      return false;
+    }
+    value = std::move(*node_id);
+    return true;
+  }
+
+  bool GetValue(Variant& value);
+
+ private:
+  template <class T>
+  bool GetScalar(Variant& value) {
+    T scalar{};
+    if (!Get(scalar)) {
+      return false;
+    }
+    value = Variant{scalar};
+    return true;
+  }
+
+  template <class T, class GetItem>
+  bool GetArray(Variant& value, GetItem get_item) {
+    uint32_t count = 0;
+    if (!Get(count)) {
+      return false;
+    }
+    // Each item takes at least 4 bytes; don't let a corrupt count allocate
+    // more than that.
+    if (count > data_.size() / sizeof(uint32_t)) {
+      return false;
+    }
+    std::vector<T> values(count);
+    for (auto& item : values) {
+      if (!(this->*get_item)(item)) {
+        return false;
+      }
+    }
+    value = Variant{std::move(values)};
+    return true;
+  }
+
+  template <class T, class GetItem>
+  bool GetObject(Variant& value, GetItem get_item) {
+    T item;
+    if (!(this->*get_item)(item)) {
+      return false;
+    }
+    value = Variant{std::move(item)};
+    return true;
+  }
+
+  const ImageReader& reader_;
+  std::string_view data_;
+};
+
+bool ImageReader::ValueCursor::GetValue(Variant& value) {
+  uint8_t type = 0;
+  uint8_t is_array = 0;
+  if (!Get(type) || !Get(is_array)) {
+    return false;
+  }
+
+  if (is_array) {
+    switch (static_cast<Variant::Type>(type)) {
+      case Variant::BYTE_STRING:
+        return GetArray<ByteString>(value, &ValueCursor::GetByteString);
+      case Variant::STRING:
+        return GetArray<String>(value, &ValueCursor::GetString);
+      case Variant::LOCALIZED_TEXT:
+        return GetArray<LocalizedText>(value, &ValueCursor::GetText);
+      case Variant::NODE_ID:
+        return GetArray<NodeId>(value, &ValueCursor::GetNodeId);
+      default:
+        return false;
+    }
+  }
+
+  switch (static_cast<Variant::Type>(type)) {
+    case Variant::EMPTY:
+      value = Variant{};
+      return true;
+    case Variant::BOOL: {
+      uint8_t bool_value = 0;
+      if (!Get(bool_value)) {
+        return false;
+      }
+      value = Variant{bool_value != 0};
+      return true;
+    }
+    case Variant::INT8:
+      return GetScalar<Int8>(value);
+    case Variant::UINT8:
+      return GetScalar<UInt8>(value);
+    case Variant::INT16:
+      return GetScalar<Int16>(value);
+    case Variant::UINT16:
+      return GetScalar<UInt16>(value);
+    case Variant::INT32:
+      return GetScalar<Int32>(value);
+    case Variant::UINT32:
+      return GetScalar<UInt32>(value);
+    case Variant::INT64:
+      return GetScalar<Int64>(value);
+    case Variant::UINT64:
+      return GetScalar<UInt64>(value);
+    case Variant::DOUBLE:
+      return GetScalar<Double>(value);
+    case Variant::BYTE_STRING:
+      return GetObject<ByteString>(value, &ValueCursor::GetByteString);
+    case Variant::STRING:
+      return GetObject<String>(value, &ValueCursor::GetString);
+    case Variant::LOCALIZED_TEXT:
+      return GetObject<LocalizedText>(value, &ValueCursor::GetText);
+    case Variant::NODE_ID:
+      return GetObject<NodeId>(value, &ValueCursor::GetNodeId);
+    case Variant::DATE_TIME: {
+      int64_t internal_value = 0;
+      if (!Get(internal_value)) {
+        return false;
+      }
+      value = Variant{DateTime::FromInternalValue(internal_value)};
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool ImageReader::GetValue(uint32_t offset, Variant& value) const {
+  if (offset > value_data_.size()) {
+    return false;
+  }
+  return ValueCursor{*this, value_data_.substr(offset)}.GetValue(value);
+}
+
+// Whether the image at `image_path` exists and no nodeset was changed after it
+// was built.
+bool IsImageCurrent(const std::filesystem::path& image_path,
+                    std::span<const std::filesystem::path> nodeset_paths) {
+  std::error_code ec;
+  const auto image_time = std::filesystem::last_write_time(image_path, ec);
+  if (ec) {
+    return false;
+  }
+
+  return std::ranges::none_of(nodeset_paths, [&](const auto& nodeset_path) {
+    std::error_code ec;
+    const auto nodeset_time =
+        std::filesystem::last_write_time(nodeset_path, ec);
+    return !ec && nodeset_time > image_time;
+  });
+}
+
+std::optional<std::string> ReadFile(const std::filesystem::path& path) {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  std::ifstream stream{path, std::ios::binary};
+  if (!stream) {
+    return std::nullopt;
+  }
+
+  std::string data(static_cast<size_t>(size), '\0');
+  if (!stream.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+    return std::nullopt;
+  }
+  return data;
+}
+
+}  // namespace
+
+Status EncodeNodesetImage(std::span<const NodeState> node_states,
+                          std::string& image) {
+  ImageWriter writer;
+  for (const auto& node_state : node_states) {
+    if (auto status = writer.PutNode(node_state); !status) {
+      return status;
+    }
+  }
+  image = writer.Finish();
+  return OkStatus();
+}
+
+std::optional<std::vector<NodeState>> DecodeNodesetImage(
+    std::string_view image) {
+  ImageReader reader;
+  if (!reader.Open(image)) {
+    return std::nullopt;
+  }
+
+  std::vector<NodeState> node_states(reader.node_count());
+  for (uint32_t i = 0; i < reader.node_count(); ++i) {
+    if (!reader.GetNode(i, node_states[i])) {
+      return std::nullopt;
+    }
+  }
+  return node_states;
+}
+
+Status CompileNodesetImage(
+    std::span<const std::filesystem::path> nodeset_paths,
+    const std::filesystem::path& image_path) {
+  std::vector<NodeState> node_states;
+  if (auto status = ParseStaticNodesets(nodeset_paths, node_states); !status) {
+    return status;
+  }
+
+  std::string image;
+  if (auto status = EncodeNodesetImage(node_states, image); !status) {
+    return status;
+  }
+
+  std::ofstream stream{image_path, std::ios::binary | std::ios::trunc};
+  if (!stream.write(image.data(), static_cast<std::streamsize>(image.size())) ||
+      !stream.flush()) {
+    return StatusCode::Bad;
+  }
+  return OkStatus();
+}
+
+Status LoadNodesetImage(const std::filesystem::path& path,
+                        MutableAddressSpace& address_space,
+                        NodeFactory& node_factory) {
+  auto image = ReadFile(path);
+  if (!image) {
+    return StatusCode::Bad_CantParseString;
+  }
+
+  auto node_states = DecodeNodesetImage(*image);
+  if (!node_states) {
+    return StatusCode::Bad_CantParseString;
+  }
+
+  return CreateParsedNodes(*node_states, address_space, node_factory);
+}
+
+Status LoadStaticNodesetsWithImage(
+    const std::filesystem::path& image_path,
+    std::span<const std::filesystem::path> nodeset_paths,
+    MutableAddressSpace& address_space,
+    NodeFactory& node_factory) {
+  if (IsImageCurrent(image_path, nodeset_paths)) {
+    if (auto image = ReadFile(image_path)) {
+      if (auto node_states = DecodeNodesetImage(*image)) {
+        return CreateParsedNodes(*node_states, address_space, node_factory);
+      }
+    }
+  }
+
+  return LoadStaticNodesets(nodeset_paths, address_space, node_factory);
+}
+
+}  // namespace scada
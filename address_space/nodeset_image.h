@@ -0,0 +1,66 @@
+#pragma once
+
+#include "scada/status.h"
+
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scada {
+struct NodeState;
+}  // namespace scada
+
+class MutableAddressSpace;
+class NodeFactory;
+
+namespace scada {
+
+// A precompiled static nodeset image: the node states LoadStaticNodesets would
+// materialize, already parsed, parent-resolved and sorted, in a compact binary
+// form. Loading an image skips XML parsing entirely, so server startup doesn't
+// pay for it. Images are built at build time by
+// model/gen/compile_nodeset_image.cpp.
+//
+// The image holds an interned string table, fixed-size node records and one
+// reference array indexed by the node records, all addressed by offsets from
+// the start of the file. An image is tied to the format version it was built
+// with; LoadNodesetImage rejects any other, and LoadStaticNodesetsWithImage
+// falls back to the XML nodesets.
+
+// Parses the static nodesets at `nodeset_paths` and writes their image to
+// `image_path`.
+Status CompileNodesetImage(
+    std::span<const std::filesystem::path> nodeset_paths,
+    const std::filesystem::path& image_path);
+
+// Encodes node states returned by ParseStaticNodesets. Fails with
+// Bad_WrongTypeId on a value of a type the image can't keep, and with
+// Bad_WrongNodeId on a node ID that is neither numeric nor a string.
+Status EncodeNodesetImage(std::span<const NodeState> node_states,
+                          std::string& image);
+
+// Returns std::nullopt if `image` is not a valid image of the current version.
+std::optional<std::vector<NodeState>> DecodeNodesetImage(
+    std::string_view image);
+
+// Materializes the image at `path` like LoadStaticNodesets materializes the
+// nodesets it was compiled from. Fails with Bad_CantParseString if the file is
+// missing or not a valid image.
+Status LoadNodesetImage(const std::filesystem::path& path,
+                        MutableAddressSpace& address_space,
+                        NodeFactory& node_factory);
+
+// The static nodeset loader for servers: materializes the image at
+// `image_path` if it is valid and no older than any of `nodeset_paths`, and
+// otherwise loads the nodesets with LoadStaticNodesets. Missing nodesets don't
+// count as newer, so a deployment may ship the image alone.
+Status LoadStaticNodesetsWithImage(
+    const std::filesystem::path& image_path,
+    std::span<const std::filesystem::path> nodeset_paths,
+    MutableAddressSpace& address_space,
+    NodeFactory& node_factory);
+
+}  // namespace scada
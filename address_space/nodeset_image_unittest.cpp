@@ -0,0 +1,156 @@
+#include "address_space/nodeset_image.h"
+
+#include "address_space/address_space_impl2.h"
+#include "address_space/address_space_util.h"
+#include "address_space/address_space_xml.h"
+#include "address_space/generic_node_factory.h"
+#include "common/node_state.h"
+#include "common/test/node_state_matcher.h"
+#include "model/node_id_util.h"
+#include "model/static_nodesets.h"
+#include "scada/localized_text.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace testing;
+
+namespace scada {
+namespace {
+
+std::vector<NodeState> SortedNodeStates(const AddressSpace& address_space) {
+  auto node_states = MakeNodeStates(address_space);
+  std::ranges::sort(node_states, {}, [](const NodeState& node_state) {
+    return NodeIdToScadaString(node_state.node_id);
+  });
+  return node_states;
+}
+
+}  // namespace
+
+TEST(NodesetImage, RoundTrip) {
+  NodeState node_state;
+  node_state.set_node_id(NodeId{1, 5})
+      .set_node_class(NodeClass::Variable)
+      .set_type_definition_id(id::BaseVariableType)
+      .set_parent(id::Organizes, id::RootFolder)
+      .set_browse_name(QualifiedName{"Node", 5})
+      .set_display_name(ToLocalizedText("Node"));
+  node_state.attributes.data_type = id::Double;
+  node_state.attributes.value = Variant{1.5};
+  node_state.references.push_back({.reference_type_id = id::HasComponent,
+                                   .forward = false,
+                                   .node_id = NodeId{"1!Text", 5},
+                                   .node_class = NodeClass::Object});
+
+  NodeState array_state;
+  array_state.set_node_id(NodeId{2, 5})
+      .set_node_class(NodeClass::Variable)
+      .set_browse_name(QualifiedName{"Array", 5});
+  array_state.attributes.value =
+      Variant{std::vector<String>{"a", "b", "a", ""}};
+
+  const std::vector<NodeState> node_states{node_state, array_state};
+
+  std::string image;
+  ASSERT_TRUE(EncodeNodesetImage(node_states, image));
+  const auto decoded = DecodeNodesetImage(image);
+
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_THAT(*decoded, Pointwise(NodeStateEq(), node_states));
+}
+
+TEST(NodesetImage, RejectsCorruptImage) {
+  NodeState node_state;
+  node_state.set_node_id(NodeId{1, 5})
+      .set_browse_name(QualifiedName{"Node", 5});
+
+  std::string image;
+  ASSERT_TRUE(EncodeNodesetImage(std::span{&node_state, 1}, image));
+
+  EXPECT_FALSE(DecodeNodesetImage(image.substr(0, image.size() - 1)));
+  EXPECT_FALSE(DecodeNodesetImage(image + '\0'));
+
+  auto other_version = image;
+  other_version[4] ^= 0x7F;
+  EXPECT_FALSE(DecodeNodesetImage(other_version));
+}
+
+// The image of the static nodesets must materialize exactly what loading the
+// nodesets does.
+TEST(NodesetImage, MatchesStaticNodesets) {
+  const auto image_path =
+      std::filesystem::temp_directory_path() / "nodeset_image_test.bin";
+  ASSERT_TRUE(
+      CompileNodesetImage(GetScadaStaticNodesetSourcePaths(), image_path));
+
+  AddressSpaceImpl2 xml_space;
+  GenericNodeFactory xml_factory{xml_space};
+  ASSERT_TRUE(LoadStaticNodesets(GetScadaStaticNodesetSourcePaths(), xml_space,
+                                 xml_factory));
+
+  AddressSpaceImpl2 image_space;
+  GenericNodeFactory image_factory{image_space};
+  ASSERT_TRUE(LoadNodesetImage(image_path, image_space, image_factory));
+  std::filesystem::remove(image_path);
+
+  const auto xml_states = SortedNodeStates(xml_space);
+  ASSERT_FALSE(xml_states.empty());
+  EXPECT_THAT(SortedNodeStates(image_space),
+              Pointwise(NodeStateEq(), xml_states));
+}
+
+TEST(NodesetImage, StaticLoaderPrefersImage) {
+  const auto image_path =
+      std::filesystem::temp_directory_path() / "nodeset_image_loader_test.bin";
+  ASSERT_TRUE(
+      CompileNodesetImage(GetScadaStaticNodesetSourcePaths(), image_path));
+
+  // Without the nodesets, only the image can load.
+  const std::vector<std::filesystem::path> missing_nodesets = {
+      std::filesystem::temp_directory_path() / "missing_nodeset.xml"};
+  AddressSpaceImpl2 space;
+  GenericNodeFactory factory{space};
+  EXPECT_TRUE(LoadStaticNodesetsWithImage(image_path, missing_nodesets, space,
+                                          factory));
+  std::filesystem::remove(image_path);
+
+  EXPECT_NE(space.GetNode(id::RootFolder), nullptr);
+}
+
+TEST(NodesetImage, StaticLoaderFallsBackToNodesets) {
+  const auto image_path =
+      std::filesystem::temp_directory_path() / "nodeset_image_invalid.bin";
+  std::ofstream{image_path} << "not an image";
+
+  AddressSpaceImpl2 xml_space;
+  GenericNodeFactory xml_factory{xml_space};
+  ASSERT_TRUE(LoadStaticNodesets(GetScadaStaticNodesetSourcePaths(), xml_space,
+                                 xml_factory));
+
+  AddressSpaceImpl2 space;
+  GenericNodeFactory factory{space};
+  EXPECT_TRUE(LoadStaticNodesetsWithImage(
+      image_path, GetScadaStaticNodesetSourcePaths(), space, factory));
+  std::filesystem::remove(image_path);
+
+  EXPECT_THAT(SortedNodeStates(space),
+              Pointwise(NodeStateEq(), SortedNodeStates(xml_space)));
+}
+
+TEST(NodesetImage, MissingFile) {
+  AddressSpaceImpl2 space;
+  GenericNodeFactory factory{space};
+  EXPECT_EQ(LoadNodesetImage(std::filesystem::temp_directory_path() /
+                                 "missing_nodeset_image.bin",
+                             space, factory)
+                .code(),
+            StatusCode::Bad_CantParseString);
+}
+
+}  // namespace scada
@@ -14,10 +14,12 @@ module;
 #include "address_space/address_space.h"
 #include "address_space/address_space_impl.h"
 #include "address_space/address_space_impl2.h"
+#include "address_space/address_space_snapshot.h"
 #include "address_space/address_space_type_system.h"
 #include "address_space/address_space_util.h"
 #include "address_space/address_space_xml.h"
 #include "address_space/attribute_service_impl.h"
+#include "address_space/child_name_index.h"
 #include "address_space/data_variable.h"
 #include "address_space/fallback_node_factory.h"
 #include "address_space/folder.h"
@@ -36,15 +38,19 @@ module;
 #include "address_space/node_factory.h"
 #include "address_space/node_factory_util.h"
 #include "address_space/node_format.h"
+#include "address_space/node_id_table.h"
 #include "address_space/node_utils.h"
 #include "address_space/node_variable_handle.h"
+#include "address_space/nodeset_image.h"
 #include "address_space/object.h"
 #include "address_space/property.h"
 #include "address_space/property_ids.h"
 #include "address_space/reference.h"
+#include "address_space/snapshot_view_service.h"
 #include "address_space/standard_address_space.h"
 #include "address_space/standard_type_system.h"
 #include "address_space/type_definition.h"
+#include "address_space/type_hierarchy_index.h"
 #include "address_space/variable.h"
 #include "address_space/view_service_impl.h"
 
@@ -123,11 +129,25 @@ using scada::MakeStandardNodeStates;
 using scada::ParseDataValueFieldString;
 using scada::RefNode;
 
+// address_space_snapshot.h
+using scada::AddressSpaceSnapshot;
+using scada::NodeSnapshot;
+
+// child_name_index.h / type_hierarchy_index.h
+using scada::ChildNameIndex;
+using scada::TypeHierarchyIndex;
+
 // address_space_xml.h
 using scada::LoadAddressSpaceXml;
 using scada::LoadStaticAddressSpace;
 using scada::SaveAddressSpaceXml;
 
+// nodeset_image.h
+using scada::CompileNodesetImage;
+using scada::DecodeNodesetImage;
+using scada::EncodeNodesetImage;
+using scada::LoadNodesetImage;
+
 }  // namespace scada
 
 export {
@@ -152,6 +172,12 @@ export {
   using ::StandardAddressSpace;
   using ::StandardTypeSystem;
 
+  // address_space_snapshot.h / snapshot_view_service.h
+  using ::AddressSpaceSnapshotPublisher;
+  using ::AddressSpaceSnapshotPublisherContext;
+  using ::SnapshotViewService;
+  using ::SnapshotViewServiceContext;
+
   // node_builder.h / node_builder_impl.h / node_factory.h /
   // fallback_node_factory.h / node_factory_util.h
   using ::CreateDataVariables;
@@ -159,4 +185,9 @@ export {
   using ::FallbackNodeFactory;
   using ::NodeBuilderImpl;
   using ::NodeFactory;
+
+  // node_id_table.h
+  using ::kInvalidNodeHandle;
+  using ::NodeHandle;
+  using ::NodeIdTable;
 }  // export
@@ -0,0 +1,211 @@
+#include "address_space/snapshot_view_service.h"
+
+#include "address_space/address_space_snapshot.h"
+#include "address_space/node_browser.h"
+#include "base/range_util.h"
+#include "model/node_id_util.h"
+#include "scada/standard_node_ids.h"
+
+#include <optional>
+#include <ranges>
+#include <string_view>
+
+namespace {
+
+bool MatchesReferenceType(const scada::AddressSpaceSnapshot& snapshot,
+                          const scada::NodeSnapshot::Reference& reference,
+                          const scada::NodeId& reference_type_id,
+                          bool include_subtypes) {
+  return include_subtypes
+             ? snapshot.IsSubtypeOf(reference.reference_type_id,
+                                    reference_type_id)
+             : reference.reference_type_id == reference_type_id;
+}
+
+const scada::NodeSnapshot* FindChild(
+    const scada::AddressSpaceSnapshot& snapshot,
+    const scada::NodeSnapshot& parent,
+    std::string_view browse_name) {
+  for (const auto& reference : parent.forward_references) {
+    if (!snapshot.IsSubtypeOf(reference.reference_type_id,
+                              scada::id::HierarchicalReferences)) {
+      continue;
+    }
+    auto* child = snapshot.GetNode(reference.node_id);
+    if (child && child->browse_name.name() == browse_name)
+      return child;
+  }
+  return nullptr;
+}
+
+const scada::NodeSnapshot* FindChildDeclaration(
+    const scada::AddressSpaceSnapshot& snapshot,
+    const scada::NodeSnapshot& type,
+    std::string_view browse_name) {
+  for (auto* supertype = &type; supertype;
+       supertype = supertype->supertype_id.is_null()
+                       ? nullptr
+                       : snapshot.GetNode(supertype->supertype_id)) {
+    if (auto* declaration = FindChild(snapshot, *supertype, browse_name))
+      return declaration;
+  }
+  return nullptr;
+}
+
+// Same resolution as GetNestedNode() over the live address space.
+const scada::NodeSnapshot* GetNestedNode(
+    const scada::AddressSpaceSnapshot& snapshot,
+    const scada::NodeId& node_id,
+    std::string_view& nested_name) {
+  nested_name = {};
+
+  if (auto* node = snapshot.GetNode(node_id))
+    return node;
+
+  scada::NodeId parent_id;
+  if (!IsNestedNodeId(node_id, parent_id, nested_name))
+    parent_id = node_id;
+
+  auto* node = snapshot.GetNode(parent_id);
+  if (!node)
+    return nullptr;
+
+  while (!nested_name.empty()) {
+    auto p = nested_name.find('!');
+    if (p == std::string_view::npos)
+      p = nested_name.size();
+
+    auto* child = FindChild(snapshot, *node, nested_name.substr(0, p));
+    if (!child)
+      break;
+
+    node = child;
+    nested_name = p == nested_name.size() ? std::string_view{}
+                                          : nested_name.substr(p + 1);
+  }
+
+  return node;
+}
+
+// NodeBrowser access to one address-space snapshot.
+class SnapshotNodeAccessor {
+ public:
+  using Node = scada::NodeSnapshot;
+
+  explicit SnapshotNodeAccessor(const scada::AddressSpaceSnapshot& snapshot)
+      : snapshot_{snapshot} {}
+
+  const scada::NodeSnapshot* GetNode(const scada::NodeId& node_id) const {
+    return snapshot_.GetNode(node_id);
+  }
+
+  const scada::NodeSnapshot* GetNestedNode(
+      const scada::NodeId& node_id,
+      std::string_view& nested_name) const {
+    return ::GetNestedNode(snapshot_, node_id, nested_name);
+  }
+
+  auto MakeReferenceMatcher(const scada::NodeId& reference_type_id,
+                            bool include_subtypes) const {
+    return [this, reference_type_id,
+            include_subtypes](const scada::NodeSnapshot::Reference& reference) {
+      return MatchesReferenceType(snapshot_, reference, reference_type_id,
+                                  include_subtypes);
+    };
+  }
+
+  const auto& GetReferences(const scada::NodeSnapshot& node,
+                            bool forward) const {
+    return forward ? node.forward_references : node.inverse_references;
+  }
+
+  const scada::NodeSnapshot* GetTarget(
+      const scada::NodeSnapshot::Reference& reference) const {
+    return snapshot_.GetNode(reference.node_id);
+  }
+
+  scada::NodeId GetReferenceTypeId(
+      const scada::NodeSnapshot::Reference& reference) const {
+    return reference.reference_type_id;
+  }
+
+  scada::NodeId GetNodeId(const scada::NodeSnapshot& node) const {
+    return node.node_id;
+  }
+
+  scada::NodeClass GetNodeClass(const scada::NodeSnapshot& node) const {
+    return node.node_class;
+  }
+
+  scada::QualifiedName GetBrowseName(const scada::NodeSnapshot& node) const {
+    return node.browse_name;
+  }
+
+  scada::LocalizedText GetDisplayName(const scada::NodeSnapshot& node) const {
+    return node.display_name;
+  }
+
+  scada::NodeId GetTypeDefinitionId(const scada::NodeSnapshot& node) const {
+    return node.type_definition_id;
+  }
+
+  bool HasPropertyDeclaration(const scada::NodeSnapshot& node,
+                              std::string_view name) const {
+    auto* type_definition = node.type_definition_id.is_null()
+                                ? nullptr
+                                : snapshot_.GetNode(node.type_definition_id);
+    auto* declaration =
+        type_definition
+            ? FindChildDeclaration(snapshot_, *type_definition, name)
+            : nullptr;
+    return declaration && declaration->node_class == scada::NodeClass::Variable;
+  }
+
+  bool IsSubtypeOf(const scada::NodeId& type_id,
+                   const scada::NodeId& supertype_id) const {
+    return snapshot_.IsSubtypeOf(type_id, supertype_id);
+  }
+
+  // Snapshots keep no browse name index.
+  template <class Matcher>
+  std::optional<const scada::NodeSnapshot*> FindIndexedChild(
+      const scada::NodeSnapshot& node,
+      std::string_view name,
+      const Matcher&) const {
+    return std::nullopt;
+  }
+
+ private:
+  const scada::AddressSpaceSnapshot& snapshot_;
+};
+
+}  // namespace
+
+SnapshotViewService::SnapshotViewService(SnapshotViewServiceContext&& context)
+    : SnapshotViewServiceContext{std::move(context)} {}
+
+std::vector<scada::BrowseResult> SnapshotViewService::Browse(
+    std::span<const scada::BrowseDescription> inputs) {
+  const auto snapshot = snapshot_publisher_.snapshot();
+  const SnapshotNodeAccessor accessor{*snapshot};
+  const NodeBrowser browser{accessor};
+  return inputs |
+         std::views::transform(
+             [&browser](const scada::BrowseDescription& input) {
+               return browser.Browse(input);
+             }) |
+         to_vector;
+}
+
+std::vector<scada::BrowsePathResult> SnapshotViewService::TranslateBrowsePaths(
+    std::span<const scada::BrowsePath> inputs) {
+  const auto snapshot = snapshot_publisher_.snapshot();
+  const SnapshotNodeAccessor accessor{*snapshot};
+  NodeBrowser browser{accessor};
+  return inputs |
+         std::views::transform([&browser](const scada::BrowsePath& input) {
+           return browser.Translate(input);
+         }) |
+         to_vector;
+}
+
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "common/sync_view_service.h"
+#include "scada/view_service.h"
+
+#include <span>
+
+class AddressSpaceSnapshotPublisher;
+
+struct SnapshotViewServiceContext {
+  const AddressSpaceSnapshotPublisher& snapshot_publisher_;
+};
+
+// SyncViewService answering from published address-space snapshots. Safe to
+// call from any thread, concurrently: each call pins the latest snapshot and
+// answers all its inputs from that one version.
+class SnapshotViewService : private SnapshotViewServiceContext,
+                            public SyncViewService {
+ public:
+  explicit SnapshotViewService(SnapshotViewServiceContext&& context);
+
+  // SyncViewService
+  virtual std::vector<scada::BrowseResult> Browse(
+      std::span<const scada::BrowseDescription> inputs) override;
+  virtual std::vector<scada::BrowsePathResult> TranslateBrowsePaths(
+      std::span<const scada::BrowsePath> inputs) override;
+};
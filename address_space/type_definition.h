@@ -5,10 +5,13 @@
 #include "base/lifetime.h"
 #include "scada/variant.h"
 
+#include <cstdint>
 #include <optional>
 
 namespace scada {
 
+class TypeHierarchyIndex;
+
 class TypeDefinition : public Node {
  public:
   TypeDefinition();
@@ -16,6 +19,9 @@ class TypeDefinition : public Node {
   TypeDefinition* supertype() { return supertype_; }
   const TypeDefinition* supertype() const { return supertype_; }
 
+  // The index of the address space this type is registered in, if any.
+  const TypeHierarchyIndex* hierarchy_index() const { return hierarchy_index_; }
+
   virtual void AddReference(const ReferenceType& reference_type,
                             bool forward,
                             Node& node) override;
@@ -24,7 +30,16 @@ class TypeDefinition : public Node {
                                Node& node) override;
 
  private:
+  friend class TypeHierarchyIndex;
+
   TypeDefinition* supertype_ = nullptr;
+
+  // Maintained by |hierarchy_index_|.
+  TypeHierarchyIndex* hierarchy_index_ = nullptr;
+  uint32_t hierarchy_ordinal_ = 0;
+  // Pre-order number and one past the number of the last subtype.
+  mutable uint32_t hierarchy_begin_ = 0;
+  mutable uint32_t hierarchy_end_ = 0;
 };
 
 class DataType : public TypeDefinition {
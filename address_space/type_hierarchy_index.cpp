@@ -0,0 +1,161 @@
+#include "address_space/type_hierarchy_index.h"
+
+#include "address_space/type_definition.h"
+#include "base/check.h"
+
+namespace scada {
+
+TypeHierarchyIndex::~TypeHierarchyIndex() {
+  Clear();
+}
+
+void TypeHierarchyIndex::AddType(TypeDefinition& type) {
+  base::Check(!type.hierarchy_index_);
+
+  type.hierarchy_index_ = this;
+  type.hierarchy_ordinal_ = static_cast<uint32_t>(types_.size());
+  types_.push_back(&type);
+  types_by_id_.insert_or_assign(type.id(), &type);
+  Invalidate();
+}
+
+void TypeHierarchyIndex::RemoveType(TypeDefinition& type) {
+  base::Check(type.hierarchy_index_ == this);
+
+  auto* last = types_.back();
+  types_[type.hierarchy_ordinal_] = last;
+  last->hierarchy_ordinal_ = type.hierarchy_ordinal_;
+  types_.pop_back();
+
+  if (auto i = types_by_id_.find(type.id());
+      i != types_by_id_.end() && i->second == &type) {
+    types_by_id_.erase(i);
+  }
+
+  type.hierarchy_index_ = nullptr;
+  Invalidate();
+}
+
+void TypeHierarchyIndex::Clear() {
+  for (auto* type : types_)
+    type->hierarchy_index_ = nullptr;
+  types_.clear();
+  types_by_id_.clear();
+  Invalidate();
+}
+
+void TypeHierarchyIndex::Invalidate() {
+  numbered_ = false;
+  if (!updating_)
+    Renumber();
+}
+
+void TypeHierarchyIndex::BeginUpdate() {
+  base::Check(!updating_);
+  updating_ = true;
+}
+
+void TypeHierarchyIndex::EndUpdate() {
+  base::Check(updating_);
+  updating_ = false;
+  if (!numbered_)
+    Renumber();
+}
+
+const TypeDefinition* TypeHierarchyIndex::FindType(
+    const NodeId& type_id) const {
+  auto i = types_by_id_.find(type_id);
+  return i != types_by_id_.end() ? i->second : nullptr;
+}
+
+bool TypeHierarchyIndex::IsSubtypeOf(const TypeDefinition& type,
+                                     const TypeDefinition& supertype) const {
+  if (!numbered_ || has_foreign_links_) {
+    for (auto* t = &type; t; t = t->supertype()) {
+      if (t == &supertype)
+        return true;
+    }
+    return false;
+  }
+
+  return supertype.hierarchy_begin_ <= type.hierarchy_begin_ &&
+         type.hierarchy_begin_ < supertype.hierarchy_end_;
+}
+
+void TypeHierarchyIndex::Renumber() {
+  const auto count = static_cast<uint32_t>(types_.size());
+  constexpr auto kNoParent = UINT32_MAX;
+
+  has_foreign_links_ = false;
+
+  // Subtype lists in one buffer, indexed by the supertype ordinal.
+  std::vector<uint32_t> parents(count, kNoParent);
+  std::vector<uint32_t> child_offsets(count + 1, 0);
+  for (uint32_t i = 0; i < count; ++i) {
+    const auto* supertype = types_[i]->supertype();
+    if (!supertype)
+      continue;
+
+    if (supertype->hierarchy_index_ == this) {
+      parents[i] = supertype->hierarchy_ordinal_;
+      ++child_offsets[parents[i] + 1];
+      continue;
+    }
+
+    for (auto* t = supertype; t; t = t->supertype()) {
+      if (t->hierarchy_index_ == this) {
+        has_foreign_links_ = true;
+        break;
+      }
+    }
+  }
+
+  for (uint32_t i = 0; i < count; ++i)
+    child_offsets[i + 1] += child_offsets[i];
+
+  std::vector<uint32_t> children(child_offsets[count]);
+  {
+    auto next = child_offsets;
+    for (uint32_t i = 0; i < count; ++i) {
+      if (parents[i] != kNoParent)
+        children[next[parents[i]]++] = i;
+    }
+  }
+
+  // Depth-first from every root, without recursion: deep hierarchies are
+  // common in configuration models.
+  struct Frame {
+    uint32_t ordinal;
+    uint32_t next_child;
+  };
+  std::vector<Frame> stack;
+  uint32_t number = 0;
+  for (uint32_t root = 0; root < count; ++root) {
+    if (parents[root] != kNoParent)
+      continue;
+
+    types_[root]->hierarchy_begin_ = number++;
+    stack.push_back({root, child_offsets[root]});
+    while (!stack.empty()) {
+      auto& frame = stack.back();
+      if (frame.next_child == child_offsets[frame.ordinal + 1]) {
+        types_[frame.ordinal]->hierarchy_end_ = number;
+        stack.pop_back();
+        continue;
+      }
+      const auto child = children[frame.next_child++];
+      types_[child]->hierarchy_begin_ = number++;
+      stack.push_back({child, child_offsets[child]});
+    }
+  }
+
+  // A supertype cycle leaves types without a root; only the walk can answer
+  // for them.
+  if (number != count)
+    has_foreign_links_ = true;
+
+  numbered_ = true;
+  ++renumber_count_;
+}
+
+}  // namespace scada
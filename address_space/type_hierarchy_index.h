@@ -0,0 +1,79 @@
+#pragma once
+
+#include "scada/node_id.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace scada {
+
+class TypeDefinition;
+
+// Answers IsSubtypeOf in constant time for the type definitions of one
+// address space.
+//
+// Types are numbered in pre-order over the HasSubtype forest; each type keeps
+// its own number and one past the number of its last subtype, so |type| is a
+// subtype of |supertype| exactly when its number falls in the supertype's
+// range. The ranges are stored on the TypeDefinition nodes themselves, so a
+// check never hashes or compares NodeIds.
+//
+// Adding, removing or re-parenting a type renumbers all types in a single
+// pass. Between BeginUpdate() and EndUpdate(), e.g. over a bulk load, the
+// numbering is left stale and renumbered once at the end; queries walk the
+// supertype chain meanwhile.
+//
+// Queries only read the index, so any number of threads may query it at once.
+// Mutations need exclusive access, as for the address space that owns it.
+class TypeHierarchyIndex {
+ public:
+  TypeHierarchyIndex() = default;
+  // Detaches all registered types.
+  ~TypeHierarchyIndex();
+
+  // Registered types refer back to the index; it's neither copied nor moved.
+  TypeHierarchyIndex(const TypeHierarchyIndex&) = delete;
+  TypeHierarchyIndex& operator=(const TypeHierarchyIndex&) = delete;
+
+  size_t size() const { return types_.size(); }
+
+  void AddType(TypeDefinition& type);
+  void RemoveType(TypeDefinition& type);
+  void Clear();
+
+  // Call when a HasSubtype reference between registered types changes.
+  void Invalidate();
+
+  // Defers renumbering until EndUpdate(). Updates don't nest.
+  void BeginUpdate();
+  void EndUpdate();
+
+  // Null if no registered type has |type_id|.
+  const TypeDefinition* FindType(const NodeId& type_id) const;
+
+  // Both types must be registered in this index.
+  bool IsSubtypeOf(const TypeDefinition& type,
+                   const TypeDefinition& supertype) const;
+
+  // Number of renumbering passes so far. Diagnostics and tests.
+  uint64_t renumber_count() const { return renumber_count_; }
+
+ private:
+  void Renumber();
+
+  // Dense; a removed type is replaced by the last one.
+  std::vector<TypeDefinition*> types_;
+  std::unordered_map<NodeId, TypeDefinition*> types_by_id_;
+
+  bool updating_ = false;
+  bool numbered_ = false;
+  // Some registered type reaches another one through a supertype that isn't
+  // registered, e.g. one that lives in a parent address space. The ranges
+  // can't see such paths, so queries walk the supertype chain instead.
+  bool has_foreign_links_ = false;
+  uint64_t renumber_count_ = 0;
+};
+
+}  // namespace scada
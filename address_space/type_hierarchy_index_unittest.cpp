@@ -0,0 +1,145 @@
+#include "address_space/type_hierarchy_index.h"
+
+#include "address_space/address_space_util.h"
+#include "address_space/node_utils.h"
+#include "address_space/test/test_address_space.h"
+#include "address_space/type_definition.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+namespace {
+
+// Reference answer: the supertype chain walk the index replaces.
+bool WalkIsSubtypeOf(const scada::TypeDefinition& type,
+                     const scada::TypeDefinition& supertype) {
+  for (auto* t = &type; t; t = t->supertype()) {
+    if (t == &supertype)
+      return true;
+  }
+  return false;
+}
+
+class TypeHierarchyIndexTest : public testing::Test {
+ protected:
+  std::vector<const scada::TypeDefinition*> GetTypes() const {
+    std::vector<const scada::TypeDefinition*> types;
+    for (auto [node_id, node] : address_space_.node_map()) {
+      if (auto* type = scada::AsTypeDefinition(node))
+        types.push_back(type);
+    }
+    return types;
+  }
+
+  void ExpectMatchesWalk() const {
+    const auto types = GetTypes();
+    for (auto* type : types) {
+      EXPECT_EQ(type->hierarchy_index(), &address_space_.type_hierarchy());
+      for (auto* supertype : types) {
+        EXPECT_EQ(scada::IsSubtypeOf(*type, *supertype),
+                  WalkIsSubtypeOf(*type, *supertype));
+      }
+    }
+  }
+
+  scada::ObjectType& AddObjectType(const scada::NodeId& type_id,
+                                   const scada::NodeId& supertype_id) {
+    auto& type = address_space_.AddStaticNode<scada::ObjectType>(
+        type_id, scada::QualifiedName{"Type"}, scada::LocalizedText{u"Type"});
+    scada::AddReference(address_space_, scada::id::HasSubtype, supertype_id,
+                        type_id);
+    return type;
+  }
+
+  TestAddressSpace address_space_;
+};
+
+}  // namespace
+
+TEST_F(TypeHierarchyIndexTest, MatchesSupertypeWalk) {
+  ASSERT_GT(address_space_.type_hierarchy().size(), 0u);
+  ExpectMatchesWalk();
+  EXPECT_GT(address_space_.type_hierarchy().renumber_count(), 0u);
+
+  EXPECT_TRUE(scada::IsSubtypeOf(
+      scada::AsTypeDefinition(*address_space_.GetNode(scada::id::Organizes)),
+      scada::id::HierarchicalReferences));
+  EXPECT_FALSE(scada::IsSubtypeOf(
+      scada::AsTypeDefinition(*address_space_.GetNode(scada::id::HasProperty)),
+      scada::id::HierarchicalReferences));
+}
+
+TEST_F(TypeHierarchyIndexTest, TracksAddedAndDeletedTypes) {
+  const scada::NodeId type1_id{1001, TestAddressSpace::kNamespaceIndex};
+  const scada::NodeId type2_id{1002, TestAddressSpace::kNamespaceIndex};
+
+  AddObjectType(type1_id, address_space_.kTestTypeId);
+  AddObjectType(type2_id, type1_id);
+  ExpectMatchesWalk();
+  EXPECT_TRUE(
+      scada::IsSubtypeOf(address_space_, type2_id, scada::id::BaseObjectType));
+  EXPECT_TRUE(scada::IsSubtypeOf(address_space_, type2_id,
+                                 address_space_.kTestTypeId));
+  EXPECT_FALSE(scada::IsSubtypeOf(address_space_, type1_id, type2_id));
+
+  address_space_.DeleteNode(type2_id);
+  ExpectMatchesWalk();
+  EXPECT_FALSE(scada::IsSubtypeOf(address_space_, type2_id, type1_id));
+}
+
+TEST_F(TypeHierarchyIndexTest, TracksReparentedType) {
+  const scada::NodeId type_id{1001, TestAddressSpace::kNamespaceIndex};
+
+  AddObjectType(type_id, address_space_.kTestTypeId);
+  EXPECT_TRUE(scada::IsSubtypeOf(address_space_, type_id,
+                                 address_space_.kTestTypeId));
+
+  scada::DeleteReference(address_space_, scada::id::HasSubtype,
+                         address_space_.kTestTypeId, type_id);
+  scada::AddReference(address_space_, scada::id::HasSubtype,
+                      scada::id::FolderType, type_id);
+
+  ExpectMatchesWalk();
+  EXPECT_FALSE(scada::IsSubtypeOf(address_space_, type_id,
+                                  address_space_.kTestTypeId));
+  EXPECT_TRUE(
+      scada::IsSubtypeOf(address_space_, type_id, scada::id::FolderType));
+}
+
+// Queries don't touch the numbering; each type addition outside a bulk load
+// renumbers right away.
+TEST_F(TypeHierarchyIndexTest, RenumbersOnMutation) {
+  const auto& index = address_space_.type_hierarchy();
+  const auto& type = scada::AsTypeDefinition(
+      *address_space_.GetNode(address_space_.kTestTypeId));
+  const auto& base_type = scada::AsTypeDefinition(
+      *address_space_.GetNode(scada::id::BaseObjectType));
+
+  const auto renumber_count = index.renumber_count();
+  for (size_t i = 0; i < 2 * index.size(); ++i)
+    EXPECT_TRUE(scada::IsSubtypeOf(type, base_type));
+  EXPECT_EQ(index.renumber_count(), renumber_count);
+
+  AddObjectType(scada::NodeId{2000, TestAddressSpace::kNamespaceIndex},
+                address_space_.kTestTypeId);
+  EXPECT_GT(index.renumber_count(), renumber_count);
+  ExpectMatchesWalk();
+}
+
+// A bulk load renumbers once, when it ends.
+TEST_F(TypeHierarchyIndexTest, RenumbersOncePerBulkLoad) {
+  const auto& index = address_space_.type_hierarchy();
+
+  const auto renumber_count = index.renumber_count();
+  {
+    MutableAddressSpace::BulkLoad bulk_load{address_space_, 100};
+    for (unsigned i = 0; i < 100; ++i) {
+      AddObjectType(scada::NodeId{2000 + i, TestAddressSpace::kNamespaceIndex},
+                    address_space_.kTestTypeId);
+    }
+    EXPECT_EQ(index.renumber_count(), renumber_count);
+    ExpectMatchesWalk();
+  }
+  EXPECT_EQ(index.renumber_count(), renumber_count + 1);
+  ExpectMatchesWalk();
+}
@@ -2,210 +2,140 @@
 
 #include "address_space/address_space.h"
 #include "address_space/address_space_util.h"
+#include "address_space/child_name_index.h"
+#include "address_space/node_browser.h"
 #include "address_space/node_utils.h"
 #include "address_space/type_definition.h"
 #include "base/range_util.h"
 #include "model/node_id_util.h"
 #include "model/scada_node_ids.h"
 
+#include <optional>
 #include <ranges>
+#include <string_view>
 
 namespace {
 
-const scada::Node* TranslateBrowsePathHelper2(
-    const scada::Node& node,
-    const scada::RelativePathElement& element) {
-  const auto& references =
-      element.inverse ? node.inverse_references() : node.forward_references();
-  std::vector<scada::Node*> result;
-  for (const auto& ref : scada::FilterReferences(
-           references, element.reference_type_id, element.include_subtypes)) {
-    // TODO: Compare namespace indexes.
-    if (ref.node->GetBrowseName().name() == element.target_name.name())
-      return ref.node;
-  }
-  return nullptr;
-}
+// NodeBrowser access to the live address space.
+class AddressSpaceNodeAccessor {
+ public:
+  using Node = scada::Node;
 
-scada::BrowsePathResult TranslateBrowsePathHelper(
-    const scada::Node& node,
-    const scada::RelativePath& relative_path) {
-  if (relative_path.empty())
-    return {scada::StatusCode::Bad_NothingToDo, {}};
-
-  auto* current_node = TranslateBrowsePathHelper2(node, relative_path[0]);
-  if (!current_node)
-    return {scada::StatusCode::Bad_BrowseNameInvalid};
-
-  size_t i = 1;
-  for (; i < relative_path.size(); ++i) {
-    auto* next_node =
-        TranslateBrowsePathHelper2(*current_node, relative_path[i]);
-    if (!next_node)
-      break;
-    current_node = next_node;
-  }
+  explicit AddressSpaceNodeAccessor(const scada::AddressSpace& address_space)
+      : address_space_{address_space} {}
 
-  return {scada::StatusCode::Good, {{current_node->id(), i}}};
-}
+  const scada::Node* GetNode(const scada::NodeId& node_id) const {
+    return address_space_.GetNode(node_id);
+  }
 
-}  // namespace
+  const scada::Node* GetNestedNode(const scada::NodeId& node_id,
+                                   std::string_view& nested_name) const {
+    return scada::GetNestedNode(address_space_, node_id, nested_name);
+  }
 
-// SyncViewServiceImpl
+  scada::IsRefSubtypeOf MakeReferenceMatcher(
+      const scada::NodeId& reference_type_id,
+      bool include_subtypes) const {
+    // Resolved once, so each reference is matched by its type's hierarchy
+    // range.
+    return {reference_type_id, include_subtypes,
+            scada::AsTypeDefinition(address_space_.GetNode(reference_type_id))};
+  }
 
-SyncViewServiceImpl::SyncViewServiceImpl(ViewServiceImplContext&& context)
-    : ViewServiceImplContext{std::move(context)} {}
+  const scada::References& GetReferences(const scada::Node& node,
+                                         bool forward) const {
+    return forward ? node.forward_references() : node.inverse_references();
+  }
 
-ViewServiceImpl::ViewServiceImpl(SyncViewService& sync_view_service)
-    : sync_view_service_{sync_view_service} {}
+  const scada::Node* GetTarget(const scada::Reference& reference) const {
+    return reference.node;
+  }
 
-std::vector<scada::BrowseResult> SyncViewServiceImpl::Browse(
-    std::span<const scada::BrowseDescription> inputs) {
-  return inputs |
-         std::views::transform([this](const scada::BrowseDescription& input) {
-           return BrowseOne(input);
-         }) |
-         to_vector;
-}
+  scada::NodeId GetReferenceTypeId(const scada::Reference& reference) const {
+    return reference.type->id();
+  }
 
-scada::BrowseResult SyncViewServiceImpl::BrowseOne(
-    const scada::BrowseDescription& input) {
-  std::string_view nested_name;
-  auto* node = GetNestedNode(address_space_, input.node_id, nested_name);
-  if (!node)
-    return {scada::StatusCode::Bad_WrongNodeId};
+  scada::NodeId GetNodeId(const scada::Node& node) const { return node.id(); }
 
-  if (nested_name.empty())
-    return BrowseNode(*node, input);
+  scada::NodeClass GetNodeClass(const scada::Node& node) const {
+    return node.GetNodeClass();
+  }
 
-  return BrowseProperty(*node, nested_name, input);
-}
+  scada::QualifiedName GetBrowseName(const scada::Node& node) const {
+    return node.GetBrowseName();
+  }
 
-std::vector<scada::BrowsePathResult> SyncViewServiceImpl::TranslateBrowsePaths(
-    std::span<const scada::BrowsePath> inputs) {
-  return inputs | std::views::transform([this](const scada::BrowsePath& input) {
-           return TranslateBrowsePath(input);
-         }) |
-         to_vector;
-}
+  scada::LocalizedText GetDisplayName(const scada::Node& node) const {
+    return node.GetDisplayName();
+  }
 
-scada::BrowsePathResult SyncViewServiceImpl::TranslateBrowsePath(
-    const scada::BrowsePath& input) {
-  auto* node = address_space_.GetNode(input.node_id);
-  if (!node)
-    return {scada::StatusCode::Bad_WrongNodeId};
+  scada::NodeId GetTypeDefinitionId(const scada::Node& node) const {
+    auto* type_definition = node.type_definition();
+    return type_definition ? type_definition->id() : scada::NodeId{};
+  }
 
-  return TranslateBrowsePathHelper(*node, input.relative_path);
-}
+  bool HasPropertyDeclaration(const scada::Node& node,
+                              std::string_view name) const {
+    auto* type_definition = node.type_definition();
+    return type_definition &&
+           scada::AsVariable(
+               scada::FindChildDeclaration(*type_definition, name));
+  }
 
-scada::BrowseResult SyncViewServiceImpl::BrowseNode(
-    const scada::Node& node,
-    const scada::BrowseDescription& description) {
-  scada::BrowseResult result;
-  result.status_code = scada::StatusCode::Good;
-
-  // OPC UA Part 4 §7.3: nodeClassMask filters returned references by the target
-  // node's NodeClass (0 = any).
-  // https://reference.opcfoundation.org/Core/Part4/v105/docs/7.3
-  const auto matches_node_class = [&](scada::NodeClass node_class) {
-    return description.node_class_mask == 0 ||
-           (description.node_class_mask &
-            static_cast<scada::UInt32>(node_class)) != 0;
-  };
-
-  // OPC UA Part 4 §7.3: resultMask selects which ReferenceDescription fields to
-  // populate; unrequested fields stay at their defaults.
-  const auto mask = description.result_mask;
-  const auto make_reference = [&](const auto& ref, bool forward) {
-    scada::ReferenceDescription desc;
-    if (mask & scada::kBrowseResultReferenceType)
-      desc.reference_type_id = ref.type->id();
-    desc.forward = (mask & scada::kBrowseResultIsForward) ? forward : false;
-    desc.node_id = ref.node->id();
-    if (mask & scada::kBrowseResultNodeClass)
-      desc.node_class = ref.node->GetNodeClass();
-    if (mask & scada::kBrowseResultBrowseName)
-      desc.browse_name = ref.node->GetBrowseName();
-    if (mask & scada::kBrowseResultDisplayName)
-      desc.display_name = ref.node->GetDisplayName();
-    if ((mask & scada::kBrowseResultTypeDefinition) &&
-        ref.node->type_definition()) {
-      desc.type_definition = ref.node->type_definition()->id();
-    }
-    return desc;
-  };
-
-  if (description.direction == scada::BrowseDirection::Forward ||
-      description.direction == scada::BrowseDirection::Both) {
-    for (const auto& ref : scada::FilterReferences(
-             node.forward_references(), description.reference_type_id,
-             description.include_subtypes)) {
-      // Skip references to targets not present in the address space rather than
-      // dereferencing a null node.
-      if (!ref.node)
-        continue;
-      if (!matches_node_class(ref.node->GetNodeClass()))
-        continue;
-      result.references.push_back(make_reference(ref, true));
-    }
+  bool IsSubtypeOf(const scada::NodeId& type_id,
+                   const scada::NodeId& supertype_id) const {
+    return scada::IsSubtypeOf(address_space_, type_id, supertype_id);
   }
 
-  if (description.direction == scada::BrowseDirection::Inverse ||
-      description.direction == scada::BrowseDirection::Both) {
-    for (const auto& ref : scada::FilterReferences(
-             node.inverse_references(), description.reference_type_id,
-             description.include_subtypes)) {
-      if (!ref.node)
-        continue;
-      if (!matches_node_class(ref.node->GetNodeClass()))
-        continue;
-      result.references.push_back(make_reference(ref, false));
+  std::optional<const scada::Node*> FindIndexedChild(
+      const scada::Node& node,
+      std::string_view name,
+      const scada::IsRefSubtypeOf& matches_type) const {
+    const auto* index = node.child_name_index();
+    if (!index)
+      return std::nullopt;
+    for (const auto& ref : index->Find(name)) {
+      if (matches_type(ref))
+        return ref.node;
     }
+    return nullptr;
   }
 
-  return result;
-}
+ private:
+  const scada::AddressSpace& address_space_;
+};
 
-scada::BrowseResult SyncViewServiceImpl::BrowseProperty(
-    const scada::Node& node,
-    std::string_view nested_name,
-    const scada::BrowseDescription& description) {
-  scada::BrowseResult result;
+}  // namespace
 
-  if (!description.include_subtypes) {
-    // Browse descriptions arrive in service requests (external input).
-    result.status_code = scada::StatusCode::Bad;
-    return result;
-  }
+// SyncViewServiceImpl
 
-  auto* type_definition = node.type_definition();
-  auto* prop_decl = type_definition
-                        ? scada::AsVariable(scada::FindChildDeclaration(
-                              *type_definition, nested_name))
-                        : nullptr;
-  if (!prop_decl) {
-    result.status_code = scada::StatusCode::Bad_WrongNodeId;
-    return result;
-  }
+SyncViewServiceImpl::SyncViewServiceImpl(ViewServiceImplContext&& context)
+    : ViewServiceImplContext{std::move(context)} {}
 
-  if (description.direction == scada::BrowseDirection::Forward ||
-      description.direction == scada::BrowseDirection::Both) {
-    if (scada::IsSubtypeOf(address_space_, scada::id::HasTypeDefinition,
-                           description.reference_type_id))
-      result.references.emplace_back(scada::id::HasTypeDefinition,
-                                     /*forward=*/true, scada::id::PropertyType,
-                                     scada::NodeClass::VariableType);
-  }
+ViewServiceImpl::ViewServiceImpl(SyncViewService& sync_view_service)
+    : sync_view_service_{sync_view_service} {}
 
-  if (description.direction == scada::BrowseDirection::Inverse ||
-      description.direction == scada::BrowseDirection::Both) {
-    if (scada::IsSubtypeOf(address_space_, scada::id::HasProperty,
-                           description.reference_type_id))
-      result.references.emplace_back(scada::id::HasProperty, /*forward=*/false,
-                                     node.id(), node.GetNodeClass());
-  }
+std::vector<scada::BrowseResult> SyncViewServiceImpl::Browse(
+    std::span<const scada::BrowseDescription> inputs) {
+  const AddressSpaceNodeAccessor accessor{address_space_};
+  const NodeBrowser browser{accessor};
+  return inputs |
+         std::views::transform(
+             [&browser](const scada::BrowseDescription& input) {
+               return browser.Browse(input);
+             }) |
+         to_vector;
+}
 
-  return result;
+std::vector<scada::BrowsePathResult> SyncViewServiceImpl::TranslateBrowsePaths(
+    std::span<const scada::BrowsePath> inputs) {
+  const AddressSpaceNodeAccessor accessor{address_space_};
+  NodeBrowser browser{accessor};
+  return inputs |
+         std::views::transform([&browser](const scada::BrowsePath& input) {
+           return browser.Translate(input);
+         }) |
+         to_vector;
 }
 
 Awaitable<scada::StatusOr<std::vector<scada::BrowseResult>>>
@@ -8,7 +8,6 @@
 
 namespace scada {
 class AddressSpace;
-class Node;
 }  // namespace scada
 
 struct ViewServiceImplContext {
@@ -25,17 +24,6 @@ class SyncViewServiceImpl : private ViewServiceImplContext,
       std::span<const scada::BrowseDescription> inputs) override;
   virtual std::vector<scada::BrowsePathResult> TranslateBrowsePaths(
       std::span<const scada::BrowsePath> inputs) override;
-
- private:
-  scada::BrowseResult BrowseOne(const scada::BrowseDescription& inputs);
-  scada::BrowseResult BrowseNode(const scada::Node& node,
-                                 const scada::BrowseDescription& description);
-  scada::BrowseResult BrowseProperty(
-      const scada::Node& node,
-      std::string_view nested_name,
-      const scada::BrowseDescription& description);
-
-  scada::BrowsePathResult TranslateBrowsePath(const scada::BrowsePath& input);
 };
 
 class ViewServiceImpl : public scada::ViewService {
@@ -3,6 +3,7 @@
 #include "address_space/address_space_impl.h"
 #include "address_space/address_space_type_system.h"
 #include "address_space/address_space_util.h"
+#include "address_space/child_name_index.h"
 #include "address_space/node_utils.h"
 #include "address_space/object.h"
 #include "address_space/standard_address_space.h"
@@ -18,6 +19,9 @@
 
 #include <gmock/gmock.h>
 
+#include <string>
+#include <string_view>
+
 namespace {
 
 class VirtualObject : public scada::GenericObject,
@@ -335,3 +339,73 @@ TEST(ViewServiceImpl, BrowseChildParent) {
   EXPECT_EQ(reference.reference_type_id,
             scada::NodeId{scada::id::HasComponent});
 }
+
+// Folders with many children resolve path elements through the child name
+// index, which must follow children being added, renamed and deleted.
+TEST(ViewServiceImpl, TranslateBrowsePathsThroughIndexedChildren) {
+  TestAddressSpace address_space;
+
+  const scada::NodeId kFolderId{1000, TestAddressSpace::kNamespaceIndex};
+  const auto make_child_id = [](unsigned index) {
+    return scada::NodeId{1001 + index, TestAddressSpace::kNamespaceIndex};
+  };
+  constexpr unsigned kChildCount =
+      2 * scada::ChildNameIndex::kMinReferenceCount;
+
+  address_space.CreateNode({kFolderId, scada::NodeClass::Object,
+                            scada::id::FolderType, scada::id::RootFolder,
+                            scada::id::Organizes,
+                            scada::NodeAttributes{}.set_browse_name("Folder")});
+  for (unsigned i = 0; i < kChildCount; ++i) {
+    address_space.CreateNode(
+        {make_child_id(i), scada::NodeClass::Object, scada::id::BaseObjectType,
+         kFolderId, scada::id::Organizes,
+         scada::NodeAttributes{}.set_browse_name("Child" + std::to_string(i))});
+  }
+  ASSERT_TRUE(address_space.GetNode(kFolderId)->child_name_index());
+
+  const auto make_path = [](std::string_view child_name,
+                            scada::NodeId reference_type_id =
+                                scada::id::HierarchicalReferences) {
+    return scada::BrowsePath{
+        .node_id = scada::id::RootFolder,
+        .relative_path = {
+            {.reference_type_id = scada::id::Organizes,
+             .target_name = scada::QualifiedName{"Folder"}},
+            {.reference_type_id = reference_type_id,
+             .include_subtypes = true,
+             .target_name = scada::QualifiedName{std::string{child_name}}}}};
+  };
+  const auto translate = [&](std::vector<scada::BrowsePath> inputs) {
+    std::vector<scada::NodeId> targets;
+    for (const auto& result :
+         address_space.sync_view_service_impl.TranslateBrowsePaths(inputs)) {
+      EXPECT_EQ(result.status_code, scada::StatusCode::Good);
+      targets.push_back(result.targets.empty()
+                            ? scada::NodeId{}
+                            : result.targets[0].target_id.node_id());
+    }
+    return targets;
+  };
+
+  // One batch sharing the "Folder" step; unresolved elements stop at it.
+  EXPECT_THAT(translate({make_path("Child5"), make_path("Child31"),
+                         make_path("Missing"),
+                         make_path("Child5", scada::id::HasComponent)}),
+              testing::ElementsAre(make_child_id(5), make_child_id(31),
+                                   kFolderId, kFolderId));
+
+  address_space.ModifyNode(make_child_id(5),
+                           scada::NodeAttributes{}.set_browse_name("Renamed"),
+                           {});
+  address_space.DeleteNode(make_child_id(6));
+  address_space.CreateNode(
+      {make_child_id(kChildCount), scada::NodeClass::Object,
+       scada::id::BaseObjectType, kFolderId, scada::id::Organizes,
+       scada::NodeAttributes{}.set_browse_name("Added")});
+
+  EXPECT_THAT(translate({make_path("Renamed"), make_path("Child5"),
+                         make_path("Child6"), make_path("Added")}),
+              testing::ElementsAre(make_child_id(5), kFolderId, kFolderId,
+                                   make_child_id(kChildCount)));
+}
@@ -126,7 +126,7 @@ std::map<NodeId, AggregatorFactory> BuildAggregatorFactoryMap() {
   aggregators.emplace(
       id::AggregateFunction_Maximum,
       [](const DateTimeRange& interval, bool forward) {
-        auto max_value = std::numeric_limits<Double>::min();
+        auto max_value = std::numeric_limits<Double>::lowest();
         return
             [interval, max_value](std::span<const DataValue> values) mutable {
               auto& data_value = *std::max_element(values.begin(), values.end(),
@@ -155,11 +155,53 @@ std::map<NodeId, AggregatorFactory> BuildAggregatorFactoryMap() {
 }
 
 AggregatorFactory GetAggregatorFactory(const NodeId& aggregate_type) {
-  const auto kAggregators = BuildAggregatorFactoryMap();
+  static const auto kAggregators = BuildAggregatorFactoryMap();
   auto i = kAggregators.find(aggregate_type);
   return i != kAggregators.end() ? i->second : nullptr;
 }
 
+// The aggregates AggregateState computes with the columnar kernels.
+bool IsNumericAggregate(const NodeId& aggregate_type) {
+  return aggregate_type == id::AggregateFunction_Total ||
+         aggregate_type == id::AggregateFunction_Average ||
+         aggregate_type == id::AggregateFunction_Count ||
+         aggregate_type == id::AggregateFunction_Minimum ||
+         aggregate_type == id::AggregateFunction_Maximum ||
+         aggregate_type == id::AggregateFunction_Start ||
+         aggregate_type == id::AggregateFunction_End;
+}
+
+// Produces the same values as the matching `Aggregator` would for the samples
+// folded into `numeric`.
+DataValue MakeNumericAggregateValue(const NodeId& aggregate_type,
+                                    const DateTimeRange& interval,
+                                    const NumericAggregateAccumulator& numeric) {
+  if (aggregate_type == id::AggregateFunction_Total)
+    return DataValue{numeric.total, {}, interval.first, interval.second};
+  if (aggregate_type == id::AggregateFunction_Average) {
+    base::Check(numeric.count != 0);
+    return DataValue{numeric.total / numeric.count, {}, interval.first,
+                     interval.second};
+  }
+  if (aggregate_type == id::AggregateFunction_Count) {
+    return DataValue{static_cast<UInt64>(numeric.count), {}, interval.first,
+                     interval.second};
+  }
+  if (aggregate_type == id::AggregateFunction_Minimum) {
+    return DataValue{numeric.min, numeric.min_qualifier, interval.first,
+                     interval.second};
+  }
+  if (aggregate_type == id::AggregateFunction_Maximum) {
+    return DataValue{numeric.max, numeric.max_qualifier, interval.first,
+                     interval.second};
+  }
+  const auto& source = aggregate_type == id::AggregateFunction_Start
+                           ? numeric.start
+                           : numeric.end;
+  return DataValue{source.value, source.qualifier, interval.first,
+                   interval.second};
+}
+
 }  // namespace
 
 Aggregator GetAggregator(const NodeId& aggregate_type,
@@ -193,6 +235,11 @@ DateTimeRange GetAggregateInterval(DateTime time,
 }
 
 void AggregateState::Process(std::span<const scada::DataValue> raw_span) {
+  if (forward && IsNumericAggregate(aggregation.aggregate_type)) {
+    ProcessNumeric(raw_span);
+    return;
+  }
+
   while (!raw_span.empty()) {
     auto interval = scada::GetAggregateInterval(raw_span[0].source_timestamp,
                                                 aggregation.start_time,
@@ -220,6 +267,58 @@ void AggregateState::Process(std::span<const scada::DataValue> raw_span) {
   }
 }
 
+void AggregateState::ProcessNumeric(
+    std::span<const scada::DataValue> raw_span) {
+  timestamp_column.clear();
+  value_column.clear();
+  timestamp_column.reserve(raw_span.size());
+  value_column.reserve(raw_span.size());
+  for (const auto& data_value : raw_span) {
+    Double double_value = 0;
+    timestamp_column.emplace_back(data_value.source_timestamp);
+    value_column.emplace_back(data_value.value.get(double_value)
+                                  ? double_value
+                                  : std::numeric_limits<Double>::quiet_NaN());
+  }
+
+  const auto& aggregate_type = aggregation.aggregate_type;
+  const bool locate_extrema =
+      aggregate_type == id::AggregateFunction_Minimum ||
+      aggregate_type == id::AggregateFunction_Maximum;
+
+  interval_aggregates.clear();
+  AggregateNumericIntervals(timestamp_column, value_column,
+                            aggregation.start_time, aggregation.interval,
+                            locate_extrema, interval_aggregates);
+
+  for (const auto& partial : interval_aggregates) {
+    if (aggregator_interval != partial.interval) {
+      if (!aggregated_value.is_null()) {
+        data_values.emplace_back(std::move(aggregated_value));
+        aggregated_value = {};
+      }
+      aggregator_interval = partial.interval;
+      numeric = {};
+    }
+
+    const auto& reduction = partial.reduction;
+    if (numeric.count == 0 || reduction.min < numeric.min)
+      numeric.min_qualifier = raw_span[partial.min_index].qualifier;
+    if (numeric.count == 0 || reduction.max > numeric.max)
+      numeric.max_qualifier = raw_span[partial.max_index].qualifier;
+    if (numeric.count == 0)
+      numeric.start = raw_span[partial.first];
+    numeric.end = raw_span[partial.last - 1];
+    numeric.count += partial.count();
+    numeric.total += reduction.total;
+    numeric.min = std::min(numeric.min, reduction.min);
+    numeric.max = std::max(numeric.max, reduction.max);
+
+    aggregated_value = MakeNumericAggregateValue(
+        aggregate_type, aggregator_interval, numeric);
+  }
+}
+
 void AggregateState::Finish() {
   if (!aggregated_value.is_null())
     data_values.emplace_back(std::move(aggregated_value));
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "common/aggregation_kernels.h"
 #include "scada/data_value.h"
 #include "scada/date_time_range.h"
 #include "scada/node_id.h"
 
 #include <functional>
+#include <limits>
 #include <span>
+#include <vector>
 
 namespace scada {
 
@@ -23,6 +26,19 @@ DateTimeRange GetAggregateInterval(DateTime time,
                                    DateTime start_time,
                                    Duration interval);
 
+// Running numeric aggregate of the current interval, accumulated across
+// AggregateState::Process calls.
+struct NumericAggregateAccumulator {
+  size_t count = 0;
+  Double total = 0;
+  Double min = std::numeric_limits<Double>::max();
+  Double max = std::numeric_limits<Double>::lowest();
+  Qualifier min_qualifier;
+  Qualifier max_qualifier;
+  DataValue start;
+  DataValue end;
+};
+
 struct AggregateState {
   void Process(std::span<const scada::DataValue> raw_span);
   void Finish();
@@ -34,6 +50,16 @@ struct AggregateState {
   scada::Aggregator aggregator;
   scada::DateTimeRange aggregator_interval;
   scada::DataValue aggregated_value;
+
+  // Forward processing of the standard aggregates goes through the columnar
+  // kernels (see aggregation_kernels.h) instead of per-interval `aggregator`s.
+  scada::NumericAggregateAccumulator numeric;
+  std::vector<scada::DateTime> timestamp_column;
+  std::vector<scada::Double> value_column;
+  std::vector<scada::NumericIntervalAggregate> interval_aggregates;
+
+ private:
+  void ProcessNumeric(std::span<const scada::DataValue> raw_span);
 };
 
 }  // namespace scada
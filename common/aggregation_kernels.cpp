@@ -0,0 +1,153 @@
+#include "common/aggregation_kernels.h"
+
+#include "base/check.h"
+#include "common/aggregation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace scada {
+
+namespace {
+
+#if defined(__AVX2__)
+
+double HorizontalSum(__m256d v) {
+  __m128d low = _mm256_castpd256_pd128(v);
+  __m128d high = _mm256_extractf128_pd(v, 1);
+  low = _mm_add_pd(low, high);
+  return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+double HorizontalMin(__m256d v) {
+  __m128d low = _mm256_castpd256_pd128(v);
+  __m128d high = _mm256_extractf128_pd(v, 1);
+  low = _mm_min_pd(low, high);
+  return _mm_cvtsd_f64(_mm_min_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+double HorizontalMax(__m256d v) {
+  __m128d low = _mm256_castpd256_pd128(v);
+  __m128d high = _mm256_extractf128_pd(v, 1);
+  low = _mm_max_pd(low, high);
+  return _mm_cvtsd_f64(_mm_max_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+// MINPD/MAXPD return the second operand when either is NaN, so passing the
+// accumulator second skips NaN samples without a compare.
+size_t ReduceNumericVector(std::span<const double> values,
+                           NumericReduction& result) {
+  const double* data = values.data();
+  const size_t count = values.size() & ~size_t{3};
+
+  __m256d total = _mm256_setzero_pd();
+  __m256d min = _mm256_set1_pd(result.min);
+  __m256d max = _mm256_set1_pd(result.max);
+  for (size_t i = 0; i < count; i += 4) {
+    __m256d v = _mm256_loadu_pd(data + i);
+    __m256d is_number = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+    total = _mm256_add_pd(total, _mm256_and_pd(v, is_number));
+    min = _mm256_min_pd(v, min);
+    max = _mm256_max_pd(v, max);
+  }
+
+  result.total += HorizontalSum(total);
+  result.min = HorizontalMin(min);
+  result.max = HorizontalMax(max);
+  return count;
+}
+
+#else
+
+// Four independent accumulators break the loop-carried dependency so the
+// compiler can keep the lanes in vector registers.
+size_t ReduceNumericVector(std::span<const double> values,
+                           NumericReduction& result) {
+  constexpr size_t kLanes = 4;
+  const size_t count = values.size() - values.size() % kLanes;
+
+  double total[kLanes] = {};
+  double min[kLanes] = {result.min, result.min, result.min, result.min};
+  double max[kLanes] = {result.max, result.max, result.max, result.max};
+  for (size_t i = 0; i < count; i += kLanes) {
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+      double v = values[i + lane];
+      bool is_number = v == v;
+      total[lane] += is_number ? v : 0.0;
+      min[lane] = is_number && v < min[lane] ? v : min[lane];
+      max[lane] = is_number && v > max[lane] ? v : max[lane];
+    }
+  }
+
+  result.total += (total[0] + total[1]) + (total[2] + total[3]);
+  result.min = std::min(std::min(min[0], min[1]), std::min(min[2], min[3]));
+  result.max = std::max(std::max(max[0], max[1]), std::max(max[2], max[3]));
+  return count;
+}
+
+#endif
+
+}  // namespace
+
+NumericReduction ReduceNumeric(std::span<const double> values) {
+  NumericReduction result;
+  size_t i = ReduceNumericVector(values, result);
+  for (; i < values.size(); ++i) {
+    double v = values[i];
+    if (std::isnan(v))
+      continue;
+    result.total += v;
+    result.min = std::min(result.min, v);
+    result.max = std::max(result.max, v);
+  }
+  return result;
+}
+
+void AggregateNumericIntervals(std::span<const DateTime> timestamps,
+                               std::span<const double> values,
+                               DateTime origin_time,
+                               Duration interval,
+                               bool locate_extrema,
+                               std::vector<NumericIntervalAggregate>& result) {
+  base::Check(timestamps.size() == values.size());
+
+  size_t first = 0;
+  while (first < timestamps.size()) {
+    auto range =
+        GetAggregateInterval(timestamps[first], origin_time, interval);
+
+    // Binary search from `first` only: intervals are visited in time order.
+    auto end = std::upper_bound(timestamps.begin() + first, timestamps.end(),
+                                range.second);
+    size_t last = static_cast<size_t>(end - timestamps.begin());
+    base::Check(last > first);
+
+    auto& aggregate = result.emplace_back();
+    aggregate.interval = range;
+    aggregate.first = first;
+    aggregate.last = last;
+    aggregate.reduction = ReduceNumeric(values.subspan(first, last - first));
+    aggregate.min_index = first;
+    aggregate.max_index = first;
+
+    if (locate_extrema) {
+      auto slice = values.subspan(first, last - first);
+      if (auto i = std::ranges::find(slice, aggregate.reduction.min);
+          i != slice.end()) {
+        aggregate.min_index = first + (i - slice.begin());
+      }
+      if (auto i = std::ranges::find(slice, aggregate.reduction.max);
+          i != slice.end()) {
+        aggregate.max_index = first + (i - slice.begin());
+      }
+    }
+
+    first = last;
+  }
+}
+
+}  // namespace scada
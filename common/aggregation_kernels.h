@@ -0,0 +1,54 @@
+#pragma once
+
+#include "scada/date_time.h"
+#include "scada/date_time_range.h"
+
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace scada {
+
+// Sum and extrema of a contiguous double column. NaN marks a sample that has
+// no numeric value: it is skipped by all three reductions.
+struct NumericReduction {
+  double total = 0;
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+};
+
+// Reduces `values` in one pass. Uses AVX2 when the build enables it and an
+// unrolled portable loop otherwise; the two differ only in the order of the
+// floating-point additions.
+NumericReduction ReduceNumeric(std::span<const double> values);
+
+// The partial aggregate of the samples of one processing interval.
+struct NumericIntervalAggregate {
+  DateTimeRange interval;
+
+  // Samples [first, last) of the input columns.
+  size_t first = 0;
+  size_t last = 0;
+
+  NumericReduction reduction;
+
+  // Index of the first sample holding the min/max value, or `first` when no
+  // sample of the interval is numeric. Only filled when requested.
+  size_t min_index = 0;
+  size_t max_index = 0;
+
+  size_t count() const { return last - first; }
+};
+
+// Splits time-sorted columns into processing intervals aligned to
+// `origin_time` (see GetAggregateInterval) and reduces each of them, appending
+// one entry per non-empty interval to `result`. A sample exactly at an
+// interval end belongs to that interval, as in AggregateState::Process.
+void AggregateNumericIntervals(std::span<const DateTime> timestamps,
+                               std::span<const double> values,
+                               DateTime origin_time,
+                               Duration interval,
+                               bool locate_extrema,
+                               std::vector<NumericIntervalAggregate>& result);
+
+}  // namespace scada
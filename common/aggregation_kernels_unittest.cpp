@@ -0,0 +1,77 @@
+#include "common/aggregation_kernels.h"
+
+#include <gmock/gmock.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace testing;
+
+namespace scada {
+
+namespace {
+
+const double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+DateTime At(int seconds) {
+  return DateTime::UnixEpoch() + Duration::FromSeconds(seconds);
+}
+
+}  // namespace
+
+TEST(AggregationKernels, ReduceNumeric_Empty) {
+  auto reduction = ReduceNumeric({});
+  EXPECT_EQ(reduction.total, 0);
+  EXPECT_EQ(reduction.min, std::numeric_limits<double>::max());
+  EXPECT_EQ(reduction.max, std::numeric_limits<double>::lowest());
+}
+
+TEST(AggregationKernels, ReduceNumeric_SkipsNaN) {
+  // Long enough to cover both the vector body and the scalar tail.
+  std::vector<double> values = {3, kNaN, -7, 2, 9, kNaN, 1, 4, -1, 5, kNaN};
+  auto reduction = ReduceNumeric(values);
+  EXPECT_DOUBLE_EQ(reduction.total, 16);
+  EXPECT_EQ(reduction.min, -7);
+  EXPECT_EQ(reduction.max, 9);
+}
+
+TEST(AggregationKernels, ReduceNumeric_MatchesScalarSum) {
+  std::vector<double> values(1001);
+  std::iota(values.begin(), values.end(), -500.0);
+  auto reduction = ReduceNumeric(values);
+  EXPECT_DOUBLE_EQ(reduction.total, 0);
+  EXPECT_EQ(reduction.min, -500);
+  EXPECT_EQ(reduction.max, 500);
+}
+
+TEST(AggregationKernels, AggregateNumericIntervals) {
+  std::vector<DateTime> timestamps = {At(1), At(2), At(10), At(11), At(25)};
+  std::vector<double> values = {5, 1, 7, kNaN, 3};
+
+  std::vector<NumericIntervalAggregate> result;
+  AggregateNumericIntervals(timestamps, values, At(0),
+                            Duration::FromSeconds(10),
+                            /*locate_extrema=*/true, result);
+
+  // A sample exactly at an interval end belongs to that interval.
+  ASSERT_EQ(result.size(), 3u);
+  EXPECT_EQ(result[0].interval, (DateTimeRange{At(0), At(10)}));
+  EXPECT_EQ(result[0].count(), 3u);
+  EXPECT_EQ(result[0].reduction.total, 13);
+  EXPECT_EQ(result[0].min_index, 1u);
+  EXPECT_EQ(result[0].max_index, 2u);
+
+  // An interval without numeric samples keeps its count.
+  EXPECT_EQ(result[1].interval, (DateTimeRange{At(10), At(20)}));
+  EXPECT_EQ(result[1].count(), 1u);
+  EXPECT_EQ(result[1].reduction.total, 0);
+  EXPECT_EQ(result[1].min_index, 3u);
+
+  EXPECT_EQ(result[2].interval, (DateTimeRange{At(20), At(30)}));
+  EXPECT_EQ(result[2].first, 4u);
+  EXPECT_EQ(result[2].last, 5u);
+}
+
+}  // namespace scada
@@ -0,0 +1,158 @@
+#include "common/aggregation.h"
+
+#include "scada/aggregate_filter.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+namespace scada {
+
+namespace {
+
+const Duration kInterval = Duration::FromSeconds(10);
+
+DateTime At(int seconds) {
+  return DateTime::UnixEpoch() + Duration::FromSeconds(seconds);
+}
+
+DataValue MakeValue(Variant value, int seconds, Qualifier qualifier = {}) {
+  return DataValue{std::move(value), qualifier, At(seconds), At(seconds)};
+}
+
+AggregateFilter MakeFilter(const NodeId& aggregate_type) {
+  AggregateFilter filter;
+  filter.start_time = At(0);
+  filter.interval = kInterval;
+  filter.aggregate_type = aggregate_type;
+  return filter;
+}
+
+// Aggregates each interval with one call of its `Aggregator`, as
+// AggregateState did before the columnar kernels.
+std::vector<DataValue> AggregateByInterval(std::span<const DataValue> values,
+                                           const AggregateFilter& filter) {
+  std::vector<DataValue> result;
+  while (!values.empty()) {
+    auto interval = GetAggregateInterval(values[0].source_timestamp,
+                                         filter.start_time, filter.interval);
+    auto end = std::ranges::find_if(values, [&](const DataValue& data_value) {
+      return data_value.source_timestamp > interval.second;
+    });
+    auto count = static_cast<size_t>(end - values.begin());
+    auto aggregator = GetAggregator(filter.aggregate_type, interval, true);
+    result.emplace_back(aggregator(values.subspan(0, count)));
+    values = values.subspan(count);
+  }
+  return result;
+}
+
+// Feeds `values` to AggregateState in two batches split at `split`.
+std::vector<DataValue> AggregateByState(std::span<const DataValue> values,
+                                        const AggregateFilter& filter,
+                                        size_t split) {
+  std::vector<DataValue> result;
+  AggregateState state{.aggregation = filter, .data_values = result};
+  state.Process(values.subspan(0, split));
+  state.Process(values.subspan(split));
+  state.Finish();
+  return result;
+}
+
+void ExpectSameAggregates(const std::vector<DataValue>& actual,
+                          const std::vector<DataValue>& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(actual[i].source_timestamp, expected[i].source_timestamp);
+    EXPECT_EQ(actual[i].server_timestamp, expected[i].server_timestamp);
+    EXPECT_EQ(actual[i].qualifier, expected[i].qualifier);
+    // The kernels may add in a different order.
+    Double actual_double = 0;
+    Double expected_double = 0;
+    if (actual[i].value.get(actual_double) &&
+        expected[i].value.get(expected_double)) {
+      EXPECT_DOUBLE_EQ(actual_double, expected_double);
+    } else {
+      EXPECT_EQ(actual[i].value, expected[i].value);
+    }
+  }
+}
+
+const NodeId kAggregateTypes[] = {
+    id::AggregateFunction_Total,   id::AggregateFunction_Average,
+    id::AggregateFunction_Count,   id::AggregateFunction_Minimum,
+    id::AggregateFunction_Maximum, id::AggregateFunction_Start,
+    id::AggregateFunction_End,
+};
+
+}  // namespace
+
+TEST(AggregateState, NumericMatchesAggregators) {
+  const Qualifier manual{Qualifier::MANUAL};
+  // The second batch starts in the middle of the second interval; the last
+  // interval holds only negative values.
+  const std::vector<DataValue> values = {
+      MakeValue(4.0, 1),          MakeValue(-2.0, 3),
+      MakeValue(8.0, 10, manual), MakeValue(-5.0, 12, manual),
+      MakeValue(-1.0, 15),        MakeValue(-3.0, 27),
+      MakeValue(-9.0, 29),
+  };
+
+  for (const auto& aggregate_type : kAggregateTypes) {
+    SCOPED_TRACE(&aggregate_type - kAggregateTypes);
+    const auto filter = MakeFilter(aggregate_type);
+    ExpectSameAggregates(AggregateByState(values, filter, /*split=*/4),
+                         AggregateByInterval(values, filter));
+  }
+}
+
+TEST(AggregateState, NonNumericMatchesAggregators) {
+  // Non-numeric samples count, but are skipped by the sum and the extrema.
+  const std::vector<DataValue> values = {
+      MakeValue(Variant{std::string{"on"}}, 1),
+      MakeValue(6.0, 2),
+      MakeValue(Variant{std::string{"off"}}, 5),
+      MakeValue(Variant{std::string{"on"}}, 14),
+  };
+
+  for (const auto& aggregate_type :
+       {id::AggregateFunction_Total, id::AggregateFunction_Average,
+        id::AggregateFunction_Count, id::AggregateFunction_Start,
+        id::AggregateFunction_End}) {
+    const auto filter = MakeFilter(aggregate_type);
+    ExpectSameAggregates(AggregateByState(values, filter, /*split=*/2),
+                         AggregateByInterval(values, filter));
+  }
+
+  // The Aggregators order a non-numeric sample by its address, so their
+  // extrema of mixed samples are arbitrary.
+  auto minimum = AggregateByState(
+      values, MakeFilter(id::AggregateFunction_Minimum), /*split=*/2);
+  ASSERT_EQ(minimum.size(), 2u);
+  EXPECT_EQ(minimum[0].value, Variant{6.0});
+  EXPECT_EQ(minimum[1].value, Variant{std::numeric_limits<Double>::max()});
+
+  auto maximum = AggregateByState(
+      values, MakeFilter(id::AggregateFunction_Maximum), /*split=*/2);
+  ASSERT_EQ(maximum.size(), 2u);
+  EXPECT_EQ(maximum[0].value, Variant{6.0});
+  EXPECT_EQ(maximum[1].value, Variant{std::numeric_limits<Double>::lowest()});
+}
+
+TEST(AggregateState, MaximumOfNegativeValues) {
+  const std::vector<DataValue> values = {MakeValue(-3.0, 1),
+                                         MakeValue(-7.0, 2)};
+  const auto filter = MakeFilter(id::AggregateFunction_Maximum);
+  auto result = AggregateByState(values, filter, /*split=*/1);
+  ASSERT_EQ(result.size(), 1u);
+  EXPECT_EQ(result[0].value, Variant{-3.0});
+}
+
+}  // namespace scada
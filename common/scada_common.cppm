@@ -16,6 +16,7 @@ module;
 
 // ---- Global module fragment: headers stay the source of truth ----
 #include "common/aggregation.h"
+#include "common/aggregation_kernels.h"
 #include "common/aliases.h"
 #include "common/audit.h"
 #include "common/common_paths.h"
@@ -56,9 +57,14 @@ export namespace scada {
 // aggregation.h
 using scada::AggregateState;
 using scada::Aggregator;
+using scada::AggregateNumericIntervals;
 using scada::GetAggregateInterval;
 using scada::GetAggregator;
 using scada::GetLocalAggregateStartTime;
+using scada::NumericAggregateAccumulator;
+using scada::NumericIntervalAggregate;
+using scada::NumericReduction;
+using scada::ReduceNumeric;
 
 // common_paths.h (unnamed-enum path keys + registration)
 using scada::PATH_END;
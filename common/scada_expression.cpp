@@ -10,7 +10,14 @@
 #include "express/strings.h"
 #pragma warning(pop)
 
+#include "base/check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <exception>
+#include <limits>
+#include <optional>
 #include <string>
 
 static const expression::LexemType LEX_TRUE = 't';
@@ -153,12 +160,49 @@ class ItemToken : public expression::Token {
   const int index_;
 };
 
+// Receives the tokens of a formula as the parser creates them, children
+// before their parent.
+class LoweringDelegate {
+ public:
+  virtual ~LoweringDelegate() = default;
+
+  virtual void OnItem(size_t index) = 0;
+  virtual void OnConstant(double value, bool integral) = 0;
+  virtual void OnUnaryOperator(expression::LexemType oper) = 0;
+  virtual void OnBinaryOperator(expression::LexemType oper) = 0;
+  // A token that has no lowering.
+  virtual void OnOpaqueToken() = 0;
+};
+
 struct ParserDelegate
     : public expression::BasicParserDelegate<expression::PolymorphicToken> {
-  ParserDelegate(expression::Allocator& allocator, ScadaExpression& expression)
-      : expression::BasicParserDelegate<expression::PolymorphicToken>{
-            allocator},
-        expression{expression} {}
+  using Base = expression::BasicParserDelegate<expression::PolymorphicToken>;
+
+  ParserDelegate(expression::Allocator& allocator,
+                 ScadaExpression& expression,
+                 LoweringDelegate& lowering)
+      : Base{allocator}, expression{expression}, lowering{lowering} {}
+
+  expression::PolymorphicToken MakeNumberToken(double value) {
+    lowering.OnConstant(value, std::trunc(value) == value);
+    return Base::MakeNumberToken(value);
+  }
+
+  expression::PolymorphicToken MakeUnaryOperatorToken(
+      expression::LexemType oper,
+      expression::PolymorphicToken&& operand) {
+    lowering.OnUnaryOperator(oper);
+    return Base::MakeUnaryOperatorToken(oper, std::move(operand));
+  }
+
+  expression::PolymorphicToken MakeBinaryOperatorToken(
+      expression::LexemType oper,
+      expression::PolymorphicToken&& left,
+      expression::PolymorphicToken&& right) {
+    lowering.OnBinaryOperator(oper);
+    return Base::MakeBinaryOperatorToken(oper, std::move(left),
+                                         std::move(right));
+  }
 
   template <class Parser>
   expression::PolymorphicToken MakeCustomToken(const expression::Lexem& lexem,
@@ -166,6 +210,8 @@ struct ParserDelegate
     switch (lexem.lexem) {
       case LEX_TRUE:
       case LEX_FALSE:
+        lowering.OnConstant(lexem.lexem == LEX_TRUE ? 1.0 : 0.0,
+                            /*integral=*/false);
         return expression::MakePolymorphicToken<BoolToken>(
             allocator_, lexem.lexem == LEX_TRUE);
 
@@ -173,6 +219,7 @@ struct ParserDelegate
         // variable
         auto& item = expression.items.emplace_back();
         item.name = lexem._string;
+        lowering.OnItem(expression.items.size() - 1);
         return expression::MakePolymorphicToken<ItemToken>(
             allocator_, expression, expression.items.size() - 1);
       }
@@ -180,14 +227,278 @@ struct ParserDelegate
       default:
         // Formula text is external user input; an unexpected lexem yields an
         // empty token instead of panicking.
+        lowering.OnOpaqueToken();
         return {};
     }
   }
+
   ScadaExpression& expression;
+  LoweringDelegate& lowering;
 };
 
 }  // namespace
 
+// A formula lowered to register bytecode. Registers hold the item values, the
+// constants and one result per instruction.
+//
+// Only the arithmetic core is lowered: numbers, TRUE/FALSE, items, unary +/-
+// and binary + - * /. Anything else (functions, comparisons, logic) keeps the
+// formula on the token tree. Constant subexpressions are folded at compile
+// time, except integer division, whose result depends on the token tree's
+// integer semantics.
+class ScadaExpression::Program {
+ public:
+  class Builder;
+
+  // Returns null when the items are not all doubles or the result is not
+  // finite, leaving those cases to the token tree and its error handling.
+  std::optional<double> Calculate(const ScadaExpression::ItemList& items) const;
+
+  void CalculateColumn(std::span<const std::span<const double>> operands,
+                       std::span<double> result) const;
+
+ private:
+  enum class OpCode : uint8_t { kAdd, kSub, kMul, kDiv, kNeg };
+
+  struct Instruction {
+    OpCode op;
+    uint32_t dst;
+    uint32_t lhs;
+    uint32_t rhs;
+  };
+
+  static double Apply(OpCode op, double lhs, double rhs) {
+    switch (op) {
+      case OpCode::kAdd:
+        return lhs + rhs;
+      case OpCode::kSub:
+        return lhs - rhs;
+      case OpCode::kMul:
+        return lhs * rhs;
+      case OpCode::kDiv:
+        return lhs / rhs;
+      case OpCode::kNeg:
+        return -lhs;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  // Register of each item, by item index.
+  std::vector<uint32_t> item_registers_;
+  // Initial register file: constants in place, items and results zeroed.
+  std::vector<double> registers_;
+  std::vector<Instruction> code_;
+  uint32_t result_ = 0;
+};
+
+// Lowers the tokens the parser reports, so the bytecode follows the express
+// grammar rather than a grammar of its own. An operand that has no lowering
+// keeps every token built on it from being lowered.
+class ScadaExpression::Program::Builder : public LoweringDelegate {
+ public:
+  Builder() : program_{std::make_unique<Program>()} {}
+
+  // Returns null unless the parsed tree, of `node_count` tokens, was lowered
+  // whole. A token the parser creates without reporting it leaves the counts
+  // apart.
+  std::unique_ptr<Program> Finish(size_t node_count) {
+    if (underflow_ || token_count_ != node_count || operands_.size() != 1 ||
+        !operands_.back()) {
+      return nullptr;
+    }
+    program_->result_ = Materialize(*operands_.back());
+    return std::move(program_);
+  }
+
+  // LoweringDelegate
+  virtual void OnItem(size_t index) override {
+    ++token_count_;
+    scada::base::Check(index == program_->item_registers_.size());
+    auto reg = AllocateRegister(0);
+    program_->item_registers_.emplace_back(reg);
+    operands_.emplace_back(Operand{.reg = reg});
+  }
+
+  virtual void OnConstant(double value, bool integral) override {
+    ++token_count_;
+    operands_.emplace_back(
+        Operand{.constant = true, .integral = integral, .value = value});
+  }
+
+  virtual void OnUnaryOperator(expression::LexemType oper) override {
+    ++token_count_;
+    auto operand = Pop();
+    switch (oper) {
+      case '+':
+        operands_.emplace_back(operand);
+        break;
+      case '-':
+        operands_.emplace_back(Emit(OpCode::kNeg, operand, operand));
+        break;
+      default:
+        operands_.emplace_back(std::nullopt);
+        break;
+    }
+  }
+
+  virtual void OnBinaryOperator(expression::LexemType oper) override {
+    ++token_count_;
+    auto rhs = Pop();
+    auto lhs = Pop();
+    switch (oper) {
+      case '+':
+        operands_.emplace_back(Emit(OpCode::kAdd, lhs, rhs));
+        break;
+      case '-':
+        operands_.emplace_back(Emit(OpCode::kSub, lhs, rhs));
+        break;
+      case '*':
+        operands_.emplace_back(Emit(OpCode::kMul, lhs, rhs));
+        break;
+      case '/':
+        operands_.emplace_back(Emit(OpCode::kDiv, lhs, rhs));
+        break;
+      default:
+        operands_.emplace_back(std::nullopt);
+        break;
+    }
+  }
+
+  virtual void OnOpaqueToken() override {
+    ++token_count_;
+    operands_.emplace_back(std::nullopt);
+  }
+
+ private:
+  // A compile-time operand: either a folded constant or a register.
+  struct Operand {
+    bool constant = false;
+    // Integer literal, or folded from integer literals only.
+    bool integral = false;
+    double value = 0;
+    uint32_t reg = 0;
+  };
+
+  std::optional<Operand> Pop() {
+    if (operands_.empty()) {
+      underflow_ = true;
+      return std::nullopt;
+    }
+    auto operand = operands_.back();
+    operands_.pop_back();
+    return operand;
+  }
+
+  std::optional<Operand> Emit(OpCode op,
+                              const std::optional<Operand>& lhs,
+                              const std::optional<Operand>& rhs) {
+    if (!lhs || !rhs)
+      return std::nullopt;
+
+    if (lhs->constant && rhs->constant) {
+      if (op == OpCode::kDiv && lhs->integral && rhs->integral)
+        return std::nullopt;
+      return Operand{.constant = true,
+                     .integral = lhs->integral && rhs->integral,
+                     .value = Apply(op, lhs->value, rhs->value)};
+    }
+
+    Instruction instruction{.op = op,
+                            .dst = 0,
+                            .lhs = Materialize(*lhs),
+                            .rhs = Materialize(*rhs)};
+    instruction.dst = AllocateRegister(0);
+    program_->code_.emplace_back(instruction);
+    return Operand{.reg = instruction.dst};
+  }
+
+  uint32_t Materialize(const Operand& operand) {
+    return operand.constant ? AllocateRegister(operand.value) : operand.reg;
+  }
+
+  uint32_t AllocateRegister(double initial_value) {
+    program_->registers_.emplace_back(initial_value);
+    return static_cast<uint32_t>(program_->registers_.size() - 1);
+  }
+
+  std::unique_ptr<Program> program_;
+  std::vector<std::optional<Operand>> operands_;
+  size_t token_count_ = 0;
+  bool underflow_ = false;
+};
+
+std::optional<double> ScadaExpression::Program::Calculate(
+    const ScadaExpression::ItemList& items) const {
+  std::vector<double> registers = registers_;
+  for (size_t i = 0; i < item_registers_.size(); ++i) {
+    const auto& value = items[i].value.value;
+    if (value.type() != scada::Variant::DOUBLE)
+      return std::nullopt;
+    registers[item_registers_[i]] = value.as_double();
+  }
+
+  for (const auto& instruction : code_) {
+    registers[instruction.dst] = Apply(
+        instruction.op, registers[instruction.lhs], registers[instruction.rhs]);
+  }
+
+  double result = registers[result_];
+  if (!std::isfinite(result))
+    return std::nullopt;
+  return result;
+}
+
+void ScadaExpression::Program::CalculateColumn(
+    std::span<const std::span<const double>> operands,
+    std::span<double> result) const {
+  // Instruction-major over blocks of rows: each instruction becomes a tight
+  // loop over the block that the compiler can vectorize.
+  constexpr size_t kBlockSize = 256;
+
+  std::vector<double> columns(registers_.size() * kBlockSize);
+
+  for (size_t first = 0; first < result.size(); first += kBlockSize) {
+    const size_t count = std::min(kBlockSize, result.size() - first);
+
+    for (size_t r = 0; r < registers_.size(); ++r)
+      std::fill_n(&columns[r * kBlockSize], count, registers_[r]);
+    for (size_t i = 0; i < item_registers_.size(); ++i) {
+      std::copy_n(operands[i].data() + first, count,
+                  &columns[item_registers_[i] * kBlockSize]);
+    }
+
+    for (const auto& instruction : code_) {
+      double* dst = &columns[instruction.dst * kBlockSize];
+      const double* lhs = &columns[instruction.lhs * kBlockSize];
+      const double* rhs = &columns[instruction.rhs * kBlockSize];
+      switch (instruction.op) {
+        case OpCode::kAdd:
+          for (size_t i = 0; i < count; ++i)
+            dst[i] = lhs[i] + rhs[i];
+          break;
+        case OpCode::kSub:
+          for (size_t i = 0; i < count; ++i)
+            dst[i] = lhs[i] - rhs[i];
+          break;
+        case OpCode::kMul:
+          for (size_t i = 0; i < count; ++i)
+            dst[i] = lhs[i] * rhs[i];
+          break;
+        case OpCode::kDiv:
+          for (size_t i = 0; i < count; ++i)
+            dst[i] = lhs[i] / rhs[i];
+          break;
+        case OpCode::kNeg:
+          for (size_t i = 0; i < count; ++i)
+            dst[i] = -lhs[i];
+          break;
+      }
+    }
+
+    std::copy_n(&columns[result_ * kBlockSize], count, result.data() + first);
+  }
+}
+
 static bool _aliases;
 
 class Traversers {
@@ -211,13 +522,16 @@ ScadaExpression::ScadaExpression()
 ScadaExpression ::~ScadaExpression() = default;
 
 void ScadaExpression::Parse(const char* buf) {
+  program_.reset();
   ScadaLexerDelegate lexer_delegate;
   expression::Lexer lexer{buf, lexer_delegate, 0};
   expression::Allocator allocator;
-  ParserDelegate parser_delegate{allocator, *this};
+  Program::Builder program_builder;
+  ParserDelegate parser_delegate{allocator, *this, program_builder};
   expression::BasicParser<expression::Lexer, ParserDelegate> parser{
       lexer, parser_delegate};
   expression_->Parse(parser, allocator);
+  program_ = program_builder.Finish(GetNodeCount());
 }
 
 scada::Status ScadaExpression::ParseStatus(std::string_view formula) {
@@ -234,6 +548,7 @@ scada::Status ScadaExpression::ParseStatus(std::string_view formula) {
 }
 
 void ScadaExpression::Clear() {
+  program_.reset();
   items.clear();
   expression_->Clear();
 }
@@ -276,9 +591,56 @@ scada::Variant ScadaExpression::Calculate() const {
     if (items[i].value.value.is_null())
       return scada::Variant();
 
+  if (program_) {
+    if (auto result = program_->Calculate(items))
+      return *result;
+  }
+
   return static_cast<double>(expression_->Calculate());
 }
 
+void ScadaExpression::CalculateColumn(
+    std::span<const std::span<const double>> operands,
+    std::span<double> result) {
+  scada::base::Check(operands.size() == items.size());
+  for (const auto& operand : operands)
+    scada::base::Check(operand.size() == result.size());
+
+  if (program_) {
+    program_->CalculateColumn(operands, result);
+    // A non-finite row may be an error the token tree reports differently;
+    // recompute those rows below. NaN operands stay null either way.
+    for (size_t row = 0; row < result.size(); ++row) {
+      if (std::isfinite(result[row]))
+        continue;
+      result[row] = std::numeric_limits<double>::quiet_NaN();
+      bool has_null = false;
+      for (size_t i = 0; i < operands.size(); ++i) {
+        has_null |= std::isnan(operands[i][row]);
+        items[i].value.value = operands[i][row];
+      }
+      if (!has_null) {
+        auto value = CalculateStatus();
+        if (value.ok())
+          value->get(result[row]);
+      }
+    }
+    return;
+  }
+
+  for (size_t row = 0; row < result.size(); ++row) {
+    result[row] = std::numeric_limits<double>::quiet_NaN();
+    for (size_t i = 0; i < operands.size(); ++i) {
+      double operand = operands[i][row];
+      items[i].value.value =
+          std::isnan(operand) ? scada::Variant{} : scada::Variant{operand};
+    }
+    auto value = CalculateStatus();
+    if (value.ok() && !value->is_null())
+      value->get(result[row]);
+  }
+}
+
 scada::StatusOr<scada::Variant> ScadaExpression::CalculateStatus() const {
   try {
     return Calculate();
@@ -4,6 +4,8 @@
 #include "scada/status.h"
 #include "scada/status_or.h"
 
+#include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -34,6 +36,17 @@ class ScadaExpression {
   scada::Variant Calculate() const;
   scada::StatusOr<scada::Variant> CalculateStatus() const;
 
+  // Evaluates the formula once per row, `operands[i][row]` being the value of
+  // `items[i]` and NaN standing for a null value. Writes NaN to `result[row]`
+  // where the formula yields no value. Overwrites the item values when the
+  // formula is not compiled.
+  void CalculateColumn(std::span<const std::span<const double>> operands,
+                       std::span<double> result);
+
+  // Whether Parse() lowered the formula to flat bytecode. Calculate() and
+  // CalculateColumn() then skip the token tree for numeric operands.
+  bool is_compiled() const { return program_ != nullptr; }
+
   std::string Format(bool aliases = false) const;
 
   void Clear();
@@ -43,5 +56,8 @@ class ScadaExpression {
   ItemList items;
 
  protected:
+  class Program;
+
   std::unique_ptr<expression::Expression> expression_;
+  std::unique_ptr<Program> program_;
 };
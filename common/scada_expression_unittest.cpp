@@ -2,6 +2,11 @@
 
 #include <gmock/gmock.h>
 
+#include <cmath>
+#include <limits>
+#include <span>
+#include <vector>
+
 TEST(ScadaExpression, IsSingleName) {
   std::string name;
   EXPECT_TRUE(ScadaExpression::IsSingleName("{%^@sdg#$%#DgaAS$#@}", name));
@@ -17,3 +22,81 @@ TEST(ScadaExpression, Function) {
   expression.items[1].value = scada::DataValue{1, {}, {}, {}};
   EXPECT_EQ(scada::Variant{1.0}, expression.Calculate());
 }
+
+TEST(ScadaExpression, CompiledArithmetic) {
+  ScadaExpression expression;
+  expression.Parse("a * 2 + b / 4 - -c");
+  ASSERT_TRUE(expression.is_compiled());
+  ASSERT_EQ(static_cast<size_t>(3), expression.items.size());
+  expression.items[0].value = scada::DataValue{1.0, {}, {}, {}};
+  expression.items[1].value = scada::DataValue{2.0, {}, {}, {}};
+  expression.items[2].value = scada::DataValue{3.0, {}, {}, {}};
+  EXPECT_EQ(scada::Variant{5.5}, expression.Calculate());
+}
+
+TEST(ScadaExpression, FunctionsAreNotCompiled) {
+  ScadaExpression expression;
+  expression.Parse("or(TIT.1, TIT.2)");
+  EXPECT_FALSE(expression.is_compiled());
+}
+
+TEST(ScadaExpression, ArithmeticInsideFunctionsIsNotCompiled) {
+  ScadaExpression expression;
+  expression.Parse("abs(a - b) * 2");
+  EXPECT_FALSE(expression.is_compiled());
+}
+
+TEST(ScadaExpression, ConstantIntegerDivisionIsNotCompiled) {
+  ScadaExpression expression;
+  expression.Parse("a + 1 / 2");
+  EXPECT_FALSE(expression.is_compiled());
+}
+
+TEST(ScadaExpression, CompiledNullItem) {
+  ScadaExpression expression;
+  expression.Parse("x + 5");
+  ASSERT_TRUE(expression.is_compiled());
+  EXPECT_TRUE(expression.Calculate().is_null());
+}
+
+TEST(ScadaExpression, CalculateColumn) {
+  const double kNull = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> a = {1, 2, kNull, 4};
+  std::vector<double> b = {10, 20, 30, 40};
+  std::vector<std::span<const double>> operands = {a, b};
+
+  ScadaExpression expression;
+  expression.Parse("a + b * (1 + 1)");
+  ASSERT_TRUE(expression.is_compiled());
+
+  std::vector<double> result(a.size());
+  expression.CalculateColumn(operands, result);
+
+  EXPECT_EQ(21, result[0]);
+  EXPECT_EQ(42, result[1]);
+  EXPECT_TRUE(std::isnan(result[2]));
+  EXPECT_EQ(84, result[3]);
+}
+
+TEST(ScadaExpression, CalculateColumnMatchesCalculate) {
+  std::vector<double> a = {1, -2.5, 7, 0.25};
+  std::vector<double> b = {3, 4, -0.5, 8};
+  std::vector<double> c = {2, 0.5, 5, -1};
+  std::vector<std::span<const double>> operands = {a, b, c};
+
+  ScadaExpression expression;
+  expression.Parse("a - b * c / (a + 10) - -(b - c) * 2");
+  ASSERT_TRUE(expression.is_compiled());
+
+  std::vector<double> result(a.size());
+  expression.CalculateColumn(operands, result);
+
+  for (size_t row = 0; row < result.size(); ++row) {
+    for (size_t i = 0; i < operands.size(); ++i)
+      expression.items[i].value =
+          scada::DataValue{operands[i][row], {}, {}, {}};
+    double expected = 0;
+    ASSERT_TRUE(expression.Calculate().get(expected));
+    EXPECT_DOUBLE_EQ(expected, result[row]);
+  }
+}
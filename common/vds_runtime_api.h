@@ -69,6 +69,14 @@ struct TcVdsRuntimeStatePalette {
   uint32_t uncertain;     // uncertain / intermediate state
 };
 
+// One live-value update for `invalidate_data_sources`; the fields mean the
+// same as the arguments of `invalidate_data_source`.
+struct TcVdsRuntimeDataSourceUpdate {
+  const char* data_source;
+  const char* value;
+  int32_t quality;
+};
+
 using TcVdsRuntimeDocument = struct TcVdsRuntimeDocumentOpaque*;
 
 struct TcVdsRuntimeApi {
@@ -127,12 +135,48 @@ struct TcVdsRuntimeApi {
       TcVdsRuntimeDocument document,
       const TcVdsRuntimeStatePalette* palette,
       TcVdsRuntimeError* error);
+
+  // ── ABI version 3 additions ───────────────────────────────────────────────
+
+  // Batched `invalidate_data_source`: records `update_count` updates in one
+  // call, in order, so a later update of the same data source wins. The bounds
+  // of every shape whose state changed are merged into dirty regions: regions
+  // that overlap or touch are joined, and when more than `max_regions` remain
+  // the closest pairs are joined until they fit, so the result always covers
+  // every change. `regions` receives the list and `region_count` its length;
+  // zero means nothing needs repainting. Updates naming an unknown data source
+  // are skipped. Returns non-zero on success.
+  int32_t(TC_VDS_RUNTIME_CALL* invalidate_data_sources)(
+      TcVdsRuntimeDocument document,
+      const TcVdsRuntimeDataSourceUpdate* updates,
+      int32_t update_count,
+      TcVdsRuntimeRect* regions,
+      int32_t max_regions,
+      int32_t* region_count,
+      TcVdsRuntimeError* error);
+
+  // Partial `render_bgra`: repaints only `regions` (page coordinates, as
+  // returned by `invalidate_data_sources`) into `pixels`, which must hold the
+  // previous frame rendered at the same size. Pixels outside the regions are
+  // left untouched. Returns non-zero on success.
+  int32_t(TC_VDS_RUNTIME_CALL* render_bgra_regions)(
+      TcVdsRuntimeDocument document,
+      uint8_t* pixels,
+      int32_t width,
+      int32_t height,
+      int32_t stride,
+      const TcVdsRuntimeRect* regions,
+      int32_t region_count,
+      TcVdsRuntimeError* error);
 };
 
 // ABI 2 appended `set_state_palette` and the state-palette semantics for
-// `invalidate_data_source`. The layout of every ABI-1 member is unchanged, so
-// callers negotiate compatibility through `abi_version`/`struct_size`.
-constexpr uint32_t TC_VDS_RUNTIME_ABI_VERSION = 2;
+// `invalidate_data_source`. ABI 3 appended `invalidate_data_sources` and
+// `render_bgra_regions`, so a display with thousands of live bindings crosses
+// the ABI once per update cycle instead of once per binding. The layout of
+// every earlier member is unchanged, so callers negotiate compatibility
+// through `abi_version`/`struct_size`.
+constexpr uint32_t TC_VDS_RUNTIME_ABI_VERSION = 3;
 
 TC_VDS_RUNTIME_EXPORT const TcVdsRuntimeApi* TC_VDS_RUNTIME_CALL
 TcVdsRuntimeGetApi(uint32_t requested_abi_version);
@@ -6,6 +6,31 @@
 #include "scada/method_service.h"
 #include "scada/standard_node_ids.h"
 
+#include <ranges>
+
+namespace {
+
+// A call that saturated the window and finished within half of this grows the
+// window; any call slower than this shrinks it.
+const scada::base::TimeDelta kTargetCallDuration =
+    scada::base::TimeDelta::FromSeconds(1);
+
+// Whether `status` means the server takes a single event per Acknowledge call,
+// rather than that the call failed for other reasons.
+bool IsBatchRejected(const scada::Status& status) {
+  switch (status.code()) {
+    case scada::StatusCode::Bad_NotSupported:
+    case scada::StatusCode::Bad_ServiceUnsupported:
+    case scada::StatusCode::Bad_WrongCallArguments:
+    case scada::StatusCode::Bad_TooManyOperations:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 EventAckQueue::EventAckQueue(EventAckQueueContext&& context)
     : EventAckQueueContext{std::move(context)} {}
 
@@ -16,14 +41,21 @@ EventAckQueue::~EventAckQueue() {
 void EventAckQueue::OnAcked(scada::EventId acknowledge_id) {
   if (running_ack_event_ids_.erase(acknowledge_id)) {
     LOG_INFO(*logger_) << std::format("Event {} acknowledged", acknowledge_id);
+    CompleteAck();
     PostAckPendingEvents();
   }
 }
 
+void EventAckQueue::CompleteAck() {
+  ++progress_.completed;
+  if (!IsAcking())
+    progress_ = {};
+}
+
 void EventAckQueue::PostAckPendingEvents() {
-  if (running_ack_event_ids_.size() >= kMaxParallelAcks ||
+  // A shrunk window may leave a dispatch pending with no room; it is a no-op.
+  if (running_ack_event_ids_.size() >= window_ ||
       pending_ack_event_ids_.empty()) {
-    scada::base::Check(!ack_pending_);
     return;
   }
 
@@ -37,38 +69,105 @@ void EventAckQueue::AckPendingEvents() {
   scada::base::Check(ack_pending_);
   ack_pending_ = false;
 
-  std::vector<scada::EventId> event_ids;
-  while (running_ack_event_ids_.size() < kMaxParallelAcks &&
+  while (running_ack_event_ids_.size() < window_ &&
          !pending_ack_event_ids_.empty()) {
-    auto ack_id = pending_ack_event_ids_.front();
-    pending_ack_event_ids_.pop_front();
+    const size_t call_size =
+        batching_ ? window_ - running_ack_event_ids_.size() : 1;
 
-    event_ids.emplace_back(ack_id);
-    running_ack_event_ids_.insert(ack_id);
-  }
+    std::vector<scada::EventId> event_ids;
+    while (event_ids.size() < call_size && !pending_ack_event_ids_.empty()) {
+      auto ack_id = pending_ack_event_ids_.front();
+      pending_ack_event_ids_.pop_front();
+      queued_ack_event_ids_.erase(ack_id);
+
+      event_ids.emplace_back(ack_id);
+      running_ack_event_ids_.insert(ack_id);
+    }
+
+    const bool window_full = running_ack_event_ids_.size() >= window_;
 
-  if (!event_ids.empty()) {
     LOG_INFO(*logger_) << std::format("Acknowledge events {}",
                                       scada::base::AsList(event_ids));
     CoSpawn(executor_, cancelation_,
-            [this, event_ids = std::move(event_ids),
+            [this, cancelation = cancelation_.ref(),
+             event_ids = std::move(event_ids), window_full,
              context = service_context_]() mutable -> Awaitable<void> {
-              co_await method_service_.Call(
+              auto start_ticks = scada::base::TimeTicks::Now();
+              auto status = co_await method_service_.Call(
                   scada::id::Server,
                   scada::id::AcknowledgeableConditionType_Acknowledge,
                   {event_ids, scada::DateTime::Now()}, std::move(context));
+              if (cancelation.canceled())
+                co_return;
+              OnAckCallComplete(std::move(event_ids), status, window_full,
+                                scada::base::TimeTicks::Now() - start_ticks);
             });
   }
 
   PostAckPendingEvents();
 }
 
+void EventAckQueue::OnAckCallComplete(std::vector<scada::EventId> event_ids,
+                                      const scada::Status& status,
+                                      bool window_full,
+                                      scada::base::TimeDelta duration) {
+  if (status) {
+    const size_t old_window = window_;
+    if (duration > kTargetCallDuration) {
+      window_ = std::max(kMinWindow, window_ / 2);
+    } else if (window_full && duration * 2 < kTargetCallDuration) {
+      window_ = std::min(kMaxWindow, window_ * 2);
+    }
+    if (window_ != old_window) {
+      LOG_INFO(*logger_) << std::format(
+          "Acknowledge window changed from {} to {} after {} ms", old_window,
+          window_, duration.InMilliseconds());
+    }
+    PostAckPendingEvents();
+    return;
+  }
+
+  if (event_ids.size() > 1 && IsBatchRejected(status)) {
+    // The server accepts a single event per call only. Retry the events one
+    // by one, ahead of the rest.
+    if (batching_) {
+      LOG_WARNING(*logger_) << std::format(
+          "Batched acknowledge failed, falling back to one event per call: {}",
+          ToString(status));
+      batching_ = false;
+    }
+    for (auto ack_id : event_ids | std::views::reverse) {
+      if (running_ack_event_ids_.erase(ack_id) &&
+          queued_ack_event_ids_.insert(ack_id).second) {
+        pending_ack_event_ids_.push_front(ack_id);
+      }
+    }
+    PostAckPendingEvents();
+    return;
+  }
+
+  // Give up on the events, so the queue doesn't stay busy forever.
+  LOG_WARNING(*logger_) << std::format("Acknowledge of events {} failed: {}",
+                                       scada::base::AsList(event_ids),
+                                       ToString(status));
+  for (auto ack_id : event_ids) {
+    if (running_ack_event_ids_.erase(ack_id))
+      CompleteAck();
+  }
+  PostAckPendingEvents();
+}
+
 void EventAckQueue::Ack(scada::EventId ack_id) {
   if (running_ack_event_ids_.contains(ack_id) ||
-      std::ranges::find(pending_ack_event_ids_, ack_id) !=
-          pending_ack_event_ids_.end())
+      !queued_ack_event_ids_.insert(ack_id).second)
     return;
 
   pending_ack_event_ids_.push_back(ack_id);
+  ++progress_.requested;
   PostAckPendingEvents();
 }
+
+void EventAckQueue::Ack(std::span<const scada::EventId> ack_ids) {
+  for (auto ack_id : ack_ids)
+    Ack(ack_id);
+}
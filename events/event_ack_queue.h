@@ -4,13 +4,18 @@
 
 #include "base/awaitable.h"
 #include "base/boost_log.h"
+#include "events/node_event_provider.h"
+#include "scada/date_time.h"
 #include "scada/event.h"
 #include "scada/service_context.h"
+#include "scada/status.h"
 
 #include <algorithm>
 #include <deque>
 #include <memory>
-#include <set>
+#include <span>
+#include <unordered_set>
+#include <vector>
 
 namespace scada {
 class MethodService;
@@ -22,6 +27,12 @@ struct EventAckQueueContext {
   scada::MethodService& method_service_;
 };
 
+// Acknowledges events through the server's Acknowledge method. Pending event
+// IDs are packed into as few calls as the window allows; the window - the
+// number of events awaiting confirmation - grows while calls complete fast and
+// shrinks when they get slow. If the server rejects a multi-event call as
+// unsupported, the queue falls back to one event per call until the channel is
+// reopened or the queue is reset; other failures don't stop batching.
 class EventAckQueue : private EventAckQueueContext {
  public:
   explicit EventAckQueue(EventAckQueueContext&& context);
@@ -33,13 +44,18 @@ class EventAckQueue : private EventAckQueueContext {
   // enforce the Call permission against them rather than a system identity.
   void OnChannelOpened(const scada::ServiceContext& context) {
     service_context_ = context;
+    // The new server may accept batches.
+    batching_ = true;
   }
 
   bool IsAcking() const {
     return !pending_ack_event_ids_.empty() || !running_ack_event_ids_.empty();
   }
 
+  const EventAckProgress& progress() const { return progress_; }
+
   void Ack(scada::EventId ack_id);
+  void Ack(std::span<const scada::EventId> ack_ids);
 
   // Acknowledge confirmation.
   void OnAcked(scada::EventId acknowledge_id);
@@ -47,26 +63,49 @@ class EventAckQueue : private EventAckQueueContext {
   void Reset() {
     running_ack_event_ids_.clear();
     pending_ack_event_ids_.clear();
+    queued_ack_event_ids_.clear();
+    progress_ = {};
+    batching_ = true;
   }
 
+  // Diagnostics.
+  size_t window() const { return window_; }
+  bool batching() const { return batching_; }
+
  private:
   void AckPendingEvents();
   void PostAckPendingEvents();
 
+  void OnAckCallComplete(std::vector<scada::EventId> event_ids,
+                         const scada::Status& status,
+                         bool window_full,
+                         scada::base::TimeDelta duration);
+
+  void CompleteAck();
+
   using EventIdQueue = std::deque<scada::EventId>;
   EventIdQueue pending_ack_event_ids_;
 
-  // Consider using `unordered_set`.
-  using EventIdSet = std::set<scada::EventId>;
+  // The contents of `pending_ack_event_ids_`, for duplicate checks.
+  using EventIdSet = std::unordered_set<scada::EventId>;
+  EventIdSet queued_ack_event_ids_;
+
   EventIdSet running_ack_event_ids_;
 
   bool ack_pending_ = false;
 
+  size_t window_ = kInitialWindow;
+  bool batching_ = true;
+
+  EventAckProgress progress_;
+
   // Acknowledging user's service context (user id + rights), captured when the
   // channel opens.
   scada::ServiceContext service_context_;
 
   Cancelation cancelation_;
 
-  static const size_t kMaxParallelAcks = 5;
+  static constexpr size_t kInitialWindow = 5;
+  static constexpr size_t kMinWindow = 1;
+  static constexpr size_t kMaxWindow = 1000;
 };
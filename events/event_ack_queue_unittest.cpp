@@ -118,3 +118,120 @@ TEST_F(EventAckQueueTest, DestroyedQueueSuppressesPendingAckDispatch) {
 
   DrainExecutor();
 }
+
+TEST_F(EventAckQueueTest, FastFullCallGrowsWindow) {
+  auto queue = MakeQueue();
+  const size_t initial_window = queue.window();
+
+  EXPECT_CALL(method_service_, Call(_, _, _, _))
+      .WillOnce(
+          Invoke([](auto, auto, auto, auto) { return MakeStatusAwaitable(); }));
+
+  for (scada::EventId event_id = 1; event_id <= initial_window; ++event_id)
+    queue.Ack(event_id);
+  DrainExecutor();
+
+  EXPECT_EQ(queue.window(), initial_window * 2);
+}
+
+TEST_F(EventAckQueueTest, RejectedBatchFallsBackToSingleEventCalls) {
+  auto queue = MakeQueue();
+
+  InSequence sequence;
+  EXPECT_CALL(
+      method_service_,
+      Call(_, _, ArgumentsContainEventIds(std::vector<scada::EventId>{1, 2}),
+           _))
+      .WillOnce(Invoke([](auto, auto, auto, auto) {
+        return MakeStatusAwaitable(scada::StatusCode::Bad_WrongCallArguments);
+      }));
+  EXPECT_CALL(
+      method_service_,
+      Call(_, _, ArgumentsContainEventIds(std::vector<scada::EventId>{1}), _))
+      .WillOnce(
+          Invoke([](auto, auto, auto, auto) { return MakeStatusAwaitable(); }));
+  EXPECT_CALL(
+      method_service_,
+      Call(_, _, ArgumentsContainEventIds(std::vector<scada::EventId>{2}), _))
+      .WillOnce(
+          Invoke([](auto, auto, auto, auto) { return MakeStatusAwaitable(); }));
+
+  queue.Ack(std::vector<scada::EventId>{1, 2});
+  DrainExecutor();
+
+  EXPECT_FALSE(queue.batching());
+  EXPECT_TRUE(queue.IsAcking());
+}
+
+TEST_F(EventAckQueueTest, TransientBatchFailureKeepsBatching) {
+  auto queue = MakeQueue();
+
+  InSequence sequence;
+  EXPECT_CALL(
+      method_service_,
+      Call(_, _, ArgumentsContainEventIds(std::vector<scada::EventId>{1, 2}),
+           _))
+      .WillOnce(Invoke([](auto, auto, auto, auto) {
+        return MakeStatusAwaitable(scada::StatusCode::Bad_Timeout);
+      }));
+  EXPECT_CALL(
+      method_service_,
+      Call(_, _, ArgumentsContainEventIds(std::vector<scada::EventId>{3, 4}),
+           _))
+      .WillOnce(
+          Invoke([](auto, auto, auto, auto) { return MakeStatusAwaitable(); }));
+
+  queue.Ack(std::vector<scada::EventId>{1, 2});
+  DrainExecutor();
+
+  // The failed events are given up on, as a failed single-event call is.
+  EXPECT_TRUE(queue.batching());
+  EXPECT_FALSE(queue.IsAcking());
+
+  queue.Ack(std::vector<scada::EventId>{3, 4});
+  DrainExecutor();
+
+  EXPECT_TRUE(queue.batching());
+  EXPECT_TRUE(queue.IsAcking());
+}
+
+TEST_F(EventAckQueueTest, ReopenedChannelResumesBatching) {
+  auto queue = MakeQueue();
+
+  EXPECT_CALL(method_service_, Call(_, _, _, _))
+      .WillOnce(Invoke([](auto, auto, auto, auto) {
+        return MakeStatusAwaitable(scada::StatusCode::Bad_NotSupported);
+      }))
+      .WillRepeatedly(
+          Invoke([](auto, auto, auto, auto) { return MakeStatusAwaitable(); }));
+
+  queue.Ack(std::vector<scada::EventId>{1, 2});
+  DrainExecutor();
+  ASSERT_FALSE(queue.batching());
+
+  queue.OnChannelOpened(
+      scada::ServiceContext{}.with_user_id(scada::NodeId{scada::id::Server}));
+  EXPECT_TRUE(queue.batching());
+}
+
+TEST_F(EventAckQueueTest, ProgressCountsConfirmedEvents) {
+  auto queue = MakeQueue();
+
+  EXPECT_CALL(method_service_, Call(_, _, _, _))
+      .WillOnce(
+          Invoke([](auto, auto, auto, auto) { return MakeStatusAwaitable(); }));
+
+  queue.Ack(std::vector<scada::EventId>{1, 2});
+  DrainExecutor();
+  EXPECT_EQ(queue.progress(),
+            (EventAckProgress{.requested = 2, .completed = 0}));
+
+  queue.OnAcked(1);
+  EXPECT_EQ(queue.progress(),
+            (EventAckProgress{.requested = 2, .completed = 1}));
+
+  // Back to idle.
+  queue.OnAcked(2);
+  EXPECT_FALSE(queue.IsAcking());
+  EXPECT_EQ(queue.progress(), EventAckProgress{});
+}
@@ -42,7 +42,7 @@ EventFetcher::EventFetcher(EventFetcherContext&& context)
                 // Events arrive from a (possibly remote) server; payloads of
                 // an unexpected type are ignored.
                 if (auto* system_event = std::any_cast<scada::Event>(&event)) {
-                  OnSystemEvents({system_event, 1});
+                  QueueSystemEvent(std::move(*system_event));
                 }
               }
               co_return;
@@ -121,18 +121,42 @@ void EventFetcher::OnSystemEvents(std::span<const scada::Event> events) {
   }
 }
 
+void EventFetcher::QueueSystemEvent(scada::Event event) {
+  queued_system_events_.emplace_back(std::move(event));
+  if (queued_system_events_.size() != 1)
+    return;
+
+  CoSpawn(executor_, cancelation_, [this]() -> Awaitable<void> {
+    FlushSystemEvents();
+    co_return;
+  });
+}
+
+void EventFetcher::FlushSystemEvents() {
+  auto events = std::move(queued_system_events_);
+  queued_system_events_.clear();
+  OnSystemEvents(events);
+}
+
 bool EventFetcher::IsAcking() const {
   return event_ack_queue_.IsAcking();
 }
 
+EventAckProgress EventFetcher::GetAckProgress() const {
+  return event_ack_queue_.progress();
+}
+
 void EventFetcher::AcknowledgeItemEvents(const scada::NodeId& node_id) {
   const EventSet* events = GetItemUnackedEvents(node_id);
   if (!events)
     return;
 
-  for (auto* event : *events) {
-    AcknowledgeEvent(event->event_id);
-  }
+  auto event_ids = *events |
+                   std::views::transform([](const scada::Event* event) {
+                     return event->event_id;
+                   }) |
+                   to_vector;
+  event_ack_queue_.Ack(event_ids);
 }
 
 void EventFetcher::AcknowledgeEvent(scada::EventId ack_id) {
@@ -140,9 +164,8 @@ void EventFetcher::AcknowledgeEvent(scada::EventId ack_id) {
 }
 
 void EventFetcher::AcknowledgeAllEvents() {
-  for (const auto& event : event_storage_.events() | std::views::values) {
-    AcknowledgeEvent(event.event_id);
-  }
+  auto event_ids = event_storage_.events() | std::views::keys | to_vector;
+  event_ack_queue_.Ack(event_ids);
 }
 
 void EventFetcher::Update() {
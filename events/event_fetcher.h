@@ -1,6 +1,7 @@
 #pragma once
 
 #include <span>
+#include <vector>
 
 #include "base/any_executor.h"
 #include "base/boost_log.h"
@@ -50,6 +51,7 @@ class EventFetcher : public NodeEventProvider, private EventFetcherContext {
       const scada::NodeId& node_id) const override;
   virtual void AcknowledgeEvent(scada::EventId ack_id) override;
   virtual bool IsAcking() const override;
+  virtual EventAckProgress GetAckProgress() const override;
   virtual bool IsAlerting(const scada::NodeId& node_id) const override;
   virtual void AddObserver(EventObserver& observer) override;
   virtual void RemoveObserver(EventObserver& observer) override;
@@ -64,6 +66,11 @@ class EventFetcher : public NodeEventProvider, private EventFetcherContext {
   void Update();
 
   void OnSystemEvents(std::span<const scada::Event> events);
+
+  // Queues a live event. Events queued before the flush runs reach the storage
+  // as one update, so an alarm burst notifies each node once.
+  void QueueSystemEvent(scada::Event event);
+  void FlushSystemEvents();
   void OnHistoryReadEventsComplete(scada::HistoryReadEventsResult&& result);
 
   bool connected_ = false;
@@ -77,6 +84,8 @@ class EventFetcher : public NodeEventProvider, private EventFetcherContext {
 
   scada::EventSeverity severity_min_ = scada::kSeverityMin;
 
+  std::vector<scada::Event> queued_system_events_;
+
   // Used to cancel the historical request.
   Cancelation cancelation_;
 };
@@ -2,7 +2,8 @@
 
 #include "scada/event.h"
 
-#include <set>
+#include <algorithm>
+#include <vector>
 
 struct EventComparer {
   bool operator()(const scada::Event* left, const scada::Event* right) const {
@@ -14,5 +15,53 @@ struct EventComparer {
   }
 };
 
-class EventSet : public std::set<const scada::Event*, EventComparer> {
+// Events of one node, sorted by time. Kept flat: events mostly arrive in time
+// order, so inserts append, and observers only iterate the set or check it for
+// emptiness.
+class EventSet {
+ public:
+  using value_type = const scada::Event*;
+  using const_iterator = std::vector<const scada::Event*>::const_iterator;
+  using iterator = const_iterator;
+
+  bool empty() const { return events_.empty(); }
+  size_t size() const { return events_.size(); }
+
+  const_iterator begin() const { return events_.begin(); }
+  const_iterator end() const { return events_.end(); }
+
+  bool contains(const scada::Event* event) const {
+    auto i = std::ranges::lower_bound(events_, event, EventComparer{});
+    return i != events_.end() && *i == event;
+  }
+
+  // Returns false if `event` is already present.
+  bool insert(const scada::Event* event) {
+    if (events_.empty() || EventComparer{}(events_.back(), event)) {
+      events_.emplace_back(event);
+      return true;
+    }
+
+    auto i = std::ranges::lower_bound(events_, event, EventComparer{});
+    if (i != events_.end() && *i == event)
+      return false;
+
+    events_.insert(i, event);
+    return true;
+  }
+
+  // `event` must have the time it was inserted with.
+  bool erase(const scada::Event* event) {
+    auto i = std::ranges::lower_bound(events_, event, EventComparer{});
+    if (i == events_.end() || *i != event)
+      return false;
+
+    events_.erase(i);
+    return true;
+  }
+
+  void clear() { events_.clear(); }
+
+ private:
+  std::vector<const scada::Event*> events_;
 };
@@ -11,25 +11,23 @@ import scada.core;
 #include "base/check.h"
 #endif
 
+EventStorage::~EventStorage() {
+  scada::base::Check(batch_depth_ == 0);
+}
+
 const scada::Event* EventStorage::Add(const scada::Event& event) {
   auto [iter, inserted] = events_.try_emplace(event.event_id, event);
   scada::Event& contained_event = iter->second;
 
   // Replace old event on update.
   if (!inserted) {
-    // Events arrive from a (possibly remote) server; a node-id change for an
-    // existing event id is tolerated by replacing the stored event.
+    // Events arrive from a (possibly remote) server; a node-id or time change
+    // for an existing event id is tolerated by re-indexing the stored event.
+    UnindexEvent(contained_event);
     contained_event = event;
   }
 
-  if (inserted && !event.source_node_id.is_null()) {
-    NodeEntry& entry = node_events_[event.source_node_id];
-    entry.events.insert(&contained_event);
-    NodeEventsChanged(observers_, event.source_node_id, entry.events);
-    NodeEventsChanged(entry.observers, event.source_node_id, entry.events);
-  }
-
-  UpdateAlerting();
+  IndexEvent(contained_event);
 
   return &contained_event;
 }
@@ -41,61 +39,104 @@ EventStorage::EventContainer::node_type EventStorage::Remove(
     return {};
 
   scada::Event& contained_event = i->second;
+  UnindexEvent(contained_event);
+
   // Update fields of contained event before notification to observers.
   contained_event = event;
 
-  if (!contained_event.source_node_id.is_null()) {
-    auto p = node_events_.find(contained_event.source_node_id);
-    if (p != node_events_.end()) {
-      NodeEntry& entry = p->second;
+  return events_.extract(i);
+}
 
-      auto j = entry.events.find(&contained_event);
-      scada::base::Check(j != entry.events.end());
-      entry.events.erase(j);
+void EventStorage::IndexEvent(const scada::Event& event) {
+  if (event.source_node_id.is_null())
+    return;
 
-      NodeEventsChanged(observers_, contained_event.source_node_id, entry.events);
-      NodeEventsChanged(entry.observers, contained_event.source_node_id, entry.events);
+  NodeEntry& entry = node_events_[event.source_node_id];
+  entry.events.insert(&event);
+  if (!entry.changed) {
+    entry.changed = true;
+    changed_nodes_.emplace_back(event.source_node_id);
+  }
+}
 
-      if (entry.events.empty() && entry.observers.empty()) {
-        node_events_.erase(p);
-      }
-    }
+void EventStorage::UnindexEvent(const scada::Event& event) {
+  if (event.source_node_id.is_null())
+    return;
+
+  auto p = node_events_.find(event.source_node_id);
+  if (p == node_events_.end())
+    return;
+
+  NodeEntry& entry = p->second;
+  scada::base::Check(entry.events.erase(&event));
+  if (!entry.changed) {
+    entry.changed = true;
+    changed_nodes_.emplace_back(event.source_node_id);
   }
+}
 
-  auto node = events_.extract(i);
+void EventStorage::NotifyChangedNodes() {
+  // Observers may add or remove node observers while being notified, so
+  // entries are looked up by ID each time.
+  auto changed_nodes = std::move(changed_nodes_);
+  changed_nodes_.clear();
+
+  for (const auto& node_id : changed_nodes) {
+    auto p = node_events_.find(node_id);
+    if (p == node_events_.end())
+      continue;
+    p->second.changed = false;
+    NodeEventsChanged(observers_, node_id, p->second.events);
+  }
 
-  UpdateAlerting();
+  for (const auto& node_id : changed_nodes) {
+    auto p = node_events_.find(node_id);
+    if (p == node_events_.end())
+      continue;
+    NodeEventsChanged(p->second.observers, node_id, p->second.events);
+  }
 
-  return node;
+  for (const auto& node_id : changed_nodes) {
+    auto p = node_events_.find(node_id);
+    if (p != node_events_.end() && p->second.events.empty() &&
+        p->second.observers.empty()) {
+      node_events_.erase(p);
+    }
+  }
 }
 
 void EventStorage::Clear() {
+  auto batch = BeginUpdate();
+
   for (auto i = node_events_.begin(); i != node_events_.end();) {
-    auto& node_id = i->first;
     NodeEntry& entry = i->second;
 
     if (entry.observers.empty()) {
-      node_events_.erase(i++);
+      i = node_events_.erase(i);
 
     } else {
+      if (!entry.events.empty() && !entry.changed) {
+        entry.changed = true;
+        changed_nodes_.emplace_back(i->first);
+      }
       entry.events.clear();
-      NodeEventsChanged(observers_, node_id, entry.events);
-      NodeEventsChanged(entry.observers, node_id, entry.events);
       ++i;
     }
   }
 
-  events_.clear();
-
-  UpdateAlerting();
+  if (notify_events_.empty()) {
+    events_.clear();
+  } else {
+    // Keep the events the open batch is yet to report.
+    while (!events_.empty())
+      deleted_nodes_.emplace_back(events_.extract(events_.begin()));
+  }
 }
 
 void EventStorage::Update(std::span<const scada::Event> events) {
-  // WARNING: Observers rely on stored event pointers. When event is deleted
-  // from the storage it must be preserved while observers process the message.
-  std::vector<EventContainer::node_type> deleted_nodes;
+  auto batch = BeginUpdate();
 
-  std::vector<const scada::Event*> notify_events;
+  notify_events_.reserve(notify_events_.size() + events.size());
 
   for (auto& event : events) {
     if (event.acked) {
@@ -103,15 +144,32 @@ void EventStorage::Update(std::span<const scada::Event> events) {
         // Observers must be notified with updates events, having `acked` flag
         // set.
         node.mapped() = event;
-        notify_events.emplace_back(&node.mapped());
-        deleted_nodes.emplace_back(std::move(node));
+        notify_events_.emplace_back(&node.mapped());
+        deleted_nodes_.emplace_back(std::move(node));
       }
     } else {
       if (auto* added_event = Add(event)) {
-        notify_events.emplace_back(added_event);
+        notify_events_.emplace_back(added_event);
       }
     }
   }
+}
+
+void EventStorage::EndBatch() {
+  scada::base::Check(batch_depth_ > 0);
+  if (--batch_depth_ == 0)
+    Flush();
+}
+
+void EventStorage::Flush() {
+  // Observers may start a nested update; it flushes on its own.
+  auto notify_events = std::move(notify_events_);
+  notify_events_.clear();
+  auto deleted_nodes = std::move(deleted_nodes_);
+  deleted_nodes_.clear();
+
+  NotifyChangedNodes();
+  UpdateAlerting();
 
   // Notify observers about new events.
   if (!notify_events.empty()) {
@@ -4,16 +4,65 @@
 #include "events/event_set.h"
 #include "events/node_event_provider.h"
 
-#include <map>
 #include <set>
 #include <span>
+#include <unordered_map>
+#include <vector>
 
 // Stores unacked events. Provides are way for observers to subscribe for all
 // updates or per node IDs.
+//
+// Observers are notified once per `Update`: one `OnItemEventsChanged` per
+// affected node and one `OnEvents` for the whole batch, so an alarm flood
+// doesn't fan out per event. To coalesce several updates, hold a BeginUpdate()
+// scope around them.
 class EventStorage {
  public:
   using EventContainer = NodeEventProvider::EventContainer;
 
+  EventStorage() = default;
+  ~EventStorage();
+
+  EventStorage(const EventStorage&) = delete;
+  EventStorage& operator=(const EventStorage&) = delete;
+
+  // Defers observer notifications while it is alive and emits them, once per
+  // touched node, when the outermost scope ends. Nesting is ref-counted.
+  class [[nodiscard]] ScopedUpdateBatch {
+   public:
+    ScopedUpdateBatch() = default;
+    explicit ScopedUpdateBatch(EventStorage* storage) : storage_{storage} {
+      if (storage_)
+        ++storage_->batch_depth_;
+    }
+    ScopedUpdateBatch(ScopedUpdateBatch&& other) noexcept
+        : storage_{other.storage_} {
+      other.storage_ = nullptr;
+    }
+    ScopedUpdateBatch& operator=(ScopedUpdateBatch&& other) noexcept {
+      if (this != &other) {
+        Close();
+        storage_ = other.storage_;
+        other.storage_ = nullptr;
+      }
+      return *this;
+    }
+    ~ScopedUpdateBatch() { Close(); }
+
+   private:
+    void Close() {
+      if (storage_) {
+        storage_->EndBatch();
+        storage_ = nullptr;
+      }
+    }
+    EventStorage* storage_ = nullptr;
+  };
+
+  ScopedUpdateBatch BeginUpdate() SCADA_LIFETIME_BOUND {
+    return ScopedUpdateBatch{this};
+  }
+
   const EventContainer& events() const SCADA_LIFETIME_BOUND { return events_; }
 
   const EventSet* GetNodeEvents(const scada::NodeId& node_id) const
@@ -46,11 +95,25 @@ class EventStorage {
   struct NodeEntry {
     EventSet events;
     ObserverSet observers;
+    // Queued in `changed_nodes_` for the current update.
+    bool changed = false;
   };
 
   const scada::Event* Add(const scada::Event& event) SCADA_LIFETIME_BOUND;
   EventContainer::node_type Remove(const scada::Event& event);
 
+  void IndexEvent(const scada::Event& event);
+  void UnindexEvent(const scada::Event& event);
+
+  void EndBatch();
+
+  // Emits the notifications collected by the finished batch.
+  void Flush();
+
+  // Notifies node observers of `changed_nodes_` and drops entries left with
+  // neither events nor observers.
+  void NotifyChangedNodes();
+
   // This should be in an observer class.
   void UpdateAlerting();
 
@@ -60,8 +123,18 @@ class EventStorage {
 
   EventContainer events_;
 
-  // TODO: Consider using `unordered_map`.
-  std::map<scada::NodeId, NodeEntry> node_events_;
+  std::unordered_map<scada::NodeId, NodeEntry> node_events_;
+
+  int batch_depth_ = 0;
+
+  std::vector<scada::NodeId> changed_nodes_;
+
+  // Added, updated and acked events for the pending `OnEvents`.
+  std::vector<const scada::Event*> notify_events_;
+
+  // WARNING: Observers rely on stored event pointers. Events deleted from the
+  // storage are kept here until observers have processed the batch.
+  std::vector<EventContainer::node_type> deleted_nodes_;
 
   ObserverSet observers_;
 
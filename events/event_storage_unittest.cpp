@@ -0,0 +1,146 @@
+#include "events/event_storage.h"
+
+#include "events/event_observer.h"
+
+#include <gmock/gmock.h>
+
+#include <vector>
+
+using namespace testing;
+
+namespace {
+
+class CountingEventObserver final : public EventObserver {
+ public:
+  void OnEvents(std::span<const scada::Event* const> events) override {
+    ++events_call_count;
+    event_count += events.size();
+  }
+
+  void OnItemEventsChanged(const scada::NodeId& item_id,
+                           const EventSet& events) override {
+    ++item_call_count;
+    last_item_event_count = events.size();
+  }
+
+  int events_call_count = 0;
+  size_t event_count = 0;
+  int item_call_count = 0;
+  size_t last_item_event_count = 0;
+};
+
+const scada::NodeId kNodeId1{1, 1};
+const scada::NodeId kNodeId2{2, 1};
+
+scada::Event MakeEvent(scada::EventId event_id,
+                       const scada::NodeId& node_id,
+                       int seconds,
+                       bool acked = false) {
+  scada::Event event;
+  event.event_id = event_id;
+  event.source_node_id = node_id;
+  event.time =
+      scada::DateTime::UnixEpoch() + scada::base::TimeDelta::FromSeconds(seconds);
+  event.acked = acked;
+  return event;
+}
+
+}  // namespace
+
+TEST(EventStorage, NotifiesOncePerUpdate) {
+  EventStorage storage;
+  CountingEventObserver observer;
+  CountingEventObserver node_observer;
+  storage.AddObserver(observer);
+  storage.AddNodeObserver(kNodeId1, node_observer);
+
+  std::vector<scada::Event> events;
+  for (int i = 1; i <= 100; ++i)
+    events.emplace_back(MakeEvent(i, i % 2 ? kNodeId1 : kNodeId2, i));
+  storage.Update(events);
+
+  EXPECT_EQ(observer.events_call_count, 1);
+  EXPECT_EQ(observer.event_count, 100u);
+  // One call per affected node.
+  EXPECT_EQ(observer.item_call_count, 2);
+  EXPECT_EQ(node_observer.item_call_count, 1);
+  EXPECT_EQ(node_observer.last_item_event_count, 50u);
+  EXPECT_TRUE(storage.alerting());
+
+  for (auto& event : events)
+    event.acked = true;
+  storage.Update(events);
+
+  EXPECT_EQ(observer.events_call_count, 2);
+  EXPECT_EQ(node_observer.item_call_count, 2);
+  EXPECT_EQ(node_observer.last_item_event_count, 0u);
+  EXPECT_TRUE(storage.events().empty());
+  EXPECT_FALSE(storage.alerting());
+  // The observed node keeps its entry, the other one is dropped.
+  EXPECT_NE(storage.GetNodeEvents(kNodeId1), nullptr);
+  EXPECT_EQ(storage.GetNodeEvents(kNodeId2), nullptr);
+}
+
+TEST(EventStorage, NodeEventsAreSortedByTime) {
+  EventStorage storage;
+
+  storage.Update(std::vector{MakeEvent(1, kNodeId1, 30),
+                             MakeEvent(2, kNodeId1, 10),
+                             MakeEvent(3, kNodeId1, 20)});
+
+  const EventSet* events = storage.GetNodeEvents(kNodeId1);
+  ASSERT_NE(events, nullptr);
+  std::vector<scada::EventId> event_ids;
+  for (const auto* event : *events)
+    event_ids.emplace_back(event->event_id);
+  EXPECT_THAT(event_ids, ElementsAre(2, 3, 1));
+}
+
+TEST(EventStorage, EventsAreOrderedById) {
+  EventStorage storage;
+
+  storage.Update(std::vector{MakeEvent(3, kNodeId1, 10),
+                             MakeEvent(1, kNodeId2, 20),
+                             MakeEvent(2, kNodeId1, 30)});
+
+  std::vector<scada::EventId> event_ids;
+  for (const auto& [event_id, event] : storage.events())
+    event_ids.emplace_back(event_id);
+  EXPECT_THAT(event_ids, ElementsAre(1, 2, 3));
+}
+
+TEST(EventStorage, UpdatedEventMovesBetweenNodes) {
+  EventStorage storage;
+
+  storage.Update(std::vector{MakeEvent(1, kNodeId1, 10)});
+  storage.Update(std::vector{MakeEvent(1, kNodeId2, 20)});
+
+  EXPECT_EQ(storage.GetNodeEvents(kNodeId1), nullptr);
+  const EventSet* events = storage.GetNodeEvents(kNodeId2);
+  ASSERT_NE(events, nullptr);
+  EXPECT_EQ(events->size(), 1u);
+  EXPECT_EQ(storage.events().size(), 1u);
+}
+
+TEST(EventStorage, UpdateBatchCoalescesUpdates) {
+  EventStorage storage;
+  CountingEventObserver observer;
+  CountingEventObserver node_observer;
+  storage.AddObserver(observer);
+  storage.AddNodeObserver(kNodeId1, node_observer);
+
+  {
+    auto batch = storage.BeginUpdate();
+    for (int i = 1; i <= 10; ++i)
+      storage.Update(std::vector{MakeEvent(i, kNodeId1, i)});
+    storage.Update(std::vector{MakeEvent(3, kNodeId1, 3, /*acked=*/true)});
+
+    EXPECT_EQ(observer.events_call_count, 0);
+    EXPECT_EQ(node_observer.item_call_count, 0);
+  }
+
+  EXPECT_EQ(observer.events_call_count, 1);
+  EXPECT_EQ(observer.event_count, 11u);
+  EXPECT_EQ(node_observer.item_call_count, 1);
+  EXPECT_EQ(node_observer.last_item_event_count, 9u);
+}
@@ -12,6 +12,14 @@ class NodeId;
 class EventObserver;
 class EventSet;
 
+// Progress of the acknowledgements requested since the provider was last idle.
+struct EventAckProgress {
+  size_t requested = 0;
+  size_t completed = 0;
+
+  bool operator==(const EventAckProgress&) const = default;
+};
+
 class NodeEventProvider {
  public:
   virtual ~NodeEventProvider() = default;
@@ -30,6 +38,8 @@ class NodeEventProvider {
   virtual void AcknowledgeAllEvents() = 0;
 
   virtual bool IsAcking() const = 0;
+  // Providers that do not track acknowledgements report no progress.
+  virtual EventAckProgress GetAckProgress() const { return {}; }
   virtual bool IsAlerting(const scada::NodeId& item_id) const = 0;
 
   virtual void AddObserver(EventObserver& observer) = 0;
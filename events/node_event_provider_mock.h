@@ -32,6 +32,7 @@ class MockNodeEventProvider : public NodeEventProvider {
   MOCK_METHOD(void, AcknowledgeAllEvents, (), (override));
 
   MOCK_METHOD(bool, IsAcking, (), (const override));
+  MOCK_METHOD(EventAckProgress, GetAckProgress, (), (const override));
   MOCK_METHOD(bool,
               IsAlerting,
               (const scada::NodeId& node_id),
@@ -37,6 +37,7 @@ export {
   using ::EventObserver;
 
   // event_set.h / event_storage.h / node_event_provider.h
+  using ::EventAckProgress;
   using ::EventComparer;
   using ::EventSet;
   using ::EventStorage;
@@ -0,0 +1,49 @@
+// Build-time tool: compiles the static nodesets into the precompiled binary
+// image servers load instead of the XML (see address_space/nodeset_image.h).
+//
+//   compile_nodeset_image --nodesets <dir> --out <image>
+//
+// Reads the files listed in kScadaStaticNodesetFiles from --nodesets, in that
+// order. Built and run from address_space/CMakeLists.txt, since it reuses the
+// address-space nodeset parser; it lives here next to the header generator as
+// the other half of the model build step.
+
+#include "address_space/nodeset_image.h"
+#include "model/static_nodesets.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+  std::filesystem::path nodesets_dir;
+  std::filesystem::path out_path;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string_view name = argv[i];
+    if (name == "--nodesets") {
+      nodesets_dir = argv[i + 1];
+    } else if (name == "--out") {
+      out_path = argv[i + 1];
+    }
+  }
+  if (nodesets_dir.empty() || out_path.empty()) {
+    std::cerr << "usage: compile_nodeset_image --nodesets <dir> --out <image>"
+              << std::endl;
+    return 2;
+  }
+
+  std::vector<std::filesystem::path> paths;
+  for (const auto& name : scada::kScadaStaticNodesetFiles) {
+    paths.push_back(nodesets_dir / name);
+  }
+
+  if (auto status = scada::CompileNodesetImage(paths, out_path); !status) {
+    std::cerr << "compile_nodeset_image: can't compile " << nodesets_dir
+              << " into " << out_path << ": " << ToString(status) << std::endl;
+    return 1;
+  }
+
+  std::cout << "compiled: " << out_path.filename().string() << std::endl;
+  return 0;
+}
@@ -49,6 +49,7 @@ export namespace scada {
 using scada::GetScadaStaticNodesetSourceDir;
 using scada::GetScadaStaticNodesetSourcePaths;
 using scada::kScadaStaticNodesetFiles;
+using scada::kScadaStaticNodesetImageFile;
 
 }  // namespace scada
 
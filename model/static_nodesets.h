@@ -22,6 +22,12 @@ inline constexpr std::array<std::string_view, 2> kScadaStaticNodesetFiles = {
     "Scada.NodeSet2.xml",
 };
 
+// The precompiled image of the files above (see
+// address_space/nodeset_image.h), built next to them by the model build and
+// shipped with them, for servers to load instead of the XML.
+inline constexpr std::string_view kScadaStaticNodesetImageFile =
+    "scada_static_nodesets.bin";
+
 // Absolute path to the committed nodeset source directory in the server source
 // tree (resolved via the translation unit location). Intended for tests, tools,
 // and build steps that copy the files into a deployment data directory. Runtime
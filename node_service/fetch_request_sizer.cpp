@@ -0,0 +1,79 @@
+#include "node_service/fetch_request_sizer.h"
+
+#include <algorithm>
+
+namespace {
+
+// The baseline follows slower responses this slowly, so a route change is
+// picked up eventually while a single slow response is not.
+const int kBaseDurationDecay = 16;
+
+}  // namespace
+
+FetchRequestSizer::FetchRequestSizer(const FetchRequestSizerOptions& options)
+    : options_{options} {
+  state_.node_count = options_.initial_node_count;
+  state_.parallel_request_count = options_.initial_parallel_request_count;
+}
+
+scada::base::TimeDelta FetchRequestSizer::GetTolerance() const {
+  return std::max(options_.tolerance,
+                  state_.base_duration * options_.tolerance_percent / 100);
+}
+
+void FetchRequestSizer::OnRequestCompleted(size_t node_count,
+                                           scada::base::TimeDelta duration,
+                                           bool succeeded) {
+  ++state_.completed_request_count;
+  state_.last_duration = duration;
+
+  if (!succeeded) {
+    ++state_.failed_request_count;
+    state_.node_count =
+        std::max(options_.min_node_count, state_.node_count / 2);
+    return;
+  }
+
+  // The baseline is kept for full requests only. A smaller request is fast
+  // for its size alone and would set it too low, so that full requests look
+  // congested.
+  const bool full = node_count >= state_.node_count;
+  if (full) {
+    if (!has_base_duration_ || duration < state_.base_duration) {
+      has_base_duration_ = true;
+      state_.base_duration = duration;
+    } else {
+      state_.base_duration +=
+          (duration - state_.base_duration) / kBaseDurationDecay;
+    }
+  }
+
+  if (!has_base_duration_)
+    return;
+
+  const auto tolerance = GetTolerance();
+
+  // Much slower than a full request means requests queue up, whatever their
+  // size.
+  if (duration > state_.base_duration * 2 + tolerance) {
+    state_.node_count =
+        std::max(options_.min_node_count, state_.node_count / 2);
+    state_.parallel_request_count =
+        std::max(options_.min_parallel_request_count,
+                 state_.parallel_request_count - 1);
+    return;
+  }
+
+  // A request smaller than the limit says nothing about a larger one.
+  if (!full || duration > state_.base_duration + tolerance)
+    return;
+
+  if (state_.node_count < options_.max_node_count) {
+    state_.node_count = std::min(options_.max_node_count,
+                                 state_.node_count + options_.node_count_step);
+  } else {
+    state_.parallel_request_count =
+        std::min(options_.max_parallel_request_count,
+                 state_.parallel_request_count + 1);
+  }
+}
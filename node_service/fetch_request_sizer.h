@@ -0,0 +1,75 @@
+#pragma once
+
+#include "base/time/time.h"
+
+#include <cstddef>
+
+struct FetchRequestSizerOptions {
+  size_t initial_node_count = 100;
+  size_t min_node_count = 10;
+  size_t max_node_count = 1000;
+  // Added to the node count after each fast full request.
+  size_t node_count_step = 10;
+
+  size_t initial_parallel_request_count = 2;
+  size_t min_parallel_request_count = 1;
+  size_t max_parallel_request_count = 8;
+
+  // Slack on top of the baseline duration that still counts as fast. The
+  // larger of the absolute and relative values applies.
+  scada::base::TimeDelta tolerance =
+      scada::base::TimeDelta::FromMilliseconds(50);
+  int tolerance_percent = 50;
+};
+
+// Current state of a `FetchRequestSizer`, for diagnostics.
+struct FetchRequestSizerState {
+  size_t node_count = 0;
+  size_t parallel_request_count = 0;
+  // Fastest recent response to a full request; approximates the link
+  // round-trip time.
+  scada::base::TimeDelta base_duration;
+  scada::base::TimeDelta last_duration;
+  size_t completed_request_count = 0;
+  size_t failed_request_count = 0;
+};
+
+// Tunes the node count per request and the number of requests in flight from
+// measured response times, in the spirit of TCP Vegas.
+//
+// The fastest recent response to a full request - one of the current node
+// count - is taken as the link's round-trip baseline; smaller requests don't
+// move it, as they are faster for their size alone. Full responses that stay
+// near the baseline mean the server keeps up: the node count grows
+// additively, and once it's at its maximum, the parallelism. Responses of any
+// size well above the baseline mean requests queue up on the server: the node
+// count halves and one request in flight is dropped. A failed request halves
+// the node count, as servers reject oversized requests.
+//
+// A high-latency link thus gets large requests, since its baseline is high,
+// while an overloaded server gets small ones.
+class FetchRequestSizer {
+ public:
+  explicit FetchRequestSizer(const FetchRequestSizerOptions& options = {});
+
+  size_t node_count() const { return state_.node_count; }
+  size_t parallel_request_count() const {
+    return state_.parallel_request_count;
+  }
+
+  const FetchRequestSizerState& state() const { return state_; }
+
+  // Reports a completed request for |node_count| nodes.
+  void OnRequestCompleted(size_t node_count,
+                          scada::base::TimeDelta duration,
+                          bool succeeded);
+
+ private:
+  scada::base::TimeDelta GetTolerance() const;
+
+  const FetchRequestSizerOptions options_;
+
+  FetchRequestSizerState state_;
+
+  bool has_base_duration_ = false;
+};
@@ -0,0 +1,101 @@
+#include "node_service/fetch_request_sizer.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using scada::base::TimeDelta;
+
+const FetchRequestSizerOptions kOptions{
+    .initial_node_count = 100,
+    .min_node_count = 10,
+    .max_node_count = 120,
+    .node_count_step = 10,
+    .initial_parallel_request_count = 2,
+    .min_parallel_request_count = 1,
+    .max_parallel_request_count = 4,
+};
+
+}  // namespace
+
+TEST(FetchRequestSizer, FastFullRequestsGrowSizeThenParallelism) {
+  FetchRequestSizer sizer{kOptions};
+
+  const auto duration = TimeDelta::FromMilliseconds(500);
+  sizer.OnRequestCompleted(100, duration, true);
+  EXPECT_EQ(sizer.node_count(), 110u);
+  sizer.OnRequestCompleted(110, duration, true);
+  EXPECT_EQ(sizer.node_count(), 120u);
+  EXPECT_EQ(sizer.parallel_request_count(), 2u);
+
+  sizer.OnRequestCompleted(120, duration, true);
+  EXPECT_EQ(sizer.node_count(), 120u);
+  EXPECT_EQ(sizer.parallel_request_count(), 3u);
+
+  EXPECT_EQ(sizer.state().base_duration, duration);
+  EXPECT_EQ(sizer.state().completed_request_count, 3u);
+}
+
+TEST(FetchRequestSizer, PartialRequestsDontGrow) {
+  FetchRequestSizer sizer{kOptions};
+
+  sizer.OnRequestCompleted(5, TimeDelta::FromMilliseconds(10), true);
+
+  EXPECT_EQ(sizer.node_count(), 100u);
+  EXPECT_EQ(sizer.parallel_request_count(), 2u);
+}
+
+TEST(FetchRequestSizer, PartialRequestDoesNotSetBaseline) {
+  FetchRequestSizer sizer{kOptions};
+
+  // A fast small request followed by a full one of the usual duration.
+  sizer.OnRequestCompleted(5, TimeDelta::FromMilliseconds(10), true);
+  sizer.OnRequestCompleted(100, TimeDelta::FromMilliseconds(500), true);
+
+  EXPECT_EQ(sizer.node_count(), 110u);
+  EXPECT_EQ(sizer.parallel_request_count(), 2u);
+  EXPECT_EQ(sizer.state().base_duration, TimeDelta::FromMilliseconds(500));
+}
+
+TEST(FetchRequestSizer, SlowPartialRequestShrinks) {
+  FetchRequestSizer sizer{kOptions};
+
+  sizer.OnRequestCompleted(100, TimeDelta::FromMilliseconds(100), true);
+  sizer.OnRequestCompleted(5, TimeDelta::FromMilliseconds(1000), true);
+
+  EXPECT_EQ(sizer.node_count(), 55u);
+  EXPECT_EQ(sizer.parallel_request_count(), 1u);
+  EXPECT_EQ(sizer.state().base_duration, TimeDelta::FromMilliseconds(100));
+}
+
+TEST(FetchRequestSizer, SlowRequestShrinks) {
+  FetchRequestSizer sizer{kOptions};
+
+  sizer.OnRequestCompleted(100, TimeDelta::FromMilliseconds(100), true);
+  sizer.OnRequestCompleted(110, TimeDelta::FromMilliseconds(1000), true);
+
+  EXPECT_EQ(sizer.node_count(), 55u);
+  EXPECT_EQ(sizer.parallel_request_count(), 1u);
+}
+
+TEST(FetchRequestSizer, FailureShrinksToMinimum) {
+  FetchRequestSizer sizer{kOptions};
+
+  for (int i = 0; i < 10; ++i)
+    sizer.OnRequestCompleted(sizer.node_count(), TimeDelta{}, false);
+
+  EXPECT_EQ(sizer.node_count(), 10u);
+  EXPECT_EQ(sizer.state().failed_request_count, 10u);
+}
+
+TEST(FetchRequestSizer, HighLatencyLinkKeepsGrowing) {
+  FetchRequestSizer sizer{kOptions};
+
+  // A constant high round-trip time is the baseline, not congestion.
+  const auto duration = TimeDelta::FromSeconds(3);
+  for (int i = 0; i < 10; ++i)
+    sizer.OnRequestCompleted(sizer.node_count(), duration, true);
+
+  EXPECT_EQ(sizer.node_count(), 120u);
+  EXPECT_EQ(sizer.parallel_request_count(), 4u);
+}
@@ -19,8 +19,6 @@
 
 namespace {
 
-const size_t kMaxFetchChildCount = 100;
-
 std::string NodeIdsToString(
     const std::vector<scada::ReferenceDescription>& references) {
   const std::string& node_ids = boost::algorithm::join(
@@ -59,12 +57,13 @@ std::shared_ptr<NodeChildrenFetcher> NodeChildrenFetcher::Create(
 }
 
 void NodeChildrenFetcher::FetchPendingNodes() {
-  if (children_request_count_ == 0 && !pending_children_.empty()) {
+  while (children_request_count_ < request_sizer_.parallel_request_count() &&
+         !pending_children_.empty()) {
+    const size_t max_node_count = request_sizer_.node_count();
     std::vector<scada::NodeId> node_ids;
-    node_ids.reserve(std::min(kMaxFetchChildCount, pending_children_.size()));
+    node_ids.reserve(std::min(max_node_count, pending_children_.size()));
 
-    while (!pending_children_.empty() &&
-           node_ids.size() < kMaxFetchChildCount) {
+    while (!pending_children_.empty() && node_ids.size() < max_node_count) {
       auto node_id = std::move(pending_children_.front());
       pending_children_.pop_front();
       pending_children_set_.erase(node_id);
@@ -72,11 +71,11 @@ void NodeChildrenFetcher::FetchPendingNodes() {
     }
 
     FetchChildren(std::move(node_ids));
-    return;
   }
 }
 
 void NodeChildrenFetcher::OnBrowseChildrenResult(
+    size_t node_count,
     scada::base::TimeTicks start_ticks,
     scada::Status&& status,
     const std::vector<scada::BrowseDescription>& descriptions,
@@ -101,6 +100,8 @@ void NodeChildrenFetcher::OnBrowseChildrenResult(
                      << LOG_TAG("Results",
                                 ToString(scada::base::AsList(results)));
 
+  request_sizer_.OnRequestCompleted(node_count, duration, !!status);
+
   scada::base::Check(!descriptions.empty());
 
   std::map<scada::NodeId, scada::BrowseResult> merged_results;
@@ -170,15 +171,16 @@ void NodeChildrenFetcher::FetchChildren(
   }
 
   CoSpawn(executor_, weak_from_this(),
-          [start_ticks,
+          [node_count = node_ids.size(), start_ticks,
            descriptions](std::shared_ptr<NodeChildrenFetcher> self) mutable
               -> Awaitable<void> {
             auto result = co_await self->view_service_.Browse(
                 self->service_context_, descriptions);
             auto status = result.status();
             auto results = std::move(result).value_or({});
-            self->OnBrowseChildrenResult(start_ticks, std::move(status),
-                                         descriptions, std::move(results));
+            self->OnBrowseChildrenResult(node_count, start_ticks,
+                                         std::move(status), descriptions,
+                                         std::move(results));
           });
 }
 
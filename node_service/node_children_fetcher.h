@@ -3,6 +3,7 @@
 #include "base/any_executor.h"
 #include "base/boost_log.h"
 #include "base/time/time.h"
+#include "node_service/fetch_request_sizer.h"
 #include "scada/service_context.h"
 
 #include <deque>
@@ -43,12 +44,18 @@ class NodeChildrenFetcher
 
   size_t GetPendingNodeCount() const;
 
+  // Diagnostics.
+  const FetchRequestSizerState& request_sizer_state() const {
+    return request_sizer_.state();
+  }
+
  private:
   explicit NodeChildrenFetcher(NodeChildrenFetcherContext&& context);
 
   void FetchPendingNodes();
 
   void OnBrowseChildrenResult(
+      size_t node_count,
       scada::base::TimeTicks start_ticks,
       scada::Status&& status,
       const std::vector<scada::BrowseDescription>& descriptions,
@@ -59,6 +66,11 @@ class NodeChildrenFetcher
   BoostLogger logger_{LOG_NAME("NodeChildrenFetcher")};
 
   size_t children_request_count_ = 0;
+
+  // Sizes node batches and bounds the requests in flight.
+  FetchRequestSizer request_sizer_{
+      FetchRequestSizerOptions{.initial_parallel_request_count = 1}};
+
   std::deque<scada::NodeId> pending_children_;
   std::set<scada::NodeId> pending_children_set_;
 };
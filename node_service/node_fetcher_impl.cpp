@@ -18,8 +18,6 @@
 
 namespace {
 
-const size_t kMaxRequestNodeCount = 100;
-const size_t kMaxParallelRequestCount = 5;
 // Read + Browse.
 const size_t kPrimitiveRequestCount = 2;
 const size_t kFetchAttributesReserveFactor = 5;
@@ -212,11 +210,13 @@ void NodeFetcherImpl::FetchPendingNodes() {
 
   while (!pending_queue_.empty() &&
          running_request_count_ + kPrimitiveRequestCount <=
-             kMaxParallelRequestCount) {
+             request_sizer_.parallel_request_count() *
+                 kPrimitiveRequestCount) {
+    const size_t max_node_count = request_sizer_.node_count();
     std::vector<FetchingNode*> nodes;
-    nodes.reserve(std::min(kMaxRequestNodeCount, pending_queue_.size()));
+    nodes.reserve(std::min(max_node_count, pending_queue_.size()));
 
-    while (!pending_queue_.empty() && nodes.size() < kMaxRequestNodeCount) {
+    while (!pending_queue_.empty() && nodes.size() < max_node_count) {
       auto& node = pending_queue_.top();
       pending_queue_.pop();
       scada::base::Check(IsEmpty(node.fetch_started));
@@ -243,6 +243,7 @@ void NodeFetcherImpl::FetchPendingNodes(std::vector<FetchingNode*>&& nodes) {
 
   const auto start_ticks = scada::base::TimeTicks::Now();
   const auto request_id = MakeRequestId();
+  const auto node_count = nodes.size();
 
   LOG_INFO(logger_) << "Fetch pending nodes"
                     << LOG_TAG("NodeIds", ToString(CollectNodeIds(nodes)))
@@ -268,15 +269,15 @@ void NodeFetcherImpl::FetchPendingNodes(std::vector<FetchingNode*>&& nodes) {
   scada::base::Check(CheckInvariants());
 
   CoSpawn(executor_, weak_from_this(),
-          [request_id, start_ticks, read_ids = std::move(read_ids)](
+          [request_id, node_count, start_ticks, read_ids = std::move(read_ids)](
               std::shared_ptr<NodeFetcherImpl> self) -> Awaitable<void> {
             // OnReadResult needs the inputs after the call, so pass a copy in.
             auto result = co_await self->attribute_service_.Read(
                 self->service_context_, read_ids);
             auto status = result.status();
             auto results = std::move(result).value_or({});
-            self->OnReadResult(request_id, start_ticks, std::move(status),
-                               read_ids, std::move(results));
+            self->OnReadResult(request_id, node_count, start_ticks,
+                               std::move(status), read_ids, std::move(results));
           });
 
   // References
@@ -290,7 +291,8 @@ void NodeFetcherImpl::FetchPendingNodes(std::vector<FetchingNode*>&& nodes) {
   }
 
   if (descriptions.empty()) {
-    OnBrowseResult(request_id, start_ticks, scada::StatusCode::Good, {}, {});
+    OnBrowseResult(request_id, node_count, start_ticks, scada::StatusCode::Good,
+                   {}, {});
     return;
   }
 
@@ -298,14 +300,15 @@ void NodeFetcherImpl::FetchPendingNodes(std::vector<FetchingNode*>&& nodes) {
 
   CoSpawn(
       executor_, weak_from_this(),
-      [request_id, start_ticks, descriptions](
+      [request_id, node_count, start_ticks, descriptions](
           std::shared_ptr<NodeFetcherImpl> self) mutable -> Awaitable<void> {
         auto result = co_await self->view_service_.Browse(
             self->service_context_, descriptions);
         auto status = result.status();
         auto results = std::move(result).value_or({});
-        self->OnBrowseResult(request_id, start_ticks, std::move(status),
-                             descriptions, std::move(results));
+        self->OnBrowseResult(request_id, node_count, start_ticks,
+                             std::move(status), descriptions,
+                             std::move(results));
       });
 }
 
@@ -378,6 +381,7 @@ void NodeFetcherImpl::NotifyFetchedNodes() {
 
 void NodeFetcherImpl::OnReadResult(
     unsigned request_id,
+    size_t node_count,
     scada::base::TimeTicks start_ticks,
     scada::Status&& status,
     const std::vector<scada::ReadValueId>& read_ids,
@@ -400,6 +404,7 @@ void NodeFetcherImpl::OnReadResult(
                     << LOG_TAG("RequestId", request_id)
                     << LOG_TAG("DurationMs", duration.InMilliseconds())
                     << LOG_TAG("Status", ToString(status));
+  UpdateRequestSizer(node_count, duration, status);
   for (size_t i = 0; i < read_ids.size() && i < results.size(); ++i) {
     const auto& input = read_ids[i];
     LOG_DEBUG(logger_) << "Read request completed"
@@ -455,6 +460,27 @@ void NodeFetcherImpl::OnReadResult(
   scada::base::Check(CheckInvariants());
 }
 
+void NodeFetcherImpl::UpdateRequestSizer(size_t node_count,
+                                         scada::base::TimeDelta duration,
+                                         const scada::Status& status) {
+  const auto old_node_count = request_sizer_.node_count();
+  const auto old_parallel_request_count =
+      request_sizer_.parallel_request_count();
+
+  request_sizer_.OnRequestCompleted(node_count, duration, !!status);
+
+  if (request_sizer_.node_count() != old_node_count ||
+      request_sizer_.parallel_request_count() != old_parallel_request_count) {
+    LOG_INFO(logger_) << "Request size changed"
+                      << LOG_TAG("NodeCount", request_sizer_.node_count())
+                      << LOG_TAG("ParallelRequestCount",
+                                 request_sizer_.parallel_request_count())
+                      << LOG_TAG("BaseDurationMs",
+                                 request_sizer_.state()
+                                     .base_duration.InMilliseconds());
+  }
+}
+
 void NodeFetcherImpl::ApplyReadResult(unsigned request_id,
                                       const scada::ReadValueId& read_id,
                                       scada::DataValue&& result) {
@@ -538,6 +564,7 @@ void NodeFetcherImpl::SetFetchedAttribute(FetchingNode& node,
 
 void NodeFetcherImpl::OnBrowseResult(
     unsigned request_id,
+    size_t node_count,
     scada::base::TimeTicks start_ticks,
     scada::Status&& status,
     const std::vector<scada::BrowseDescription>& descriptions,
@@ -561,6 +588,9 @@ void NodeFetcherImpl::OnBrowseResult(
                     << LOG_TAG("Count", descriptions.size())
                     << LOG_TAG("DurationMs", duration.InMilliseconds())
                     << LOG_TAG("Status", ToString(status));
+  // An empty browse completes inline and tells nothing about the server.
+  if (!descriptions.empty())
+    UpdateRequestSizer(node_count, duration, status);
   for (size_t i = 0; i < descriptions.size() && i < results.size(); ++i) {
     const auto& input = descriptions[i];
     LOG_DEBUG(logger_) << "Browse request completed"
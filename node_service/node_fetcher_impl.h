@@ -3,6 +3,7 @@
 #include "base/any_executor.h"
 #include "base/boost_log.h"
 #include "node_service/fetch_queue.h"
+#include "node_service/fetch_request_sizer.h"
 #include "node_service/fetching_node_graph.h"
 #include "node_service/node_fetcher.h"
 #include "scada/service_context.h"
@@ -44,6 +45,12 @@ class NodeFetcherImpl : private NodeFetcherImplContext,
   virtual void Cancel(const scada::NodeId& node_id) override;
   virtual size_t GetPendingNodeCount() const override;
 
+  // Diagnostics.
+  const FetchRequestSizerState& request_sizer_state() const {
+    return request_sizer_.state();
+  }
+  size_t running_request_count() const { return running_request_count_; }
+
  private:
   explicit NodeFetcherImpl(NodeFetcherImplContext&& context);
 
@@ -68,16 +75,22 @@ class NodeFetcherImpl : private NodeFetcherImplContext,
                            scada::ReferenceDescription&& reference);
 
   void OnReadResult(unsigned request_id,
+                    size_t node_count,
                     scada::base::TimeTicks start_ticks,
                     scada::Status&& status,
                     const std::vector<scada::ReadValueId>& read_ids,
                     std::vector<scada::DataValue>&& results);
   void OnBrowseResult(unsigned request_id,
+                      size_t node_count,
                       scada::base::TimeTicks start_ticks,
                       scada::Status&& status,
                       const std::vector<scada::BrowseDescription>& descriptions,
                       std::vector<scada::BrowseResult>&& results);
 
+  void UpdateRequestSizer(size_t node_count,
+                          scada::base::TimeDelta duration,
+                          const scada::Status& status);
+
   void ApplyReadResult(unsigned request_id,
                        const scada::ReadValueId& read_id,
                        scada::DataValue&& result);
@@ -95,8 +108,12 @@ class NodeFetcherImpl : private NodeFetcherImplContext,
 
   FetchingNodeGraph fetching_nodes_;
 
+  // Primitive (Read or Browse) requests in flight.
   size_t running_request_count_ = 0;
 
+  // Sizes node batches and bounds the batches in flight.
+  FetchRequestSizer request_sizer_;
+
   // Can't be zero.
   unsigned next_request_id_ = 1;
 
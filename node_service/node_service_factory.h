@@ -4,6 +4,7 @@
 #include "scada/client.h"
 #include "scada/data_services.h"
 
+#include <filesystem>
 #include <memory>
 
 namespace scada {
@@ -29,6 +30,9 @@ struct NodeServiceContext {
   scada::MonitoredItemService& monitored_item_service_;
   scada::MethodService& method_service_;
   scada::client scada_client_;
+  // Optional. Keeps fetched nodes in this file between runs, so a restarted
+  // client shows them before the server answers.
+  std::filesystem::path node_snapshot_path_;
 };
 
 struct CoroutineNodeServiceContext {
@@ -40,6 +44,8 @@ struct CoroutineNodeServiceContext {
   scada::ViewService& view_service_;
   scada::MonitoredItemService& monitored_item_service_;
   scada::client scada_client_;
+  // Optional. See NodeServiceContext.
+  std::filesystem::path node_snapshot_path_;
 };
 
 struct DataServicesNodeServiceContext {
@@ -47,6 +53,8 @@ struct DataServicesNodeServiceContext {
   const scada::ServiceContext service_context_;
   DataServices data_services_;
   scada::client scada_client_;
+  // Optional. See NodeServiceContext.
+  std::filesystem::path node_snapshot_path_;
 };
 
 std::shared_ptr<NodeService> CreateNodeService(const NodeServiceContext& context);
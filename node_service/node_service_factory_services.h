@@ -27,7 +27,8 @@ inline DataServicesNodeServiceContext MakeDataServicesNodeServiceContext(
           .service_context_ = context.service_context_,
           .data_services_ = scada::data_services::FromUnownedServices(
               MakeLegacyNodeServices(context)),
-          .scada_client_ = context.scada_client_};
+          .scada_client_ = context.scada_client_,
+          .node_snapshot_path_ = context.node_snapshot_path_};
 }
 
 inline bool HasRequiredNodeServices(const DataServices& data_services) {
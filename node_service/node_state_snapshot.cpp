@@ -0,0 +1,567 @@
+#include "node_service/node_state_snapshot.h"
+
+#include "model/node_id_util.h"
+#include "scada/localized_text.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+// Snapshot file layout, native byte order (the snapshot never leaves the
+// host):
+//
+//   header:    "NSSN" u32:version
+//   body:      u32:count count * node
+//              u32:count count * (node_id u32:count count * reference)
+//   node:      node_id u8:node_class node_id:type_definition node_id:parent
+//              node_id:reference_type node_id:supertype
+//              qualified_name:browse_name text:display_name text:inverse_name
+//              node_id:data_type u8:has_value [variant]
+//              u32:count count * (node_id:prop_type variant)
+//              u32:count count * reference
+//              u32:count count * node
+//   reference: node_id:reference_type u8:forward node_id u8:node_class
+//              qualified_name:browse_name text:display_name
+//              node_id:type_definition
+//   variant:   u8:type u8:is_array (scalar | u32:count count * scalar)
+//
+// Node IDs are stored as scada strings, texts as UTF-8; strings are prefixed
+// by their u32 size. Bump kVersion on any layout change: a snapshot of another
+// version is ignored and rebuilt from the server.
+
+namespace {
+
+constexpr char kMagic[4] = {'N', 'S', 'S', 'N'};
+constexpr uint32_t kVersion = 1;
+
+class Writer {
+ public:
+  size_t size() const { return data_.size(); }
+  void Truncate(size_t size) { data_.resize(size); }
+  std::string Take() { return std::move(data_); }
+
+  template <class T>
+  void Put(const T& value) {
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    data_.append(bytes, sizeof(value));
+  }
+
+  template <class T>
+  void Patch(size_t position, const T& value) {
+    std::memcpy(data_.data() + position, &value, sizeof(value));
+  }
+
+  void PutBytes(std::string_view value) {
+    Put(static_cast<uint32_t>(value.size()));
+    data_.append(value);
+  }
+
+  void PutNodeId(const scada::NodeId& node_id) {
+    PutBytes(node_id.is_null() ? std::string{}
+                               : NodeIdToScadaString(node_id));
+  }
+
+  void PutText(const scada::LocalizedText& text) { PutBytes(ToString(text)); }
+
+  void PutQualifiedName(const scada::QualifiedName& name) {
+    Put(static_cast<uint16_t>(name.namespace_index()));
+    PutBytes(name.name());
+  }
+
+  void PutByteString(const scada::ByteString& value) {
+    PutBytes(std::string_view{value.data(), value.size()});
+  }
+
+  bool PutVariant(const scada::Variant& value);
+  bool PutNode(const scada::NodeState& node_state);
+  void PutReference(const scada::ReferenceDescription& reference);
+
+  void PutReferences(const scada::ReferenceDescriptions& references) {
+    PutArray(references, &Writer::PutReference);
+  }
+
+ private:
+  template <class T>
+  void PutArray(const std::vector<T>& values, void (Writer::*put)(const T&)) {
+    Put(static_cast<uint32_t>(values.size()));
+    for (const auto& value : values)
+      (this->*put)(value);
+  }
+
+  void PutString(const scada::String& value) { PutBytes(value); }
+
+  std::string data_;
+};
+
+bool Writer::PutVariant(const scada::Variant& value) {
+  Put(static_cast<uint8_t>(value.type()));
+  Put(static_cast<uint8_t>(value.is_array()));
+
+  if (value.is_array()) {
+    switch (value.type()) {
+      case scada::Variant::BYTE_STRING:
+        PutArray(value.get<std::vector<scada::ByteString>>(),
+                 &Writer::PutByteString);
+        return true;
+      case scada::Variant::STRING:
+        PutArray(value.get<std::vector<scada::String>>(), &Writer::PutString);
+        return true;
+      case scada::Variant::LOCALIZED_TEXT:
+        PutArray(value.get<std::vector<scada::LocalizedText>>(),
+                 &Writer::PutText);
+        return true;
+      case scada::Variant::NODE_ID:
+        PutArray(value.get<std::vector<scada::NodeId>>(), &Writer::PutNodeId);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  switch (value.type()) {
+    case scada::Variant::EMPTY:
+      return true;
+    case scada::Variant::BOOL:
+      Put(static_cast<uint8_t>(value.as_bool()));
+      return true;
+    case scada::Variant::INT8:
+      Put(value.get<scada::Int8>());
+      return true;
+    case scada::Variant::UINT8:
+      Put(value.get<scada::UInt8>());
+      return true;
+    case scada::Variant::INT16:
+      Put(value.get<scada::Int16>());
+      return true;
+    case scada::Variant::UINT16:
+      Put(value.get<scada::UInt16>());
+      return true;
+    case scada::Variant::INT32:
+      Put(value.get<scada::Int32>());
+      return true;
+    case scada::Variant::UINT32:
+      Put(value.get<scada::UInt32>());
+      return true;
+    case scada::Variant::INT64:
+      Put(value.get<scada::Int64>());
+      return true;
+    case scada::Variant::UINT64:
+      Put(value.get<scada::UInt64>());
+      return true;
+    case scada::Variant::DOUBLE:
+      Put(value.get<scada::Double>());
+      return true;
+    case scada::Variant::BYTE_STRING:
+      PutByteString(value.get<scada::ByteString>());
+      return true;
+    case scada::Variant::STRING:
+      PutBytes(value.as_string());
+      return true;
+    case scada::Variant::LOCALIZED_TEXT:
+      PutText(value.as_localized_text());
+      return true;
+    case scada::Variant::NODE_ID:
+      PutNodeId(value.as_node_id());
+      return true;
+    case scada::Variant::DATE_TIME:
+      Put(value.get<scada::DateTime>().ToInternalValue());
+      return true;
+    default:
+      return false;
+  }
+}
+
+void Writer::PutReference(const scada::ReferenceDescription& reference) {
+  PutNodeId(reference.reference_type_id);
+  Put(static_cast<uint8_t>(reference.forward));
+  PutNodeId(reference.node_id);
+  Put(static_cast<uint8_t>(reference.node_class));
+  PutQualifiedName(reference.browse_name);
+  PutText(reference.display_name);
+  PutNodeId(reference.type_definition);
+}
+
+bool Writer::PutNode(const scada::NodeState& node_state) {
+  PutNodeId(node_state.node_id);
+  Put(static_cast<uint8_t>(node_state.node_class));
+  PutNodeId(node_state.type_definition_id);
+  PutNodeId(node_state.parent_id);
+  PutNodeId(node_state.reference_type_id);
+  PutNodeId(node_state.supertype_id);
+
+  const auto& attributes = node_state.attributes;
+  PutQualifiedName(attributes.browse_name);
+  PutText(attributes.display_name);
+  PutText(attributes.inverse_name);
+  PutNodeId(attributes.data_type);
+  Put(static_cast<uint8_t>(attributes.value.has_value()));
+  if (attributes.value.has_value() && !PutVariant(*attributes.value))
+    return false;
+
+  Put(static_cast<uint32_t>(node_state.properties.size()));
+  for (const auto& [prop_type_id, value] : node_state.properties) {
+    PutNodeId(prop_type_id);
+    if (!PutVariant(value))
+      return false;
+  }
+
+  PutReferences(node_state.references);
+
+  Put(static_cast<uint32_t>(node_state.children.size()));
+  for (const auto& child : node_state.children) {
+    if (!PutNode(child))
+      return false;
+  }
+
+  return true;
+}
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_{data} {}
+
+  bool at_end() const { return position_ == data_.size(); }
+
+  template <class T>
+  bool Get(T& value) {
+    if (data_.size() - position_ < sizeof(value))
+      return false;
+    std::memcpy(&value, data_.data() + position_, sizeof(value));
+    position_ += sizeof(value);
+    return true;
+  }
+
+  bool GetBytes(std::string_view& value) {
+    uint32_t size = 0;
+    if (!Get(size) || data_.size() - position_ < size)
+      return false;
+    value = data_.substr(position_, size);
+    position_ += size;
+    return true;
+  }
+
+  bool GetString(scada::String& value) {
+    std::string_view bytes;
+    if (!GetBytes(bytes))
+      return false;
+    value.assign(bytes);
+    return true;
+  }
+
+  bool GetNodeId(scada::NodeId& node_id) {
+    std::string_view bytes;
+    if (!GetBytes(bytes))
+      return false;
+    node_id = bytes.empty() ? scada::NodeId{} : NodeIdFromScadaString(bytes);
+    return true;
+  }
+
+  bool GetText(scada::LocalizedText& text) {
+    std::string_view bytes;
+    if (!GetBytes(bytes))
+      return false;
+    text = scada::ToLocalizedText(bytes);
+    return true;
+  }
+
+  bool GetQualifiedName(scada::QualifiedName& name) {
+    uint16_t namespace_index = 0;
+    std::string_view bytes;
+    if (!Get(namespace_index) || !GetBytes(bytes))
+      return false;
+    name = scada::QualifiedName{std::string{bytes},
+                                static_cast<scada::NamespaceIndex>(
+                                    namespace_index)};
+    return true;
+  }
+
+  bool GetByteString(scada::ByteString& value) {
+    std::string_view bytes;
+    if (!GetBytes(bytes))
+      return false;
+    value = scada::ByteString{bytes.begin(), bytes.end()};
+    return true;
+  }
+
+  bool GetVariant(scada::Variant& value);
+  bool GetNode(scada::NodeState& node_state);
+  bool GetReference(scada::ReferenceDescription& reference);
+
+  template <class T>
+  bool GetArray(std::vector<T>& values, bool (Reader::*get)(T&)) {
+    uint32_t count = 0;
+    if (!Get(count))
+      return false;
+    // Don't trust the count for the allocation: a corrupt file could ask for
+    // gigabytes.
+    values.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+      if (!(this->*get)(values.emplace_back()))
+        return false;
+    }
+    return true;
+  }
+
+ private:
+  template <class T>
+  bool GetScalar(scada::Variant& value) {
+    T scalar{};
+    if (!Get(scalar))
+      return false;
+    value = scada::Variant{scalar};
+    return true;
+  }
+
+  template <class T>
+  bool GetArrayVariant(scada::Variant& value, bool (Reader::*get)(T&)) {
+    std::vector<T> values;
+    if (!GetArray(values, get))
+      return false;
+    value = scada::Variant{std::move(values)};
+    return true;
+  }
+
+  const std::string_view data_;
+  size_t position_ = 0;
+};
+
+bool Reader::GetVariant(scada::Variant& value) {
+  uint8_t type = 0;
+  uint8_t is_array = 0;
+  if (!Get(type) || !Get(is_array))
+    return false;
+
+  if (is_array) {
+    switch (static_cast<scada::Variant::Type>(type)) {
+      case scada::Variant::BYTE_STRING:
+        return GetArrayVariant(value, &Reader::GetByteString);
+      case scada::Variant::STRING:
+        return GetArrayVariant(value, &Reader::GetString);
+      case scada::Variant::LOCALIZED_TEXT:
+        return GetArrayVariant(value, &Reader::GetText);
+      case scada::Variant::NODE_ID:
+        return GetArrayVariant(value, &Reader::GetNodeId);
+      default:
+        return false;
+    }
+  }
+
+  switch (static_cast<scada::Variant::Type>(type)) {
+    case scada::Variant::EMPTY:
+      value = scada::Variant{};
+      return true;
+    case scada::Variant::BOOL: {
+      uint8_t bool_value = 0;
+      if (!Get(bool_value))
+        return false;
+      value = scada::Variant{bool_value != 0};
+      return true;
+    }
+    case scada::Variant::INT8:
+      return GetScalar<scada::Int8>(value);
+    case scada::Variant::UINT8:
+      return GetScalar<scada::UInt8>(value);
+    case scada::Variant::INT16:
+      return GetScalar<scada::Int16>(value);
+    case scada::Variant::UINT16:
+      return GetScalar<scada::UInt16>(value);
+    case scada::Variant::INT32:
+      return GetScalar<scada::Int32>(value);
+    case scada::Variant::UINT32:
+      return GetScalar<scada::UInt32>(value);
+    case scada::Variant::INT64:
+      return GetScalar<scada::Int64>(value);
+    case scada::Variant::UINT64:
+      return GetScalar<scada::UInt64>(value);
+    case scada::Variant::DOUBLE:
+      return GetScalar<scada::Double>(value);
+    case scada::Variant::BYTE_STRING: {
+      scada::ByteString byte_string;
+      if (!GetByteString(byte_string))
+        return false;
+      value = scada::Variant{std::move(byte_string)};
+      return true;
+    }
+    case scada::Variant::STRING: {
+      scada::String string;
+      if (!GetString(string))
+        return false;
+      value = scada::Variant{std::move(string)};
+      return true;
+    }
+    case scada::Variant::LOCALIZED_TEXT: {
+      scada::LocalizedText text;
+      if (!GetText(text))
+        return false;
+      value = scada::Variant{std::move(text)};
+      return true;
+    }
+    case scada::Variant::NODE_ID: {
+      scada::NodeId node_id;
+      if (!GetNodeId(node_id))
+        return false;
+      value = scada::Variant{std::move(node_id)};
+      return true;
+    }
+    case scada::Variant::DATE_TIME: {
+      int64_t internal_value = 0;
+      if (!Get(internal_value))
+        return false;
+      value =
+          scada::Variant{scada::DateTime::FromInternalValue(internal_value)};
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool Reader::GetReference(scada::ReferenceDescription& reference) {
+  uint8_t forward = 0;
+  uint8_t node_class = 0;
+  if (!GetNodeId(reference.reference_type_id) || !Get(forward) ||
+      !GetNodeId(reference.node_id) || !Get(node_class) ||
+      !GetQualifiedName(reference.browse_name) ||
+      !GetText(reference.display_name) ||
+      !GetNodeId(reference.type_definition)) {
+    return false;
+  }
+  reference.forward = forward != 0;
+  reference.node_class = static_cast<scada::NodeClass>(node_class);
+  return true;
+}
+
+bool Reader::GetNode(scada::NodeState& node_state) {
+  uint8_t node_class = 0;
+  if (!GetNodeId(node_state.node_id) || !Get(node_class) ||
+      !GetNodeId(node_state.type_definition_id) ||
+      !GetNodeId(node_state.parent_id) ||
+      !GetNodeId(node_state.reference_type_id) ||
+      !GetNodeId(node_state.supertype_id)) {
+    return false;
+  }
+  node_state.node_class = static_cast<scada::NodeClass>(node_class);
+
+  auto& attributes = node_state.attributes;
+  uint8_t has_value = 0;
+  if (!GetQualifiedName(attributes.browse_name) ||
+      !GetText(attributes.display_name) ||
+      !GetText(attributes.inverse_name) || !GetNodeId(attributes.data_type) ||
+      !Get(has_value)) {
+    return false;
+  }
+  if (has_value && !GetVariant(attributes.value.emplace()))
+    return false;
+
+  uint32_t property_count = 0;
+  if (!Get(property_count))
+    return false;
+  node_state.properties.clear();
+  for (uint32_t i = 0; i < property_count; ++i) {
+    auto& [prop_type_id, value] = node_state.properties.emplace_back();
+    if (!GetNodeId(prop_type_id) || !GetVariant(value))
+      return false;
+  }
+
+  return GetArray(node_state.references, &Reader::GetReference) &&
+         GetArray(node_state.children, &Reader::GetNode);
+}
+
+}  // namespace
+
+std::string EncodeNodeStateSnapshot(const NodeStateSnapshot& snapshot) {
+  Writer writer;
+  writer.Put(kMagic);
+  writer.Put(kVersion);
+
+  // The node count is patched once it is known which nodes could be encoded.
+  const size_t node_count_position = writer.size();
+  writer.Put(uint32_t{0});
+  uint32_t node_count = 0;
+  for (const auto& node_state : snapshot.nodes) {
+    const size_t position = writer.size();
+    if (writer.PutNode(node_state))
+      ++node_count;
+    else
+      writer.Truncate(position);
+  }
+  writer.Patch(node_count_position, node_count);
+
+  writer.Put(static_cast<uint32_t>(snapshot.children.size()));
+  for (const auto& [node_id, references] : snapshot.children) {
+    writer.PutNodeId(node_id);
+    writer.PutReferences(references);
+  }
+
+  return writer.Take();
+}
+
+std::optional<NodeStateSnapshot> DecodeNodeStateSnapshot(
+    std::string_view data) {
+  Reader reader{data};
+
+  char magic[sizeof(kMagic)] = {};
+  uint32_t version = 0;
+  if (!reader.Get(magic) ||
+      std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.Get(version) || version != kVersion) {
+    return std::nullopt;
+  }
+
+  NodeStateSnapshot snapshot;
+  if (!reader.GetArray(snapshot.nodes, &Reader::GetNode))
+    return std::nullopt;
+
+  uint32_t children_count = 0;
+  if (!reader.Get(children_count))
+    return std::nullopt;
+  for (uint32_t i = 0; i < children_count; ++i) {
+    auto& [node_id, references] = snapshot.children.emplace_back();
+    if (!reader.GetNodeId(node_id) ||
+        !reader.GetArray(references, &Reader::GetReference)) {
+      return std::nullopt;
+    }
+  }
+
+  if (!reader.at_end())
+    return std::nullopt;
+
+  return snapshot;
+}
+
+std::optional<NodeStateSnapshot> ReadNodeStateSnapshot(
+    const std::filesystem::path& path) {
+  std::ifstream file{path, std::ios::binary};
+  if (!file)
+    return std::nullopt;
+
+  std::string data{std::istreambuf_iterator<char>{file},
+                   std::istreambuf_iterator<char>{}};
+  if (file.bad())
+    return std::nullopt;
+
+  return DecodeNodeStateSnapshot(data);
+}
+
+bool WriteNodeStateSnapshot(const std::filesystem::path& path,
+                            const NodeStateSnapshot& snapshot) {
+  const auto data = EncodeNodeStateSnapshot(snapshot);
+
+  auto temp_path = path;
+  temp_path += ".tmp";
+
+  {
+    std::ofstream file{temp_path, std::ios::binary | std::ios::trunc};
+    if (!file)
+      return false;
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file.flush())
+      return false;
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  return !ec;
+}
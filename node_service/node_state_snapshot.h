@@ -0,0 +1,35 @@
+#pragma once
+
+#include "common/node_state.h"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Fetched node states and child reference lists kept between client runs, so
+// a restarted client can show the address space before the server answers.
+struct NodeStateSnapshot {
+  std::vector<scada::NodeState> nodes;
+  std::vector<std::pair<scada::NodeId, scada::ReferenceDescriptions>> children;
+};
+
+// Encodes |snapshot| in the versioned binary snapshot format. A node holding a
+// value of a type the format can't keep is left out.
+std::string EncodeNodeStateSnapshot(const NodeStateSnapshot& snapshot);
+
+// Returns std::nullopt if |data| is not a snapshot of the current version or
+// is truncated.
+std::optional<NodeStateSnapshot> DecodeNodeStateSnapshot(std::string_view data);
+
+// Returns std::nullopt if the file is missing, unreadable or not a valid
+// snapshot.
+std::optional<NodeStateSnapshot> ReadNodeStateSnapshot(
+    const std::filesystem::path& path);
+
+// Writes a temporary file next to |path| and renames it over, so an
+// interrupted write keeps the previous snapshot. Returns false on I/O error.
+bool WriteNodeStateSnapshot(const std::filesystem::path& path,
+                            const NodeStateSnapshot& snapshot);
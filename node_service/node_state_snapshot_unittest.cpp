@@ -0,0 +1,91 @@
+#include "node_service/node_state_snapshot.h"
+
+#include "common/test/node_state_matcher.h"
+#include "scada/localized_text.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+
+using namespace testing;
+
+namespace {
+
+const scada::NodeId kNodeId{1, 5};
+const scada::NodeId kChildId{2, 5};
+const scada::NodeId kPropTypeId{3, 5};
+
+NodeStateSnapshot MakeSnapshot() {
+  scada::NodeState node_state;
+  node_state.set_node_id(kNodeId)
+      .set_node_class(scada::NodeClass::Variable)
+      .set_type_definition_id(scada::id::BaseVariableType)
+      .set_parent(scada::id::Organizes, scada::id::RootFolder)
+      .set_browse_name(scada::QualifiedName{"Node", 5})
+      .set_display_name(scada::ToLocalizedText("Node"));
+  node_state.attributes.data_type = scada::id::Double;
+  node_state.attributes.value = scada::Variant{1.5};
+  node_state.properties.emplace_back(
+      kPropTypeId, scada::Variant{std::vector<scada::String>{"a", "b"}});
+  node_state.references.push_back(
+      {.reference_type_id = scada::id::HasTypeDefinition,
+       .forward = true,
+       .node_id = scada::id::BaseVariableType});
+
+  NodeStateSnapshot snapshot;
+  snapshot.nodes.emplace_back(std::move(node_state));
+  snapshot.children.emplace_back(
+      kNodeId, scada::ReferenceDescriptions{
+                   {.reference_type_id = scada::id::HasComponent,
+                    .forward = true,
+                    .node_id = kChildId,
+                    .node_class = scada::NodeClass::Variable,
+                    .browse_name = scada::QualifiedName{"Child", 5},
+                    .display_name = scada::ToLocalizedText("Child")}});
+  return snapshot;
+}
+
+}  // namespace
+
+TEST(NodeStateSnapshot, RoundTrip) {
+  const auto snapshot = MakeSnapshot();
+
+  const auto decoded =
+      DecodeNodeStateSnapshot(EncodeNodeStateSnapshot(snapshot));
+
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_THAT(decoded->nodes, Pointwise(NodeStateEq(), snapshot.nodes));
+  EXPECT_EQ(decoded->children, snapshot.children);
+}
+
+TEST(NodeStateSnapshot, RejectsTruncatedData) {
+  const auto data = EncodeNodeStateSnapshot(MakeSnapshot());
+
+  for (size_t size = 0; size < data.size(); ++size)
+    EXPECT_FALSE(DecodeNodeStateSnapshot(data.substr(0, size))) << size;
+}
+
+TEST(NodeStateSnapshot, RejectsOtherVersion) {
+  auto data = EncodeNodeStateSnapshot(MakeSnapshot());
+  // The version follows the 4-byte magic.
+  ++data[4];
+
+  EXPECT_FALSE(DecodeNodeStateSnapshot(data));
+}
+
+TEST(NodeStateSnapshot, WritesAndReadsFile) {
+  const auto path = std::filesystem::temp_directory_path() /
+                    "node_state_snapshot_test.bin";
+  std::filesystem::remove(path);
+
+  EXPECT_FALSE(ReadNodeStateSnapshot(path));
+
+  ASSERT_TRUE(WriteNodeStateSnapshot(path, MakeSnapshot()));
+  const auto snapshot = ReadNodeStateSnapshot(path);
+  ASSERT_TRUE(snapshot.has_value());
+  EXPECT_THAT(snapshot->nodes, SizeIs(1));
+  EXPECT_THAT(snapshot->children, SizeIs(1));
+
+  std::filesystem::remove(path);
+}
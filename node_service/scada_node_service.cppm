@@ -21,6 +21,7 @@ module;
 #include "node_service/base_node_model.h"
 #include "node_service/cached_node_service.h"
 #include "node_service/fetch_queue.h"
+#include "node_service/fetch_request_sizer.h"
 #include "node_service/fetching_node.h"
 #include "node_service/fetching_node_graph.h"
 #include "node_service/node_awaitable.h"
@@ -34,6 +35,7 @@ module;
 #include "node_service/node_ref.h"
 #include "node_service/node_service.h"
 #include "node_service/node_service_factory.h"
+#include "node_service/node_state_snapshot.h"
 #include "node_service/node_util.h"
 
 export module scada.node_service;
@@ -55,6 +57,11 @@ export {
   using ::FetchingNodeGraph;
   using ::FetchQueue;
 
+  // fetch_request_sizer.h
+  using ::FetchRequestSizer;
+  using ::FetchRequestSizerOptions;
+  using ::FetchRequestSizerState;
+
   // node_awaitable.h / node_util.h
   using ::FetchChildren;
   using ::FetchNode;
@@ -97,4 +104,11 @@ export {
   using ::NodeRef;
   using ::NodeService;
   using ::NodeServiceContext;
+
+  // node_state_snapshot.h
+  using ::DecodeNodeStateSnapshot;
+  using ::EncodeNodeStateSnapshot;
+  using ::NodeStateSnapshot;
+  using ::ReadNodeStateSnapshot;
+  using ::WriteNodeStateSnapshot;
 }  // export
@@ -8,9 +8,14 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 namespace v3 {
 namespace {
 
+using testing::_;
 using testing::Contains;
 using testing::IsEmpty;
 using testing::IsSupersetOf;
@@ -37,6 +42,7 @@ class ServiceNodeFetcherTest : public testing::Test {
   TestExecutor executor_;
   TestAddressSpace address_space_;
   ServiceNodeFetcher fetcher_{ServiceNodeFetcherContext{
+      .executor_ = executor_,
       .view_service_ = address_space_.view_service_impl,
       .attribute_service_ = address_space_.attribute_service_impl,
       .service_context_ = {}}};
@@ -144,5 +150,56 @@ TEST_F(ServiceNodeFetcherTest, FetchChildren_UnknownNode_ReturnsNoChildren) {
   EXPECT_THAT(*result, IsEmpty());
 }
 
+TEST_F(ServiceNodeFetcherTest, ConcurrentFetchesShareRequests) {
+  // Route the requests through the mocks to count them.
+  ServiceNodeFetcher fetcher{ServiceNodeFetcherContext{
+      .executor_ = executor_,
+      .view_service_ = address_space_,
+      .attribute_service_ = address_space_,
+      .service_context_ = {}}};
+
+  EXPECT_CALL(address_space_, Read(_, _)).Times(1);
+  // One browse for the nodes and one for the children.
+  EXPECT_CALL(address_space_, Browse(_, _)).Times(2);
+
+  const std::vector<scada::NodeId> node_ids{
+      address_space_.kTestNode1Id, address_space_.kTestNode2Id,
+      address_space_.kTestNode2Id,
+      scada::NodeId{12345, TestAddressSpace::kNamespaceIndex}};
+
+  std::vector<scada::StatusOr<scada::NodeState>> node_results;
+  for (const auto& node_id : node_ids) {
+    CoSpawn(executor_, [&, node_id]() -> Awaitable<void> {
+      node_results.emplace_back(co_await fetcher.FetchNode(node_id));
+    });
+  }
+
+  std::optional<scada::StatusOr<scada::ReferenceDescriptions>>
+      children_result;
+  CoSpawn(executor_, [&]() -> Awaitable<void> {
+    children_result =
+        co_await fetcher.FetchChildren(address_space_.kTestNode3Id);
+  });
+
+  Drain(executor_);
+
+  ASSERT_EQ(node_results.size(), node_ids.size());
+  EXPECT_EQ(std::ranges::count_if(node_results,
+                                  [](const auto& result) {
+                                    return result.ok();
+                                  }),
+            3);
+  for (const auto& result : node_results) {
+    if (result.ok())
+      EXPECT_EQ(result->parent_id, scada::id::RootFolder);
+  }
+
+  ASSERT_TRUE(children_result.has_value());
+  ASSERT_TRUE(children_result->ok());
+  EXPECT_THAT(**children_result,
+              Contains(ReferenceIs(scada::id::Organizes, /*forward=*/true,
+                                   address_space_.kTestNode4Id)));
+}
+
 }  // namespace
 }  // namespace v3
@@ -0,0 +1,209 @@
+#include "node_service/v3/snapshot_node_fetcher.h"
+
+#include "base/test/awaitable_test.h"
+#include "base/test/test_executor.h"
+#include "scada/localized_text.h"
+#include "scada/standard_node_ids.h"
+#include "scada/view_service.h"
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+namespace v3 {
+namespace {
+
+using namespace testing;
+
+const scada::NodeId kNodeId{1, 5};
+const scada::NodeId kChildId{2, 5};
+
+scada::NodeState MakeNodeState(const scada::NodeId& node_id,
+                               std::string_view display_name) {
+  scada::NodeState node_state;
+  node_state.set_node_id(node_id)
+      .set_type_definition_id(scada::id::BaseObjectType)
+      .set_parent(scada::id::Organizes, scada::id::RootFolder)
+      .set_display_name(scada::ToLocalizedText(display_name));
+  return node_state;
+}
+
+// Serves the nodes it holds and counts the fetches that reach it.
+class FakeNodeFetcher final : public NodeFetcher {
+ public:
+  Awaitable<scada::StatusOr<scada::NodeState>> FetchNode(
+      const scada::NodeId& node_id) override {
+    ++fetch_node_count;
+    auto i = nodes.find(node_id);
+    if (i == nodes.end())
+      co_return scada::StatusCode::Bad_WrongNodeId;
+    co_return i->second;
+  }
+
+  Awaitable<scada::StatusOr<scada::ReferenceDescriptions>> FetchChildren(
+      const scada::NodeId& node_id) override {
+    ++fetch_children_count;
+    auto i = children.find(node_id);
+    co_return i != children.end() ? i->second
+                                  : scada::ReferenceDescriptions{};
+  }
+
+  std::unordered_map<scada::NodeId, scada::NodeState> nodes;
+  std::unordered_map<scada::NodeId, scada::ReferenceDescriptions> children;
+  int fetch_node_count = 0;
+  int fetch_children_count = 0;
+};
+
+class SnapshotNodeFetcherTest : public Test {
+ protected:
+  SnapshotNodeFetcherTest() {
+    std::filesystem::remove(path_);
+
+    node_fetcher_->nodes.try_emplace(kNodeId,
+                                     MakeNodeState(kNodeId, "Node"));
+    node_fetcher_->children.try_emplace(
+        kNodeId, scada::ReferenceDescriptions{{.reference_type_id =
+                                                   scada::id::Organizes,
+                                               .forward = true,
+                                               .node_id = kChildId}});
+  }
+
+  ~SnapshotNodeFetcherTest() override { std::filesystem::remove(path_); }
+
+  std::unique_ptr<SnapshotNodeFetcher> MakeFetcher() {
+    return std::make_unique<SnapshotNodeFetcher>(SnapshotNodeFetcherContext{
+        .executor_ = executor_,
+        .node_fetcher_ = node_fetcher_,
+        .path_ = path_,
+        .stale_node_handler_ =
+            [this](const scada::ModelChangeEvent& event) {
+              stale_events_.emplace_back(event);
+            },
+    });
+  }
+
+  // Runs a session that fetches |kNodeId| and its children and saves them.
+  void SaveSnapshot() {
+    auto fetcher = MakeFetcher();
+    FetchNode(*fetcher, kNodeId);
+    FetchChildren(*fetcher, kNodeId);
+    ASSERT_TRUE(fetcher->Save());
+    node_fetcher_->fetch_node_count = 0;
+    node_fetcher_->fetch_children_count = 0;
+  }
+
+  scada::StatusOr<scada::NodeState> FetchNode(SnapshotNodeFetcher& fetcher,
+                                              const scada::NodeId& node_id) {
+    return WaitAwaitable(executor_, fetcher.FetchNode(node_id));
+  }
+
+  scada::StatusOr<scada::ReferenceDescriptions> FetchChildren(
+      SnapshotNodeFetcher& fetcher,
+      const scada::NodeId& node_id) {
+    return WaitAwaitable(executor_, fetcher.FetchChildren(node_id));
+  }
+
+  TestExecutor executor_;
+
+  const std::filesystem::path path_ =
+      std::filesystem::temp_directory_path() / "snapshot_node_fetcher_test.bin";
+
+  const std::shared_ptr<FakeNodeFetcher> node_fetcher_ =
+      std::make_shared<FakeNodeFetcher>();
+
+  std::vector<scada::ModelChangeEvent> stale_events_;
+};
+
+}  // namespace
+
+TEST_F(SnapshotNodeFetcherTest, ServesSnapshotAndRevalidatesInBackground) {
+  SaveSnapshot();
+
+  auto fetcher = MakeFetcher();
+  auto node_state = FetchNode(*fetcher, kNodeId);
+  auto references = FetchChildren(*fetcher, kNodeId);
+
+  ASSERT_TRUE(node_state.ok());
+  EXPECT_EQ(node_state->attributes.display_name,
+            scada::ToLocalizedText("Node"));
+  ASSERT_TRUE(references.ok());
+  EXPECT_THAT(*references, SizeIs(1));
+  EXPECT_EQ(fetcher->snapshot_hit_count(), 2u);
+
+  Drain(executor_);
+
+  // Both were revalidated and found unchanged.
+  EXPECT_EQ(node_fetcher_->fetch_node_count, 1);
+  EXPECT_EQ(node_fetcher_->fetch_children_count, 1);
+  EXPECT_EQ(fetcher->pending_revalidation_count(), 0u);
+  EXPECT_THAT(stale_events_, IsEmpty());
+}
+
+TEST_F(SnapshotNodeFetcherTest, ReportsStaleNode) {
+  SaveSnapshot();
+  node_fetcher_->nodes.insert_or_assign(kNodeId,
+                                        MakeNodeState(kNodeId, "Renamed"));
+
+  auto fetcher = MakeFetcher();
+  auto node_state = FetchNode(*fetcher, kNodeId);
+  ASSERT_TRUE(node_state.ok());
+  EXPECT_EQ(node_state->attributes.display_name,
+            scada::ToLocalizedText("Node"));
+
+  Drain(executor_);
+
+  ASSERT_THAT(stale_events_, SizeIs(1));
+  EXPECT_EQ(stale_events_.front().node_id, kNodeId);
+  EXPECT_EQ(fetcher->stale_node_count(), 1u);
+
+  // A snapshot entry is served once; the refetch goes to the server.
+  node_state = FetchNode(*fetcher, kNodeId);
+  ASSERT_TRUE(node_state.ok());
+  EXPECT_EQ(node_state->attributes.display_name,
+            scada::ToLocalizedText("Renamed"));
+}
+
+TEST_F(SnapshotNodeFetcherTest, ReportsDeletedNode) {
+  SaveSnapshot();
+  node_fetcher_->nodes.clear();
+
+  auto fetcher = MakeFetcher();
+  ASSERT_TRUE(FetchNode(*fetcher, kNodeId).ok());
+
+  Drain(executor_);
+
+  ASSERT_THAT(stale_events_, SizeIs(1));
+  EXPECT_TRUE(stale_events_.front().verb &
+              scada::ModelChangeEvent::NodeDeleted);
+}
+
+TEST_F(SnapshotNodeFetcherTest, ModelChangeDropsSnapshotEntry) {
+  SaveSnapshot();
+
+  auto fetcher = MakeFetcher();
+  fetcher->OnModelChanged(scada::ModelChangeEvent{
+      kNodeId, {}, scada::ModelChangeEvent::ReferenceAdded});
+
+  ASSERT_TRUE(FetchNode(*fetcher, kNodeId).ok());
+  ASSERT_TRUE(FetchChildren(*fetcher, kNodeId).ok());
+
+  EXPECT_EQ(fetcher->snapshot_hit_count(), 0u);
+  EXPECT_EQ(node_fetcher_->fetch_node_count, 1);
+  EXPECT_EQ(node_fetcher_->fetch_children_count, 1);
+}
+
+TEST_F(SnapshotNodeFetcherTest, KeepsUnservedEntriesOnSave) {
+  SaveSnapshot();
+
+  // A session that never asks for the node.
+  ASSERT_TRUE(MakeFetcher()->Save());
+
+  auto fetcher = MakeFetcher();
+  ASSERT_TRUE(FetchNode(*fetcher, kNodeId).ok());
+  EXPECT_EQ(fetcher->snapshot_hit_count(), 1u);
+  EXPECT_EQ(node_fetcher_->fetch_node_count, 0);
+}
+
+}  // namespace v3
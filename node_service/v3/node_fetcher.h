@@ -4,6 +4,10 @@
 #include "common/node_state.h"
 #include "scada/status_or.h"
 
+namespace scada {
+struct ModelChangeEvent;
+}  // namespace scada
+
 namespace v3 {
 
 struct NodeFetcherContext {};
@@ -22,6 +26,10 @@ class NodeFetcher : private NodeFetcherContext {
 
   virtual Awaitable<scada::StatusOr<scada::ReferenceDescriptions>> FetchChildren(
       const scada::NodeId& node_id);
+
+  // Called for each model change the server reports, so that a fetcher keeping
+  // node data of its own can drop what the change outdates.
+  virtual void OnModelChanged(const scada::ModelChangeEvent& event) {}
 };
 
 }  // namespace v3
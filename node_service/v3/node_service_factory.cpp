@@ -5,7 +5,9 @@
 #include "node_service/node_service_factory_services.h"
 #include "node_service/v3/node_service_impl.h"
 #include "node_service/v3/service_node_fetcher.h"
+#include "node_service/v3/snapshot_node_fetcher.h"
 #include "scada/service_context.h"
+#include "scada/view_service.h"
 
 #include <memory>
 
@@ -19,9 +21,11 @@ using node_service::internal::ResolvedNodeServices;
 // Builds the production coroutine fetcher v3::NodeServiceImpl injects. Like
 // v2's internal NodeFetcherImpl, it runs with a default ServiceContext.
 std::shared_ptr<NodeFetcher> MakeServiceNodeFetcher(
+    AnyExecutor executor,
     scada::ViewService& view_service,
     scada::AttributeService& attribute_service) {
   return std::make_shared<ServiceNodeFetcher>(ServiceNodeFetcherContext{
+      .executor_ = std::move(executor),
       .view_service_ = view_service,
       .attribute_service_ = attribute_service,
       .service_context_ = scada::ServiceContext{},
@@ -48,14 +52,49 @@ struct NodeServiceHolder {
         node_service{MakeNodeServiceImplContext(node_service_context)},
         node_service_notifier{node_service, session_service} {}
 
+  ~NodeServiceHolder() {
+    stale_node_cancelation.Cancel();
+
+    // Pending fetches may keep the fetcher alive past the service.
+    if (snapshot_node_fetcher)
+      snapshot_node_fetcher->Save();
+  }
+
+  // Wraps |node_fetcher| into a SnapshotNodeFetcher if a snapshot file is
+  // configured.
+  std::shared_ptr<NodeFetcher> MakeNodeFetcher(
+      AnyExecutor executor,
+      std::shared_ptr<NodeFetcher> node_fetcher,
+      const std::filesystem::path& node_snapshot_path) {
+    if (node_snapshot_path.empty())
+      return node_fetcher;
+
+    snapshot_node_fetcher =
+        std::make_shared<SnapshotNodeFetcher>(SnapshotNodeFetcherContext{
+            .executor_ = std::move(executor),
+            .node_fetcher_ = std::move(node_fetcher),
+            .path_ = node_snapshot_path,
+            .stale_node_handler_ =
+                [this, cancelation = stale_node_cancelation.ref()](
+                    const scada::ModelChangeEvent& event) {
+                  if (!cancelation.canceled())
+                    node_service.OnFetchedNodeStale(event);
+                },
+        });
+    return snapshot_node_fetcher;
+  }
+
   NodeServiceImplContext MakeNodeServiceImplContext(
       const CoroutineNodeServiceContext& node_service_context) {
     return NodeServiceImplContext{
         .executor_ = node_service_context.executor_,
         .monitored_item_service_ = node_service_context.monitored_item_service_,
-        .node_fetcher_ =
-            MakeServiceNodeFetcher(node_service_context.view_service_,
+        .node_fetcher_ = MakeNodeFetcher(
+            node_service_context.executor_,
+            MakeServiceNodeFetcher(node_service_context.executor_,
+                                   node_service_context.view_service_,
                                    node_service_context.attribute_service_),
+            node_service_context.node_snapshot_path_),
         .view_events_provider_ = MakeViewEventsProvider(
             node_service_context.executor_,
             node_service_context.monitored_item_service_),
@@ -68,9 +107,12 @@ struct NodeServiceHolder {
     return NodeServiceImplContext{
         .executor_ = node_service_context.executor_,
         .monitored_item_service_ = *resolved_services->monitored_item_service,
-        .node_fetcher_ =
-            MakeServiceNodeFetcher(*resolved_services->view_service,
+        .node_fetcher_ = MakeNodeFetcher(
+            node_service_context.executor_,
+            MakeServiceNodeFetcher(node_service_context.executor_,
+                                   *resolved_services->view_service,
                                    *resolved_services->attribute_service),
+            node_service_context.node_snapshot_path_),
         .view_events_provider_ =
             MakeViewEventsProvider(node_service_context.executor_,
                                    *resolved_services->monitored_item_service),
@@ -79,6 +121,9 @@ struct NodeServiceHolder {
   }
 
   std::unique_ptr<ResolvedNodeServices> resolved_services;
+  // Set by MakeNodeFetcher, so declared ahead of |node_service|.
+  std::shared_ptr<SnapshotNodeFetcher> snapshot_node_fetcher;
+  Cancelation stale_node_cancelation;
   scada::SessionService& session_service;
   NodeServiceImpl node_service;
   SessionProxyNotifier<NodeServiceImpl> node_service_notifier;
@@ -275,6 +275,23 @@ void NodeServiceImpl::NotifyNodeStateChanged(
 }
 
 void NodeServiceImpl::OnModelChanged(const scada::ModelChangeEvent& event) {
+  node_fetcher_->OnModelChanged(event);
+  ApplyModelChange(event);
+}
+
+void NodeServiceImpl::OnFetchedNodeStale(const scada::ModelChangeEvent& event) {
+  ApplyModelChange(event);
+
+  if (event.verb & scada::ModelChangeEvent::NodeDeleted)
+    return;
+
+  if (auto node = FindNodeModel(event.node_id)) {
+    const auto fetch_status = node->GetFetchStatus();
+    SpawnFetch(event.node_id, fetch_status, std::move(node));
+  }
+}
+
+void NodeServiceImpl::ApplyModelChange(const scada::ModelChangeEvent& event) {
   // Service-wide observers are notified regardless of whether the node is
   // resident: consumers that don't hold a NodeRef to the node still rely on
   // remote model-change events (e.g. to decide whether to fetch it).
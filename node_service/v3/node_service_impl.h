@@ -137,6 +137,11 @@ class NodeServiceImpl : private NodeServiceImplContext,
       const NodeStateChangedCallback& callback) const override;
   virtual size_t GetPendingTaskCount() const override;
 
+  // Applies a model change the injected fetcher found rather than the server
+  // reported (see SnapshotNodeFetcher): observers are notified as for a remote
+  // change, and a resident node fetches what it has fetched again.
+  void OnFetchedNodeStale(const scada::ModelChangeEvent& event);
+
   // Number of node models currently resident (pinned by NodeRefs, in-flight
   // fetches, parents, or the keep-alive window). Exposed for diagnostics and
   // residency tests; not part of the NodeService interface.
@@ -171,6 +176,7 @@ class NodeServiceImpl : private NodeServiceImplContext,
                   std::shared_ptr<NodeModelImpl> model);
 
   void NotifyModelChanged(const scada::ModelChangeEvent& event);
+  void ApplyModelChange(const scada::ModelChangeEvent& event);
   void NotifySemanticsChanged(const scada::NodeId& node_id);
   void NotifyNodeStateChanged(const NodeStateChangedEvent& event);
 
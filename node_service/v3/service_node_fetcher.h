@@ -1,9 +1,15 @@
 #pragma once
 
+#include "base/any_executor.h"
+#include "base/awaitable.h"
 #include "common/node_state.h"
 #include "node_service/v3/node_fetcher.h"
 #include "scada/service_context.h"
 
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
 namespace scada {
 class AttributeService;
 class ViewService;
@@ -13,6 +19,7 @@ namespace v3 {
 
 // Services a ServiceNodeFetcher fetches from.
 struct ServiceNodeFetcherContext {
+  AnyExecutor executor_;
   scada::ViewService& view_service_;
   scada::AttributeService& attribute_service_;
   scada::ServiceContext service_context_;
@@ -27,16 +34,69 @@ struct ServiceNodeFetcherContext {
 // NodeState / ReferenceDescriptions to the service, which owns residency and
 // schedules follow-up fetches. It reproduces v2's attribute and reference
 // selection so nodes come back populated identically.
+//
+// Calls issued within one executor tick are coalesced: the fetcher collects
+// them and then sends one multi-node Read and Browse per up to
+// |kMaxRequestNodeCount| nodes, handing each caller its own slice of the
+// results. Concurrent calls for the same node share a request.
 class ServiceNodeFetcher : private ServiceNodeFetcherContext,
                            public NodeFetcher {
  public:
   explicit ServiceNodeFetcher(ServiceNodeFetcherContext&& context);
+  ~ServiceNodeFetcher();
 
   // NodeFetcher
   Awaitable<scada::StatusOr<scada::NodeState>> FetchNode(
       const scada::NodeId& node_id) override;
   Awaitable<scada::StatusOr<scada::ReferenceDescriptions>> FetchChildren(
       const scada::NodeId& node_id) override;
+
+  static constexpr size_t kMaxRequestNodeCount = 100;
+
+ private:
+  // Fetches requested for distinct nodes since the last flush.
+  template <class Result>
+  class PendingRequests {
+   public:
+    using Callback = std::function<void(Result)>;
+
+    struct Request {
+      scada::NodeId node_id;
+      std::vector<Callback> callbacks;
+    };
+
+    void Add(const scada::NodeId& node_id, Callback callback);
+
+    bool empty() const { return requests_.empty(); }
+
+    std::vector<Request> Take();
+
+   private:
+    std::vector<Request> requests_;
+    std::unordered_map<scada::NodeId, size_t> indexes_;
+  };
+
+  using NodeRequests = PendingRequests<scada::StatusOr<scada::NodeState>>;
+  using ChildrenRequests =
+      PendingRequests<scada::StatusOr<scada::ReferenceDescriptions>>;
+
+  template <class Result>
+  Awaitable<Result> Enqueue(PendingRequests<Result>& pending_requests,
+                            scada::NodeId node_id);
+
+  void PostFlush();
+  void Flush();
+
+  void FetchNodeBatch(std::vector<NodeRequests::Request> requests);
+  void FetchChildrenBatch(
+      std::vector<ChildrenRequests::Request> requests);
+
+  NodeRequests pending_node_requests_;
+  ChildrenRequests pending_children_requests_;
+
+  bool flush_posted_ = false;
+
+  Cancelation cancelation_;
 };
 
 }  // namespace v3
@@ -0,0 +1,261 @@
+#include "node_service/v3/snapshot_node_fetcher.h"
+
+#include "base/boost_log.h"
+#include "base/check.h"
+#include "base/no_destructor.h"
+#include "model/node_id_util.h"
+#include "node_service/node_state_snapshot.h"
+#include "scada/view_service.h"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <utility>
+
+namespace v3 {
+
+namespace {
+
+BoostLogger& Logger() {
+  static scada::base::NoDestructor<BoostLogger> logger{
+      LOG_NAME("SnapshotNodeFetcher")};
+  return *logger;
+}
+
+// Compares what a fetch fills in. The fetcher never fills |children|.
+bool IsSameNodeState(const scada::NodeState& a, const scada::NodeState& b) {
+  return a.node_class == b.node_class &&
+         a.type_definition_id == b.type_definition_id &&
+         a.parent_id == b.parent_id &&
+         a.reference_type_id == b.reference_type_id &&
+         a.attributes == b.attributes && a.properties == b.properties &&
+         a.references == b.references && a.supertype_id == b.supertype_id;
+}
+
+}  // namespace
+
+SnapshotNodeFetcher::SnapshotNodeFetcher(SnapshotNodeFetcherContext&& context)
+    : SnapshotNodeFetcherContext{std::move(context)} {
+  scada::base::Check(node_fetcher_ != nullptr);
+  scada::base::Check(!path_.empty());
+
+  Load();
+}
+
+SnapshotNodeFetcher::~SnapshotNodeFetcher() {
+  cancelation_.Cancel();
+}
+
+void SnapshotNodeFetcher::Load() {
+  auto snapshot = ReadNodeStateSnapshot(path_);
+  if (!snapshot) {
+    LOG_INFO(Logger()) << "No node snapshot loaded"
+                       << LOG_TAG("Path", path_.string());
+    return;
+  }
+
+  snapshot_nodes_.reserve(snapshot->nodes.size());
+  for (auto& node_state : snapshot->nodes) {
+    auto node_id = node_state.node_id;
+    snapshot_nodes_.try_emplace(std::move(node_id), std::move(node_state));
+  }
+
+  snapshot_children_.reserve(snapshot->children.size());
+  for (auto& [node_id, references] : snapshot->children)
+    snapshot_children_.try_emplace(node_id, std::move(references));
+
+  LOG_INFO(Logger()) << "Node snapshot loaded"
+                     << LOG_TAG("Path", path_.string())
+                     << LOG_TAG("NodeCount", snapshot_nodes_.size())
+                     << LOG_TAG("ChildrenCount", snapshot_children_.size());
+}
+
+bool SnapshotNodeFetcher::Save() const {
+  NodeStateSnapshot snapshot;
+
+  // Entries never served this run were not contradicted either; keep them
+  // for the next one.
+  snapshot.nodes.reserve(known_nodes_.size() + snapshot_nodes_.size());
+  for (const auto* nodes : {&known_nodes_, &snapshot_nodes_}) {
+    for (const auto& [node_id, node_state] : *nodes)
+      snapshot.nodes.emplace_back(node_state);
+  }
+
+  snapshot.children.reserve(known_children_.size() +
+                            snapshot_children_.size());
+  for (const auto* children : {&known_children_, &snapshot_children_}) {
+    for (const auto& [node_id, references] : *children)
+      snapshot.children.emplace_back(node_id, references);
+  }
+
+  if (!WriteNodeStateSnapshot(path_, snapshot)) {
+    LOG_WARNING(Logger()) << "Can't write node snapshot"
+                          << LOG_TAG("Path", path_.string());
+    return false;
+  }
+
+  return true;
+}
+
+Awaitable<scada::StatusOr<scada::NodeState>> SnapshotNodeFetcher::FetchNode(
+    const scada::NodeId& node_id) {
+  if (auto node = snapshot_nodes_.extract(node_id)) {
+    ++snapshot_hit_count_;
+    known_nodes_.insert_or_assign(node_id, node.mapped());
+    Revalidate({.node_id = node_id, .children = false});
+    co_return std::move(node.mapped());
+  }
+
+  auto node_state = co_await node_fetcher_->FetchNode(node_id);
+  if (node_state.ok())
+    known_nodes_.insert_or_assign(node_id, *node_state);
+  co_return node_state;
+}
+
+Awaitable<scada::StatusOr<scada::ReferenceDescriptions>>
+SnapshotNodeFetcher::FetchChildren(const scada::NodeId& node_id) {
+  if (auto children = snapshot_children_.extract(node_id)) {
+    ++snapshot_hit_count_;
+    known_children_.insert_or_assign(node_id, children.mapped());
+    Revalidate({.node_id = node_id, .children = true});
+    co_return std::move(children.mapped());
+  }
+
+  auto references = co_await node_fetcher_->FetchChildren(node_id);
+  if (references.ok())
+    known_children_.insert_or_assign(node_id, *references);
+  co_return references;
+}
+
+void SnapshotNodeFetcher::OnModelChanged(const scada::ModelChangeEvent& event) {
+  // Any change may outdate the node as well as its children. What is dropped
+  // here is fetched from the server the next time it is asked for.
+  snapshot_nodes_.erase(event.node_id);
+  snapshot_children_.erase(event.node_id);
+  known_nodes_.erase(event.node_id);
+  known_children_.erase(event.node_id);
+
+  node_fetcher_->OnModelChanged(event);
+}
+
+void SnapshotNodeFetcher::Revalidate(Revalidation revalidation) {
+  pending_revalidations_.emplace_back(std::move(revalidation));
+  PostRevalidations();
+}
+
+void SnapshotNodeFetcher::PostRevalidations() {
+  if (revalidation_posted_ ||
+      running_revalidation_count_ >= kMaxRunningRevalidationCount ||
+      pending_revalidations_.empty()) {
+    return;
+  }
+
+  revalidation_posted_ = true;
+
+  // Let the nodes served in the current executor tick reach the service
+  // first, and start their revalidations together, so the wrapped fetcher can
+  // batch them.
+  CoSpawn(executor_, cancelation_,
+          [this, cancelation = cancelation_.ref()]() -> Awaitable<void> {
+            co_await boost::asio::post(boost::asio::use_awaitable);
+            if (cancelation.canceled())
+              co_return;
+            revalidation_posted_ = false;
+            StartRevalidations();
+          });
+}
+
+void SnapshotNodeFetcher::StartRevalidations() {
+  while (running_revalidation_count_ < kMaxRunningRevalidationCount &&
+         !pending_revalidations_.empty()) {
+    auto revalidation = std::move(pending_revalidations_.front());
+    pending_revalidations_.pop_front();
+    ++running_revalidation_count_;
+
+    CoSpawn(executor_, cancelation_,
+            [this, cancelation = cancelation_.ref(),
+             revalidation = std::move(revalidation)]() -> Awaitable<void> {
+              if (revalidation.children) {
+                auto references =
+                    co_await node_fetcher_->FetchChildren(revalidation.node_id);
+                if (cancelation.canceled())
+                  co_return;
+                OnChildrenRevalidated(revalidation.node_id,
+                                      std::move(references));
+              } else {
+                auto node_state =
+                    co_await node_fetcher_->FetchNode(revalidation.node_id);
+                if (cancelation.canceled())
+                  co_return;
+                OnNodeRevalidated(revalidation.node_id, std::move(node_state));
+              }
+            });
+  }
+}
+
+void SnapshotNodeFetcher::OnNodeRevalidated(
+    const scada::NodeId& node_id,
+    scada::StatusOr<scada::NodeState> node_state) {
+  --running_revalidation_count_;
+  PostRevalidations();
+
+  auto i = known_nodes_.find(node_id);
+  // Dropped by a model change meanwhile.
+  if (i == known_nodes_.end())
+    return;
+
+  if (!node_state.ok()) {
+    // Other failures, like a lost connection, say nothing about the node.
+    if (node_state.status().code() == scada::StatusCode::Bad_WrongNodeId) {
+      known_nodes_.erase(i);
+      known_children_.erase(node_id);
+      ReportStaleNode(node_id, /*deleted=*/true);
+    }
+    return;
+  }
+
+  if (IsSameNodeState(i->second, *node_state))
+    return;
+
+  i->second = std::move(*node_state);
+  ReportStaleNode(node_id, /*deleted=*/false);
+}
+
+void SnapshotNodeFetcher::OnChildrenRevalidated(
+    const scada::NodeId& node_id,
+    scada::StatusOr<scada::ReferenceDescriptions> references) {
+  --running_revalidation_count_;
+  PostRevalidations();
+
+  auto i = known_children_.find(node_id);
+  if (i == known_children_.end() || !references.ok() ||
+      i->second == *references) {
+    return;
+  }
+
+  i->second = std::move(*references);
+  ReportStaleNode(node_id, /*deleted=*/false);
+}
+
+void SnapshotNodeFetcher::ReportStaleNode(const scada::NodeId& node_id,
+                                          bool deleted) {
+  ++stale_node_count_;
+
+  LOG_INFO(Logger()) << "Snapshot node is stale"
+                     << LOG_TAG("NodeId", NodeIdToScadaString(node_id))
+                     << LOG_TAG("Deleted", deleted);
+
+  if (!stale_node_handler_)
+    return;
+
+  scada::ModelChangeEvent event{node_id, {},
+                                scada::ModelChangeEvent::ReferenceAdded |
+                                    scada::ModelChangeEvent::ReferenceDeleted};
+  if (deleted)
+    event.verb = scada::ModelChangeEvent::NodeDeleted;
+
+  // The handler may fetch the node again right away.
+  stale_node_handler_(event);
+}
+
+}  // namespace v3
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "base/any_executor.h"
+#include "base/awaitable.h"
+#include "common/node_state.h"
+#include "node_service/v3/node_fetcher.h"
+
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace scada {
+struct ModelChangeEvent;
+}  // namespace scada
+
+namespace v3 {
+
+struct SnapshotNodeFetcherContext {
+  AnyExecutor executor_;
+
+  // Fetcher the snapshot is revalidated against, and which serves everything
+  // the snapshot doesn't hold.
+  const std::shared_ptr<NodeFetcher> node_fetcher_;
+
+  // Loaded on construction and rewritten by Save(). A missing or outdated
+  // file starts an empty snapshot.
+  const std::filesystem::path path_;
+
+  // Receives a model change for every node served from the snapshot that
+  // revalidation found stale, so the service can refetch it.
+  const std::function<void(const scada::ModelChangeEvent& event)>
+      stale_node_handler_;
+};
+
+// A v3::NodeFetcher decorator that keeps fetched node states and child
+// reference lists in an on-disk snapshot between client runs.
+//
+// A restarted client gets every node the snapshot holds at once, without a
+// server round trip. Each served node is then revalidated in the background
+// through the wrapped fetcher; a node that changed on the server is reported
+// to |stale_node_handler_| as a model change. A snapshot entry is served only
+// once: refetches always go to the server. Model changes the server reports
+// drop the affected entries before they can be served.
+class SnapshotNodeFetcher : private SnapshotNodeFetcherContext,
+                            public NodeFetcher {
+ public:
+  explicit SnapshotNodeFetcher(SnapshotNodeFetcherContext&& context);
+  ~SnapshotNodeFetcher();
+
+  // NodeFetcher
+  Awaitable<scada::StatusOr<scada::NodeState>> FetchNode(
+      const scada::NodeId& node_id) override;
+  Awaitable<scada::StatusOr<scada::ReferenceDescriptions>> FetchChildren(
+      const scada::NodeId& node_id) override;
+  void OnModelChanged(const scada::ModelChangeEvent& event) override;
+
+  // Writes the nodes known so far to |path_|, usually on shutdown. Returns
+  // false on I/O error.
+  bool Save() const;
+
+  // Diagnostics.
+  size_t snapshot_hit_count() const { return snapshot_hit_count_; }
+  size_t stale_node_count() const { return stale_node_count_; }
+  size_t pending_revalidation_count() const {
+    return pending_revalidations_.size() + running_revalidation_count_;
+  }
+
+  // Revalidation fetches in flight at once. Fetches started together are
+  // coalesced by the wrapped fetcher, so this is also the batch size.
+  static constexpr size_t kMaxRunningRevalidationCount = 500;
+
+ private:
+  struct Revalidation {
+    scada::NodeId node_id;
+    bool children = false;
+  };
+
+  void Load();
+
+  void Revalidate(Revalidation revalidation);
+  void PostRevalidations();
+  void StartRevalidations();
+
+  void OnNodeRevalidated(const scada::NodeId& node_id,
+                         scada::StatusOr<scada::NodeState> node_state);
+  void OnChildrenRevalidated(
+      const scada::NodeId& node_id,
+      scada::StatusOr<scada::ReferenceDescriptions> references);
+
+  void ReportStaleNode(const scada::NodeId& node_id, bool deleted);
+
+  // Loaded entries not served yet.
+  std::unordered_map<scada::NodeId, scada::NodeState> snapshot_nodes_;
+  std::unordered_map<scada::NodeId, scada::ReferenceDescriptions>
+      snapshot_children_;
+
+  // Latest known data, saved as the next snapshot.
+  std::unordered_map<scada::NodeId, scada::NodeState> known_nodes_;
+  std::unordered_map<scada::NodeId, scada::ReferenceDescriptions>
+      known_children_;
+
+  std::deque<Revalidation> pending_revalidations_;
+  size_t running_revalidation_count_ = 0;
+  bool revalidation_posted_ = false;
+
+  size_t snapshot_hit_count_ = 0;
+  size_t stale_node_count_ = 0;
+
+  Cancelation cancelation_;
+};
+
+}  // namespace v3
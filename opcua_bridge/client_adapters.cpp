@@ -71,7 +71,7 @@ ClientViewServiceAdapter::Browse(scada::ServiceContext context,
   });
   auto result =
       co_await session_->Browse(ToOpcua(context), ToOpcuaVector(inputs));
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 
 Awaitable<scada::StatusOr<std::vector<scada::BrowsePathResult>>>
@@ -86,7 +86,7 @@ ClientViewServiceAdapter::TranslateBrowsePaths(
   });
   auto result = co_await session_->TranslateBrowsePaths(ToOpcuaVector(inputs),
                                                         span.traceparent());
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 
 // --- AttributeService ---------------------------------------------------
@@ -101,7 +101,7 @@ ClientAttributeServiceAdapter::Read(scada::ServiceContext context,
       ToOpcuaVector(inputs));
   auto result =
       co_await session_->Read(ToOpcua(context), std::move(opcua_inputs));
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 
 Awaitable<scada::StatusOr<std::vector<scada::StatusCode>>>
@@ -115,7 +115,7 @@ ClientAttributeServiceAdapter::Write(scada::ServiceContext context,
       ToOpcuaVector(inputs));
   auto result =
       co_await session_->Write(ToOpcua(context), std::move(opcua_inputs));
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 
 // --- MethodService ------------------------------------------------------
@@ -147,7 +147,7 @@ ClientNodeManagementServiceAdapter::AddNodes(
   });
   auto result =
       co_await session_->AddNodes(ToOpcuaVector(inputs), span.traceparent());
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 Awaitable<scada::StatusOr<std::vector<scada::StatusCode>>>
 ClientNodeManagementServiceAdapter::DeleteNodes(
@@ -159,7 +159,7 @@ ClientNodeManagementServiceAdapter::DeleteNodes(
   });
   auto result =
       co_await session_->DeleteNodes(ToOpcuaVector(inputs), span.traceparent());
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 Awaitable<scada::StatusOr<std::vector<scada::StatusCode>>>
 ClientNodeManagementServiceAdapter::AddReferences(
@@ -171,7 +171,7 @@ ClientNodeManagementServiceAdapter::AddReferences(
   });
   auto result = co_await session_->AddReferences(ToOpcuaVector(inputs),
                                                  span.traceparent());
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 Awaitable<scada::StatusOr<std::vector<scada::StatusCode>>>
 ClientNodeManagementServiceAdapter::DeleteReferences(
@@ -185,7 +185,7 @@ ClientNodeManagementServiceAdapter::DeleteReferences(
                      });
   auto result = co_await session_->DeleteReferences(ToOpcuaVector(inputs),
                                                     span.traceparent());
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 
 // --- MonitoredItemSubscription -----------------------------------------
@@ -193,19 +193,19 @@ Awaitable<std::vector<scada::MonitoredItemCreateResult>>
 ClientMonitoredItemSubscriptionAdapter::AddItems(
     std::vector<scada::MonitoredItemCreateRequest> requests) {
   auto results = co_await inner_->AddItems(ToOpcuaVector(requests));
-  co_return ToScadaVector(results);
+  co_return ToScadaVector(std::move(results));
 }
 Awaitable<std::vector<scada::Status>>
 ClientMonitoredItemSubscriptionAdapter::RemoveItems(
     std::span<const scada::MonitoredItemId> item_ids) {
   // MonitoredItemId is std::uint32_t on both sides.
   auto results = co_await inner_->RemoveItems(item_ids);
-  co_return ToScadaVector(results);
+  co_return ToScadaVector(std::move(results));
 }
 Awaitable<scada::StatusOr<std::vector<scada::MonitoredItemNotification>>>
 ClientMonitoredItemSubscriptionAdapter::ReadNext(std::size_t max_count) {
   auto result = co_await inner_->ReadNext(max_count);
-  co_return ToScada(result);
+  co_return ToScada(std::move(result));
 }
 void ClientMonitoredItemSubscriptionAdapter::Close(scada::Status status) {
   inner_->Close(ToOpcua(status));
@@ -241,7 +241,7 @@ ClientHistoryServiceAdapter::HistoryReadRaw(
   if (!result.ok()) {
     co_return scada::HistoryReadRawResult{.status = ToScada(result.status())};
   }
-  co_return ToScada(*result);
+  co_return ToScada(std::move(*result));
 }
 
 Awaitable<scada::HistoryReadEventsResult>
@@ -262,7 +262,7 @@ ClientHistoryServiceAdapter::HistoryReadEvents(scada::NodeId node_id,
     co_return scada::HistoryReadEventsResult{.status =
                                                  ToScada(result.status())};
   }
-  co_return ToScada(*result);
+  co_return ToScada(std::move(*result));
 }
 
 Awaitable<scada::StatusOr<std::vector<scada::StatusCode>>>
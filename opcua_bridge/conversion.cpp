@@ -8,40 +8,171 @@
 
 #include <any>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace scada::opcua_bridge {
 
 namespace {
 
+// The value of type T held by `v`: a const reference when `v` is an lvalue, an
+// rvalue reference when `v` is an rvalue, so converting a Variant the caller
+// gave up moves its payload out.
+template <class T, class V>
+decltype(auto) GetValue(V&& v) {
+  if constexpr (std::is_lvalue_reference_v<V>)
+    return std::as_const(v).template get<T>();
+  else
+    return std::move(v.template get<T>());
+}
+
 // Scalar-or-array conversion for an "identity" element type T (the same std
 // type on both sides: bool, the numeric primitives, String, ByteString). The
 // opcua Variant accepts the value directly.
-template <class T>
-opcua::Variant ToOpcuaSame(const scada::Variant& v) {
+template <class T, class V>
+opcua::Variant ToOpcuaSame(V&& v) {
   if (v.is_array())
-    return opcua::Variant{v.get<std::vector<T>>()};
-  return opcua::Variant{v.get<T>()};
+    return opcua::Variant{GetValue<std::vector<T>>(std::forward<V>(v))};
+  return opcua::Variant{GetValue<T>(std::forward<V>(v))};
 }
-template <class T>
-scada::Variant ToScadaSame(const opcua::Variant& v) {
+template <class T, class V>
+scada::Variant ToScadaSame(V&& v) {
   if (v.is_array())
-    return scada::Variant{v.get<std::vector<T>>()};
-  return scada::Variant{v.get<T>()};
+    return scada::Variant{GetValue<std::vector<T>>(std::forward<V>(v))};
+  return scada::Variant{GetValue<T>(std::forward<V>(v))};
 }
 
 // Scalar-or-array conversion for a class element type that must be converted.
-template <class T>
-opcua::Variant ToOpcuaConv(const scada::Variant& v) {
+template <class T, class V>
+opcua::Variant ToOpcuaConv(V&& v) {
   if (v.is_array())
-    return opcua::Variant{ToOpcuaVector(v.get<std::vector<T>>())};
-  return opcua::Variant{ToOpcua(v.get<T>())};
+    return opcua::Variant{
+        ToOpcuaVector(GetValue<std::vector<T>>(std::forward<V>(v)))};
+  return opcua::Variant{ToOpcua(GetValue<T>(std::forward<V>(v)))};
 }
-template <class T>
-scada::Variant ToScadaConv(const opcua::Variant& v) {
+template <class T, class V>
+scada::Variant ToScadaConv(V&& v) {
   if (v.is_array())
-    return scada::Variant{ToScadaVector(v.get<std::vector<T>>())};
-  return scada::Variant{ToScada(v.get<T>())};
+    return scada::Variant{
+        ToScadaVector(GetValue<std::vector<T>>(std::forward<V>(v)))};
+  return scada::Variant{ToScada(GetValue<T>(std::forward<V>(v)))};
+}
+
+template <class V>
+opcua::Variant VariantToOpcua(V&& v) {
+  using Type = scada::Variant;
+  switch (v.type()) {
+    case Type::EMPTY:
+      return {};
+    case Type::BOOL:
+      return ToOpcuaSame<bool>(std::forward<V>(v));
+    case Type::INT8:
+      return ToOpcuaSame<scada::Int8>(std::forward<V>(v));
+    case Type::UINT8:
+      return ToOpcuaSame<scada::UInt8>(std::forward<V>(v));
+    case Type::INT16:
+      return ToOpcuaSame<scada::Int16>(std::forward<V>(v));
+    case Type::UINT16:
+      return ToOpcuaSame<scada::UInt16>(std::forward<V>(v));
+    case Type::INT32:
+      return ToOpcuaSame<scada::Int32>(std::forward<V>(v));
+    case Type::UINT32:
+      return ToOpcuaSame<scada::UInt32>(std::forward<V>(v));
+    case Type::INT64:
+      return ToOpcuaSame<scada::Int64>(std::forward<V>(v));
+    case Type::UINT64:
+      return ToOpcuaSame<scada::UInt64>(std::forward<V>(v));
+    case Type::DOUBLE:
+      return ToOpcuaSame<scada::Double>(std::forward<V>(v));
+    case Type::BYTE_STRING:
+      return ToOpcuaSame<scada::ByteString>(std::forward<V>(v));
+    case Type::STRING:
+      return ToOpcuaSame<scada::String>(std::forward<V>(v));
+    case Type::LOCALIZED_TEXT:
+      return ToOpcuaConv<scada::LocalizedText>(std::forward<V>(v));
+    case Type::QUALIFIED_NAME:
+      return ToOpcuaConv<scada::QualifiedName>(std::forward<V>(v));
+    case Type::NODE_ID:
+      return ToOpcuaConv<scada::NodeId>(std::forward<V>(v));
+    case Type::EXPANDED_NODE_ID:
+      return ToOpcuaConv<scada::ExpandedNodeId>(std::forward<V>(v));
+    case Type::EXTENSION_OBJECT:
+      return ToOpcuaConv<scada::ExtensionObject>(std::forward<V>(v));
+    case Type::DATE_TIME:  // no array alternative for DateTime
+      return opcua::Variant{ToOpcua(v.template get<scada::DateTime>())};
+    default:
+      return {};
+  }
+}
+
+template <class V>
+scada::Variant VariantToScada(V&& v) {
+  using Type = opcua::Variant;
+  switch (v.type()) {
+    case Type::EMPTY:
+      return {};
+    case Type::BOOL:
+      return ToScadaSame<bool>(std::forward<V>(v));
+    case Type::INT8:
+      return ToScadaSame<opcua::Int8>(std::forward<V>(v));
+    case Type::UINT8:
+      return ToScadaSame<opcua::UInt8>(std::forward<V>(v));
+    case Type::INT16:
+      return ToScadaSame<opcua::Int16>(std::forward<V>(v));
+    case Type::UINT16:
+      return ToScadaSame<opcua::UInt16>(std::forward<V>(v));
+    case Type::INT32:
+      return ToScadaSame<opcua::Int32>(std::forward<V>(v));
+    case Type::UINT32:
+      return ToScadaSame<opcua::UInt32>(std::forward<V>(v));
+    case Type::INT64:
+      return ToScadaSame<opcua::Int64>(std::forward<V>(v));
+    case Type::UINT64:
+      return ToScadaSame<opcua::UInt64>(std::forward<V>(v));
+    case Type::DOUBLE:
+      return ToScadaSame<opcua::Double>(std::forward<V>(v));
+    case Type::BYTE_STRING:
+      return ToScadaSame<opcua::ByteString>(std::forward<V>(v));
+    case Type::STRING:
+      return ToScadaSame<opcua::String>(std::forward<V>(v));
+    case Type::LOCALIZED_TEXT:
+      return ToScadaConv<opcua::LocalizedText>(std::forward<V>(v));
+    case Type::QUALIFIED_NAME:
+      return ToScadaConv<opcua::QualifiedName>(std::forward<V>(v));
+    case Type::NODE_ID:
+      return ToScadaConv<opcua::NodeId>(std::forward<V>(v));
+    case Type::EXPANDED_NODE_ID:
+      return ToScadaConv<opcua::ExpandedNodeId>(std::forward<V>(v));
+    case Type::EXTENSION_OBJECT:
+      return ToScadaConv<opcua::ExtensionObject>(std::forward<V>(v));
+    case Type::DATE_TIME:
+      return scada::Variant{ToScada(v.template get<opcua::DateTime>())};
+    default:
+      return {};
+  }
+}
+
+template <class D>
+opcua::DataValue DataValueToOpcua(D&& d) {
+  opcua::DataValue out;
+  out.value = ToOpcua(std::forward<D>(d).value);
+  out.qualifier = ToOpcua(d.qualifier);
+  out.source_timestamp = ToOpcua(d.source_timestamp);
+  out.server_timestamp = ToOpcua(d.server_timestamp);
+  out.status_code = ToOpcua(d.status_code);
+  return out;
+}
+
+template <class D>
+scada::DataValue DataValueToScada(D&& d) {
+  scada::DataValue out;
+  out.value = ToScada(std::forward<D>(d).value);
+  out.qualifier = ToScada(d.qualifier);
+  out.source_timestamp = ToScada(d.source_timestamp);
+  out.server_timestamp = ToScada(d.server_timestamp);
+  out.status_code = ToScada(d.status_code);
+  return out;
 }
 
 }  // namespace
@@ -153,114 +284,29 @@ scada::ExtensionObject ToScada(const opcua::ExtensionObject& e) {
 }
 
 opcua::Variant ToOpcua(const scada::Variant& v) {
-  using V = scada::Variant;
-  switch (v.type()) {
-    case V::EMPTY:
-      return {};
-    case V::BOOL:
-      return ToOpcuaSame<bool>(v);
-    case V::INT8:
-      return ToOpcuaSame<scada::Int8>(v);
-    case V::UINT8:
-      return ToOpcuaSame<scada::UInt8>(v);
-    case V::INT16:
-      return ToOpcuaSame<scada::Int16>(v);
-    case V::UINT16:
-      return ToOpcuaSame<scada::UInt16>(v);
-    case V::INT32:
-      return ToOpcuaSame<scada::Int32>(v);
-    case V::UINT32:
-      return ToOpcuaSame<scada::UInt32>(v);
-    case V::INT64:
-      return ToOpcuaSame<scada::Int64>(v);
-    case V::UINT64:
-      return ToOpcuaSame<scada::UInt64>(v);
-    case V::DOUBLE:
-      return ToOpcuaSame<scada::Double>(v);
-    case V::BYTE_STRING:
-      return ToOpcuaSame<scada::ByteString>(v);
-    case V::STRING:
-      return ToOpcuaSame<scada::String>(v);
-    case V::LOCALIZED_TEXT:
-      return ToOpcuaConv<scada::LocalizedText>(v);
-    case V::QUALIFIED_NAME:
-      return ToOpcuaConv<scada::QualifiedName>(v);
-    case V::NODE_ID:
-      return ToOpcuaConv<scada::NodeId>(v);
-    case V::EXPANDED_NODE_ID:
-      return ToOpcuaConv<scada::ExpandedNodeId>(v);
-    case V::EXTENSION_OBJECT:
-      return ToOpcuaConv<scada::ExtensionObject>(v);
-    case V::DATE_TIME:  // no array alternative for DateTime
-      return opcua::Variant{ToOpcua(v.get<scada::DateTime>())};
-    default:
-      return {};
-  }
+  return VariantToOpcua(v);
+}
+opcua::Variant ToOpcua(scada::Variant&& v) {
+  return VariantToOpcua(std::move(v));
 }
-
 scada::Variant ToScada(const opcua::Variant& v) {
-  using V = opcua::Variant;
-  switch (v.type()) {
-    case V::EMPTY:
-      return {};
-    case V::BOOL:
-      return ToScadaSame<bool>(v);
-    case V::INT8:
-      return ToScadaSame<opcua::Int8>(v);
-    case V::UINT8:
-      return ToScadaSame<opcua::UInt8>(v);
-    case V::INT16:
-      return ToScadaSame<opcua::Int16>(v);
-    case V::UINT16:
-      return ToScadaSame<opcua::UInt16>(v);
-    case V::INT32:
-      return ToScadaSame<opcua::Int32>(v);
-    case V::UINT32:
-      return ToScadaSame<opcua::UInt32>(v);
-    case V::INT64:
-      return ToScadaSame<opcua::Int64>(v);
-    case V::UINT64:
-      return ToScadaSame<opcua::UInt64>(v);
-    case V::DOUBLE:
-      return ToScadaSame<opcua::Double>(v);
-    case V::BYTE_STRING:
-      return ToScadaSame<opcua::ByteString>(v);
-    case V::STRING:
-      return ToScadaSame<opcua::String>(v);
-    case V::LOCALIZED_TEXT:
-      return ToScadaConv<opcua::LocalizedText>(v);
-    case V::QUALIFIED_NAME:
-      return ToScadaConv<opcua::QualifiedName>(v);
-    case V::NODE_ID:
-      return ToScadaConv<opcua::NodeId>(v);
-    case V::EXPANDED_NODE_ID:
-      return ToScadaConv<opcua::ExpandedNodeId>(v);
-    case V::EXTENSION_OBJECT:
-      return ToScadaConv<opcua::ExtensionObject>(v);
-    case V::DATE_TIME:
-      return scada::Variant{ToScada(v.get<opcua::DateTime>())};
-    default:
-      return {};
-  }
+  return VariantToScada(v);
+}
+scada::Variant ToScada(opcua::Variant&& v) {
+  return VariantToScada(std::move(v));
 }
 
 opcua::DataValue ToOpcua(const scada::DataValue& d) {
-  opcua::DataValue out;
-  out.value = ToOpcua(d.value);
-  out.qualifier = ToOpcua(d.qualifier);
-  out.source_timestamp = ToOpcua(d.source_timestamp);
-  out.server_timestamp = ToOpcua(d.server_timestamp);
-  out.status_code = ToOpcua(d.status_code);
-  return out;
+  return DataValueToOpcua(d);
+}
+opcua::DataValue ToOpcua(scada::DataValue&& d) {
+  return DataValueToOpcua(std::move(d));
 }
 scada::DataValue ToScada(const opcua::DataValue& d) {
-  scada::DataValue out;
-  out.value = ToScada(d.value);
-  out.qualifier = ToScada(d.qualifier);
-  out.source_timestamp = ToScada(d.source_timestamp);
-  out.server_timestamp = ToScada(d.server_timestamp);
-  out.status_code = ToScada(d.status_code);
-  return out;
+  return DataValueToScada(d);
+}
+scada::DataValue ToScada(opcua::DataValue&& d) {
+  return DataValueToScada(std::move(d));
 }
 
 }  // namespace scada::opcua_bridge
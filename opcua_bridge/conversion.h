@@ -29,6 +29,7 @@
 #include "opcua/types/variant.h"
 
 #include <limits>
+#include <utility>
 #include <vector>
 
 namespace scada::opcua_bridge {
@@ -177,6 +178,12 @@ inline opcua::LocalizedText ToOpcua(const scada::LocalizedText& t) {
 inline scada::LocalizedText ToScada(const opcua::LocalizedText& t) {
   return scada::LocalizedText{t.locale, t.text};
 }
+inline opcua::LocalizedText ToOpcua(scada::LocalizedText&& t) {
+  return opcua::LocalizedText{std::move(t.locale), std::move(t.text)};
+}
+inline scada::LocalizedText ToScada(opcua::LocalizedText&& t) {
+  return scada::LocalizedText{std::move(t.locale), std::move(t.text)};
+}
 
 // --- class types --------------------------------------------------------
 opcua::NodeId ToOpcua(const scada::NodeId&);
@@ -191,11 +198,18 @@ scada::QualifiedName ToScada(const opcua::QualifiedName&);
 opcua::ExtensionObject ToOpcua(const scada::ExtensionObject&);
 scada::ExtensionObject ToScada(const opcua::ExtensionObject&);
 
+// The rvalue overloads move string, byte-string and array payloads across
+// instead of copying them; a same-typed array (numeric, String, ByteString)
+// crosses as the very same buffer.
 opcua::Variant ToOpcua(const scada::Variant&);
 scada::Variant ToScada(const opcua::Variant&);
+opcua::Variant ToOpcua(scada::Variant&&);
+scada::Variant ToScada(opcua::Variant&&);
 
 opcua::DataValue ToOpcua(const scada::DataValue&);
 scada::DataValue ToScada(const opcua::DataValue&);
+opcua::DataValue ToOpcua(scada::DataValue&&);
+scada::DataValue ToScada(opcua::DataValue&&);
 
 // The element-wise vector helpers (ToOpcuaVector / ToScadaVector) live in
 // vector_conversion.h, which both .cpp files include AFTER all ToOpcua/ToScada
@@ -0,0 +1,108 @@
+#include "opcua_bridge/event_projection.h"
+
+#include "opcua_bridge/service_conversion.h"
+
+#include "opcua/events/event_filter.h"
+
+#include <string_view>
+#include <utility>
+
+namespace scada::opcua_bridge {
+namespace {
+
+using FieldAccessor = opcua::Variant (*)(const scada::Event& event);
+
+struct DirectField {
+  std::string_view browse_name;
+  FieldAccessor accessor;
+};
+
+// Same values and encodings opcua::ProjectEventFields produces for these
+// BaseEventType properties (OPC UA Part 5 §6.4.2,
+// https://reference.opcfoundation.org/Core/Part5/v105/docs/6.4.2).
+constexpr DirectField kDirectFields[] = {
+    {"EventId",
+     [](const scada::Event& e) {
+       return opcua::Variant{opcua::EncodeEventIdByteString(e.event_id)};
+     }},
+    {"EventType",
+     [](const scada::Event& e) {
+       return opcua::Variant{ToOpcua(e.event_type_id)};
+     }},
+    {"SourceNode",
+     [](const scada::Event& e) {
+       return opcua::Variant{ToOpcua(e.source_node_id)};
+     }},
+    {"Time",
+     [](const scada::Event& e) { return opcua::Variant{ToOpcua(e.time)}; }},
+    {"ReceiveTime",
+     [](const scada::Event& e) {
+       return opcua::Variant{ToOpcua(e.receive_time)};
+     }},
+    {"Message",
+     [](const scada::Event& e) { return opcua::Variant{ToOpcua(e.message)}; }},
+    {"Severity",
+     [](const scada::Event& e) {
+       return opcua::Variant{static_cast<opcua::UInt16>(e.severity)};
+     }},
+};
+
+FieldAccessor FindDirectField(const std::vector<std::string>& field_path) {
+  if (field_path.size() != 1)
+    return nullptr;
+  for (const auto& field : kDirectFields) {
+    if (field.browse_name == field_path.front())
+      return field.accessor;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+EventProjection::EventProjection(
+    std::vector<std::vector<std::string>> field_paths)
+    : field_paths_{std::move(field_paths)} {
+  accessors_.reserve(field_paths_.size());
+  for (std::size_t i = 0; i < field_paths_.size(); ++i) {
+    const auto accessor = FindDirectField(field_paths_[i]);
+    accessors_.push_back(accessor);
+    if (!accessor) {
+      fallback_paths_.push_back(field_paths_[i]);
+      fallback_indexes_.push_back(i);
+    }
+  }
+}
+
+// static
+const EventProjection& EventProjection::Default() {
+  static const EventProjection projection{opcua::NormalizeEventFieldPaths({})};
+  return projection;
+}
+
+std::vector<opcua::Variant> EventProjection::Project(
+    const scada::Event& event) const {
+  std::vector<opcua::Variant> event_fields(field_paths_.size());
+
+  if (!fallback_paths_.empty()) {
+    auto fallback_fields =
+        opcua::ProjectEventFields(fallback_paths_, std::any{ToOpcua(event)});
+    for (std::size_t i = 0;
+         i < fallback_indexes_.size() && i < fallback_fields.size(); ++i) {
+      event_fields[fallback_indexes_[i]] = std::move(fallback_fields[i]);
+    }
+  }
+
+  for (std::size_t i = 0; i < accessors_.size(); ++i) {
+    if (accessors_[i])
+      event_fields[i] = accessors_[i](event);
+  }
+
+  return event_fields;
+}
+
+std::vector<opcua::Variant> EventProjection::Project(
+    std::any opcua_event) const {
+  return opcua::ProjectEventFields(field_paths_, std::move(opcua_event));
+}
+
+}  // namespace scada::opcua_bridge
@@ -0,0 +1,58 @@
+#pragma once
+
+// A monitored item's EventFilter select clauses, compiled once when the item
+// is added so that publishing an event does not re-walk its field paths.
+
+#include "scada/event.h"
+
+#include "opcua/types/variant.h"
+
+#include <any>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace scada::opcua_bridge {
+
+// Projects core events onto a fixed list of select-clause field paths,
+// producing the `event_fields` of a wire EventFieldList.
+//
+// The BaseEventType fields publishers select on every event (EventId,
+// EventType, SourceNode, Time, ReceiveTime, Message, Severity) resolve to
+// direct reads of the scada::Event. Any other path is left to
+// opcua::ProjectEventFields, which then sees only those paths; a projection
+// made entirely of direct fields never converts the event to opcua::Event.
+class EventProjection {
+ public:
+  explicit EventProjection(std::vector<std::vector<std::string>> field_paths);
+
+  // The default BaseEventType projection used for items without select
+  // clauses.
+  static const EventProjection& Default();
+
+  const std::vector<std::vector<std::string>>& field_paths() const {
+    return field_paths_;
+  }
+
+  // Number of direct fields; diagnostics and tests.
+  std::size_t direct_field_count() const {
+    return field_paths_.size() - fallback_paths_.size();
+  }
+
+  std::vector<opcua::Variant> Project(const scada::Event& event) const;
+
+  // Generic projection of an opcua::Event payload (or of no event at all).
+  std::vector<opcua::Variant> Project(std::any opcua_event) const;
+
+ private:
+  using FieldAccessor = opcua::Variant (*)(const scada::Event& event);
+
+  std::vector<std::vector<std::string>> field_paths_;
+  // Indexed like |field_paths_|; null for paths projected by the library.
+  std::vector<FieldAccessor> accessors_;
+  // Paths without an accessor, and their indexes in |field_paths_|.
+  std::vector<std::vector<std::string>> fallback_paths_;
+  std::vector<std::size_t> fallback_indexes_;
+};
+
+}  // namespace scada::opcua_bridge
@@ -0,0 +1,115 @@
+#include "opcua_bridge/event_projection.h"
+
+#include "opcua_bridge/service_conversion.h"
+
+#include "scada/standard_node_ids.h"
+
+#include "opcua/events/event_filter.h"
+
+#include <any>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace scada::opcua_bridge {
+namespace {
+
+scada::Event MakeTestEvent() {
+  scada::Event event;
+  event.event_type_id = scada::id::SystemEventType;
+  event.event_id = 0x123456789;
+  event.time = scada::DateTime::Now();
+  event.receive_time = scada::DateTime::Now();
+  event.change_mask = scada::Event::EVT_VAL;
+  event.severity = 600;
+  event.source_node_id = scada::NodeId{42, 2};
+  event.source_name = "Pump 42";
+  event.user_id = scada::NodeId{7, 3};
+  event.value = scada::Variant{123};
+  event.message = scada::LocalizedText{u"storm alarm"};
+  return event;
+}
+
+// The compiled projection must produce exactly what the generic projection of
+// the converted event produces.
+void ExpectSameAsGenericProjection(
+    const std::vector<std::vector<std::string>>& field_paths) {
+  const auto event = MakeTestEvent();
+  const EventProjection projection{field_paths};
+
+  const auto fields = projection.Project(event);
+  const auto expected =
+      opcua::ProjectEventFields(field_paths, std::any{ToOpcua(event)});
+
+  ASSERT_EQ(fields.size(), expected.size());
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    EXPECT_EQ(ToScada(fields[i]), ToScada(expected[i])) << "field " << i;
+  }
+}
+
+}  // namespace
+
+TEST(EventProjectionTest, DirectFieldsMatchGenericProjection) {
+  const std::vector<std::vector<std::string>> field_paths{
+      {"EventId"}, {"EventType"}, {"SourceNode"}, {"Time"},
+      {"ReceiveTime"}, {"Message"}, {"Severity"}};
+  EXPECT_EQ(EventProjection{field_paths}.direct_field_count(),
+            field_paths.size());
+  ExpectSameAsGenericProjection(field_paths);
+}
+
+TEST(EventProjectionTest, MixedFieldsMatchGenericProjection) {
+  const std::vector<std::vector<std::string>> field_paths{
+      {"Message"}, {"SourceName"}, {"Severity"}, {"Message", "Text"},
+      {"EventId"}, {"NoSuchField"}};
+  EXPECT_EQ(EventProjection{field_paths}.direct_field_count(), 3u);
+  ExpectSameAsGenericProjection(field_paths);
+}
+
+TEST(EventProjectionTest, DefaultMatchesGenericProjection) {
+  EXPECT_EQ(EventProjection::Default().field_paths(),
+            opcua::NormalizeEventFieldPaths({}));
+  ExpectSameAsGenericProjection(EventProjection::Default().field_paths());
+}
+
+TEST(EventProjectionTest, ProjectsNoEvent) {
+  const std::vector<std::vector<std::string>> field_paths{{"Message"},
+                                                          {"SourceName"}};
+  EXPECT_EQ(EventProjection{field_paths}.Project(std::any{}).size(),
+            opcua::ProjectEventFields(field_paths, std::any{}).size());
+}
+
+// Compares the compiled projection against projecting every event through
+// opcua::ProjectEventFields, for an alarm storm on a typical alarm-list select.
+// Run manually with --gtest_also_run_disabled_tests.
+TEST(EventProjectionTest, DISABLED_ProjectionBenchmark) {
+  constexpr int kEventCount = 100'000;
+  const std::vector<std::vector<std::string>> field_paths{
+      {"EventId"},    {"EventType"}, {"SourceNode"}, {"SourceName"},
+      {"Time"},       {"ReceiveTime"}, {"Message"},  {"Severity"}};
+  const EventProjection projection{field_paths};
+  const auto event = MakeTestEvent();
+
+  const auto measure = [&](auto&& project) {
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t field_count = 0;
+    for (int i = 0; i < kEventCount; ++i)
+      field_count += project().size();
+    EXPECT_EQ(field_count, kEventCount * field_paths.size());
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+  };
+
+  const auto generic = measure([&] {
+    return opcua::ProjectEventFields(field_paths, std::any{ToOpcua(event)});
+  });
+  const auto compiled = measure([&] { return projection.Project(event); });
+
+  std::cout << kEventCount << " events: generic " << generic.count()
+            << " us, compiled " << compiled.count() << " us" << std::endl;
+}
+
+}  // namespace scada::opcua_bridge
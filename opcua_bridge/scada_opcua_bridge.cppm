@@ -13,6 +13,7 @@ module;
 // ---- Global module fragment: headers stay the source of truth ----
 #include "opcua_bridge/client_adapters.h"
 #include "opcua_bridge/conversion.h"
+#include "opcua_bridge/event_projection.h"
 #include "opcua_bridge/remote_history_service.h"
 #include "opcua_bridge/server_adapters.h"
 #include "opcua_bridge/service_conversion.h"
@@ -34,9 +35,13 @@ using scada::opcua_bridge::ClientNodeManagementServiceAdapter;
 using scada::opcua_bridge::ClientSessionServiceAdapter;
 using scada::opcua_bridge::ClientViewServiceAdapter;
 
+// event_projection.h
+using scada::opcua_bridge::EventProjection;
+
 // server_adapters.h
 using scada::opcua_bridge::AttributeServiceAdapter;
 using scada::opcua_bridge::AuthenticatorAdapter;
+using scada::opcua_bridge::ChunkedDispatchConfig;
 using scada::opcua_bridge::HistoryServiceAdapter;
 using scada::opcua_bridge::HistoryUpdateServiceAdapter;
 using scada::opcua_bridge::MethodServiceAdapter;
@@ -7,22 +7,29 @@
 
 #include "opcua/events/event_filter.h"
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/experimental/parallel_group.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <algorithm>
 #include <any>
+#include <exception>
 #include <variant>
 
 namespace scada::opcua_bridge {
 namespace {
 
-// Parses the EventFilter select-clause browse paths from a wire monitoring
+// Compiles the EventFilter select-clause browse paths from a wire monitoring
 // filter, falling back to the default BaseEventType fields when none is
 // present.
-std::vector<std::vector<std::string>> ParseWireEventFieldPaths(
+EventProjection CompileWireEventProjection(
     const std::optional<opcua::MonitoringFilter>& filter) {
   const auto* raw_filter =
       filter ? std::get_if<boost::json::value>(&*filter) : nullptr;
   if (!raw_filter)
-    return opcua::NormalizeEventFieldPaths({});
-  return opcua::ParseEventFilterFieldPaths(*raw_filter);
+    return EventProjection::Default();
+  return EventProjection{opcua::ParseEventFilterFieldPaths(*raw_filter)};
 }
 
 }  // namespace
@@ -81,6 +88,75 @@ void SetBatchAttributes(TraceSpan& span,
                     metrics::JoinForAttribute(items, node_id_of));
 }
 
+bool ShouldDispatchChunked(
+    const std::optional<ChunkedDispatchConfig>& dispatch,
+    std::size_t input_count) {
+  return dispatch &&
+         input_count > std::max<std::size_t>(dispatch->chunk_size, 1);
+}
+
+// Serves `inputs` as chunks running concurrently on the dispatch executor.
+// `serve_chunk(inputs, results)` returns the awaitable serving one chunk, which
+// fills that chunk's slice of the results. The first failed chunk in request
+// order fails the whole batch, as a failed unchunked call would.
+template <class Output, class Input, class ServeChunk>
+opcua::Awaitable<opcua::StatusOr<std::vector<Output>>> DispatchChunked(
+    const ChunkedDispatchConfig& dispatch,
+    TraceSpan& span,
+    const std::vector<Input>& inputs,
+    ServeChunk serve_chunk) {
+  const auto chunk_size = std::max<std::size_t>(dispatch.chunk_size, 1);
+  const auto chunk_count = (inputs.size() + chunk_size - 1) / chunk_size;
+  span.SetAttribute("scada.chunk_count", std::to_string(chunk_count));
+
+  std::vector<Output> results(inputs.size());
+
+  using ChunkOperation = decltype(boost::asio::co_spawn(
+      dispatch.executor,
+      serve_chunk(std::span<const Input>{}, std::span<Output>{}),
+      boost::asio::deferred));
+  std::vector<ChunkOperation> operations;
+  operations.reserve(chunk_count);
+  for (std::size_t offset = 0; offset < inputs.size(); offset += chunk_size) {
+    const auto count = std::min(chunk_size, inputs.size() - offset);
+    operations.push_back(boost::asio::co_spawn(
+        dispatch.executor,
+        serve_chunk(std::span{inputs}.subspan(offset, count),
+                    std::span{results}.subspan(offset, count)),
+        boost::asio::deferred));
+  }
+
+  auto [completion_order, exceptions, failures] =
+      co_await boost::asio::experimental::make_parallel_group(
+          std::move(operations))
+          .async_wait(boost::asio::experimental::wait_for_all(),
+                      boost::asio::use_awaitable);
+
+  for (const auto& exception : exceptions) {
+    if (exception)
+      std::rethrow_exception(exception);
+  }
+  for (const auto& failure : failures) {
+    if (failure)
+      co_return *failure;
+  }
+  co_return results;
+}
+
+// Converts one chunk's inner-service result into its slice of the results.
+template <class T, class Output>
+std::optional<opcua::Status> ConvertChunkResults(
+    scada::StatusOr<std::vector<T>>&& result,
+    std::span<Output> results) {
+  if (!result.ok())
+    return ToOpcua(result.status());
+  if (result->size() != results.size())
+    return opcua::Status{opcua::StatusCode::Bad};
+  for (std::size_t i = 0; i < results.size(); ++i)
+    results[i] = ToOpcua(std::move((*result)[i]));
+  return std::nullopt;
+}
+
 }  // namespace
 
 opcua::ServiceCallbacks ServerServiceAdapters::MakeCallbacks() {
@@ -176,8 +252,25 @@ AttributeServiceAdapter::Read(
   SetBatchAttributes(span, *inputs, [](const opcua::ReadValueId& input) {
     return input.node_id.ToString();
   });
+  if (ShouldDispatchChunked(dispatch_, inputs->size())) {
+    co_return co_await DispatchChunked<opcua::DataValue>(
+        *dispatch_, span, *inputs,
+        [this, scada_context = ToScada(context)](
+            std::span<const opcua::ReadValueId> chunk,
+            std::span<opcua::DataValue> results) {
+          return ReadChunk(scada_context, chunk, results);
+        });
+  }
   auto result = co_await inner_.Read(ToScada(context), ToScadaVector(*inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
+}
+
+opcua::Awaitable<std::optional<opcua::Status>>
+AttributeServiceAdapter::ReadChunk(scada::ServiceContext context,
+                                   std::span<const opcua::ReadValueId> inputs,
+                                   std::span<opcua::DataValue> results) {
+  auto result = co_await inner_.Read(std::move(context), ToScadaVector(inputs));
+  co_return ConvertChunkResults(std::move(result), results);
 }
 
 opcua::Awaitable<opcua::StatusOr<std::vector<opcua::StatusCode>>>
@@ -186,7 +279,7 @@ AttributeServiceAdapter::Write(
     std::shared_ptr<const std::vector<opcua::WriteValue>> inputs) {
   auto span = StartServerSpan(tracer_, "opcua.server/Write", context);
   auto result = co_await inner_.Write(ToScada(context), ToScadaVector(*inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 // --- ViewService --------------------------------------------------------
@@ -197,8 +290,26 @@ ViewServiceAdapter::Browse(opcua::ServiceContext context,
   SetBatchAttributes(span, inputs, [](const opcua::BrowseDescription& input) {
     return input.node_id.ToString();
   });
+  if (ShouldDispatchChunked(dispatch_, inputs.size())) {
+    co_return co_await DispatchChunked<opcua::BrowseResult>(
+        *dispatch_, span, inputs,
+        [this, scada_context = ToScada(context)](
+            std::span<const opcua::BrowseDescription> chunk,
+            std::span<opcua::BrowseResult> results) {
+          return BrowseChunk(scada_context, chunk, results);
+        });
+  }
   auto result = co_await inner_.Browse(ToScada(context), ToScadaVector(inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
+}
+
+opcua::Awaitable<std::optional<opcua::Status>> ViewServiceAdapter::BrowseChunk(
+    scada::ServiceContext context,
+    std::span<const opcua::BrowseDescription> inputs,
+    std::span<opcua::BrowseResult> results) {
+  auto result =
+      co_await inner_.Browse(std::move(context), ToScadaVector(inputs));
+  co_return ConvertChunkResults(std::move(result), results);
 }
 
 opcua::Awaitable<opcua::StatusOr<std::vector<opcua::BrowsePathResult>>>
@@ -211,8 +322,24 @@ ViewServiceAdapter::TranslateBrowsePaths(
   SetBatchAttributes(span, inputs, [](const opcua::BrowsePath& input) {
     return input.node_id.ToString();
   });
+  if (ShouldDispatchChunked(dispatch_, inputs.size())) {
+    co_return co_await DispatchChunked<opcua::BrowsePathResult>(
+        *dispatch_, span, inputs,
+        [this](std::span<const opcua::BrowsePath> chunk,
+               std::span<opcua::BrowsePathResult> results) {
+          return TranslateBrowsePathsChunk(chunk, results);
+        });
+  }
   auto result = co_await inner_.TranslateBrowsePaths(ToScadaVector(inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
+}
+
+opcua::Awaitable<std::optional<opcua::Status>>
+ViewServiceAdapter::TranslateBrowsePathsChunk(
+    std::span<const opcua::BrowsePath> inputs,
+    std::span<opcua::BrowsePathResult> results) {
+  auto result = co_await inner_.TranslateBrowsePaths(ToScadaVector(inputs));
+  co_return ConvertChunkResults(std::move(result), results);
 }
 
 // --- MethodService ------------------------------------------------------
@@ -244,7 +371,7 @@ NodeManagementServiceAdapter::AddNodes(
   });
   auto result =
       co_await inner_.AddNodes(ToScada(context), ToScadaVector(inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 opcua::Awaitable<opcua::StatusOr<std::vector<opcua::StatusCode>>>
@@ -257,7 +384,7 @@ NodeManagementServiceAdapter::DeleteNodes(
   });
   auto result =
       co_await inner_.DeleteNodes(ToScada(context), ToScadaVector(inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 opcua::Awaitable<opcua::StatusOr<std::vector<opcua::StatusCode>>>
@@ -270,7 +397,7 @@ NodeManagementServiceAdapter::AddReferences(
   });
   auto result =
       co_await inner_.AddReferences(ToScada(context), ToScadaVector(inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 opcua::Awaitable<opcua::StatusOr<std::vector<opcua::StatusCode>>>
@@ -285,7 +412,7 @@ NodeManagementServiceAdapter::DeleteReferences(
                      });
   auto result =
       co_await inner_.DeleteReferences(ToScada(context), ToScadaVector(inputs));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 // --- HistoryService -----------------------------------------------------
@@ -299,7 +426,7 @@ HistoryServiceAdapter::HistoryReadRaw(opcua::HistoryReadRawDetails details) {
                                 TraceSpanKind::kServer, {});
   span.SetAttribute("scada.node_id", details.node_id.ToString());
   auto result = co_await inner_.HistoryReadRaw(ToScada(details));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 opcua::Awaitable<opcua::HistoryReadEventsResult>
@@ -312,7 +439,7 @@ HistoryServiceAdapter::HistoryReadEvents(opcua::NodeId node_id,
   span.SetAttribute("scada.node_id", node_id.ToString());
   auto result = co_await inner_.HistoryReadEvents(
       ToScada(node_id), ToScada(from), ToScada(to), ToScada(filter));
-  co_return ToOpcua(result);
+  co_return ToOpcua(std::move(result));
 }
 
 // --- HistoryUpdateService ----------------------------------------------
@@ -355,11 +482,12 @@ HistoryUpdateServiceAdapter::HistoryUpdateEvent(
 opcua::Awaitable<std::vector<opcua::MonitoredItemCreateResult>>
 MonitoredItemSubscriptionAdapter::AddItems(
     std::vector<opcua::MonitoredItemCreateRequest> requests) {
-  // Remember the EventFilter select-clause paths per client_handle so ReadNext
-  // can project core events onto them into a standard wire EventFieldList.
+  // Compile the EventFilter select clauses per client_handle so ReadNext can
+  // project core events onto them into a standard wire EventFieldList.
   for (const auto& request : requests) {
-    field_paths_by_handle_[request.requested_parameters.client_handle] =
-        ParseWireEventFieldPaths(request.requested_parameters.filter);
+    projections_by_handle_.insert_or_assign(
+        request.requested_parameters.client_handle,
+        CompileWireEventProjection(request.requested_parameters.filter));
     if (!event_item_handle_.has_value() &&
         request.item_to_monitor.attribute_id ==
             opcua::AttributeId::EventNotifier) {
@@ -367,33 +495,26 @@ MonitoredItemSubscriptionAdapter::AddItems(
     }
   }
   auto results = co_await inner_->AddItems(ToScadaVector(requests));
-  co_return ToOpcuaVector(results);
+  co_return ToOpcuaVector(std::move(results));
 }
 
 opcua::ItemNotification MonitoredItemSubscriptionAdapter::ToItemNotification(
-    const scada::MonitoredItemNotification& notification) const {
+    scada::MonitoredItemNotification&& notification) const {
   return std::visit(
-      [this](const auto& x) -> opcua::ItemNotification {
+      [this](auto& x) -> opcua::ItemNotification {
         using T = std::decay_t<decltype(x)>;
         if constexpr (std::is_same_v<T, scada::DataChangeNotification>) {
           return opcua::MonitoredItemNotification{
-              .client_handle = x.client_handle, .value = ToOpcua(x.value)};
+              .client_handle = x.client_handle,
+              .value = ToOpcua(std::move(x.value))};
         } else if constexpr (std::is_same_v<T, scada::EventNotification>) {
           // Project the core event onto this item's EventFilter select clauses,
           // producing a standard wire EventFieldList. The core event payload is
-          // a std::any carrying a scada::Event; convert it to opcua::Event,
-          // then project by field path.
-          std::vector<std::vector<std::string>> field_paths;
-          if (const auto it = field_paths_by_handle_.find(x.client_handle);
-              it != field_paths_by_handle_.end()) {
-            field_paths = it->second;
-          } else {
-            field_paths = opcua::NormalizeEventFieldPaths({});
-          }
+          // a std::any carrying a scada::Event.
+          const auto& projection = GetEventProjection(x.client_handle);
           std::vector<opcua::Variant> event_fields;
           if (const auto* scada_event = std::any_cast<scada::Event>(&x.event)) {
-            event_fields = opcua::ProjectEventFields(
-                field_paths, std::any{ToOpcua(*scada_event)});
+            event_fields = projection.Project(*scada_event);
           } else if (x.event.has_value()) {
             // Non-system SCADA events (GeneralModelChangeEventType,
             // SemanticChangeEventType) have no OPC UA select-clause projection;
@@ -406,7 +527,7 @@ opcua::ItemNotification MonitoredItemSubscriptionAdapter::ToItemNotification(
             // https://reference.opcfoundation.org/Core/Part3/v105/docs/9.32 .
             event_fields = ToOpcuaVector(scada::DisassembleEvent(x.event));
           } else {
-            event_fields = opcua::ProjectEventFields(field_paths, std::any{});
+            event_fields = projection.Project(std::any{});
           }
           return opcua::EventFieldList{.client_handle = x.client_handle,
                                        .event_fields = std::move(event_fields)};
@@ -438,18 +559,11 @@ opcua::ItemNotification MonitoredItemSubscriptionAdapter::ToItemNotification(
             overflow_event.message =
                 u"Event queue overflowed; event notifications were lost";
 
-            std::vector<std::vector<std::string>> field_paths;
-            if (const auto it =
-                    field_paths_by_handle_.find(*event_item_handle_);
-                it != field_paths_by_handle_.end()) {
-              field_paths = it->second;
-            } else {
-              field_paths = opcua::NormalizeEventFieldPaths({});
-            }
+            const auto& projection = GetEventProjection(*event_item_handle_);
             return opcua::EventFieldList{
                 .client_handle = *event_item_handle_,
-                .event_fields = opcua::ProjectEventFields(
-                    field_paths, std::any{std::move(overflow_event)})};
+                .event_fields =
+                    projection.Project(std::any{std::move(overflow_event)})};
           }
           // Overflow has no client_handle; surface as a status-only data-change
           // notification with handle 0 so the dropped-notifications signal
@@ -471,12 +585,19 @@ opcua::ItemNotification MonitoredItemSubscriptionAdapter::ToItemNotification(
       notification);
 }
 
+const EventProjection& MonitoredItemSubscriptionAdapter::GetEventProjection(
+    std::uint32_t client_handle) const {
+  const auto i = projections_by_handle_.find(client_handle);
+  return i != projections_by_handle_.end() ? i->second
+                                           : EventProjection::Default();
+}
+
 opcua::Awaitable<std::vector<opcua::Status>>
 MonitoredItemSubscriptionAdapter::RemoveItems(
     std::span<const opcua::MonitoredItemId> item_ids) {
   // MonitoredItemId is std::uint32_t on both sides.
   auto results = co_await inner_->RemoveItems(item_ids);
-  co_return ToOpcuaVector(results);
+  co_return ToOpcuaVector(std::move(results));
 }
 
 opcua::Awaitable<opcua::StatusOr<std::vector<opcua::ItemNotification>>>
@@ -486,8 +607,8 @@ MonitoredItemSubscriptionAdapter::ReadNext(std::size_t max_count) {
     co_return ToOpcua(result.status());
   std::vector<opcua::ItemNotification> notifications;
   notifications.reserve(result->size());
-  for (const auto& notification : *result)
-    notifications.push_back(ToItemNotification(notification));
+  for (auto& notification : *result)
+    notifications.push_back(ToItemNotification(std::move(notification)));
   co_return notifications;
 }
 
@@ -6,8 +6,10 @@
 // is the same boost::asio::awaitable on both sides, so a core coroutine can be
 // co_awaited directly inside an opcua one.
 
+#include "base/any_executor.h"
 #include "base/lifetime.h"
 #include "metrics/tracer.h"
+#include "opcua_bridge/event_projection.h"
 #include "opcua_bridge/service_conversion.h"
 
 #include "scada/attribute_service.h"
@@ -29,6 +31,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <span>
 #include <string>
 #include <unordered_map>
@@ -36,12 +39,24 @@
 
 namespace scada::opcua_bridge {
 
+// Serves large Read, Browse and TranslateBrowsePaths batches as chunks running
+// concurrently on `executor`, typically a thread pool: each chunk is converted,
+// passed to the inner service and converted back on its own, and the results
+// are reassembled in request order. The inner service must therefore accept
+// concurrent calls from the executor's threads.
+struct ChunkedDispatchConfig {
+  AnyExecutor executor;
+  // Batches up to this size are served whole, on the calling executor.
+  std::size_t chunk_size = 1024;
+};
+
 class AttributeServiceAdapter {
  public:
-  explicit AttributeServiceAdapter(scada::AttributeService& inner
-                                       SCADA_LIFETIME_BOUND,
-                                   Tracer& tracer = Tracer::None())
-      : inner_{inner}, tracer_{tracer} {}
+  explicit AttributeServiceAdapter(
+      scada::AttributeService& inner SCADA_LIFETIME_BOUND,
+      Tracer& tracer = Tracer::None(),
+      std::optional<ChunkedDispatchConfig> dispatch = std::nullopt)
+      : inner_{inner}, tracer_{tracer}, dispatch_{std::move(dispatch)} {}
 
   opcua::Awaitable<opcua::StatusOr<std::vector<opcua::DataValue>>> Read(
       opcua::ServiceContext context,
@@ -52,15 +67,24 @@ class AttributeServiceAdapter {
       std::shared_ptr<const std::vector<opcua::WriteValue>> inputs);
 
  private:
+  // One chunk of a dispatched Read; returns its failure, if any.
+  opcua::Awaitable<std::optional<opcua::Status>> ReadChunk(
+      scada::ServiceContext context,
+      std::span<const opcua::ReadValueId> inputs,
+      std::span<opcua::DataValue> results);
+
   scada::AttributeService& inner_;
   Tracer& tracer_;
+  const std::optional<ChunkedDispatchConfig> dispatch_;
 };
 
 class ViewServiceAdapter {
  public:
-  explicit ViewServiceAdapter(scada::ViewService& inner SCADA_LIFETIME_BOUND,
-                              Tracer& tracer = Tracer::None())
-      : inner_{inner}, tracer_{tracer} {}
+  explicit ViewServiceAdapter(
+      scada::ViewService& inner SCADA_LIFETIME_BOUND,
+      Tracer& tracer = Tracer::None(),
+      std::optional<ChunkedDispatchConfig> dispatch = std::nullopt)
+      : inner_{inner}, tracer_{tracer}, dispatch_{std::move(dispatch)} {}
 
   opcua::Awaitable<opcua::StatusOr<std::vector<opcua::BrowseResult>>> Browse(
       opcua::ServiceContext context,
@@ -70,8 +94,19 @@ class ViewServiceAdapter {
   TranslateBrowsePaths(std::vector<opcua::BrowsePath> inputs);
 
  private:
+  // Chunks of a dispatched Browse/TranslateBrowsePaths; return their failure,
+  // if any.
+  opcua::Awaitable<std::optional<opcua::Status>> BrowseChunk(
+      scada::ServiceContext context,
+      std::span<const opcua::BrowseDescription> inputs,
+      std::span<opcua::BrowseResult> results);
+  opcua::Awaitable<std::optional<opcua::Status>> TranslateBrowsePathsChunk(
+      std::span<const opcua::BrowsePath> inputs,
+      std::span<opcua::BrowsePathResult> results);
+
   scada::ViewService& inner_;
   Tracer& tracer_;
+  const std::optional<ChunkedDispatchConfig> dispatch_;
 };
 
 class MethodServiceAdapter {
@@ -166,7 +201,7 @@ class HistoryUpdateServiceAdapter {
 // Wraps an inner core MonitoredItemSubscription as the opcua interface. Event
 // notifications cross the boundary as the standard wire `EventFieldList`; this
 // adapter projects each core event onto the monitored item's EventFilter select
-// clauses, so it stores the parsed field paths per client_handle as items are
+// clauses, so it compiles an EventProjection per client_handle as items are
 // added.
 class MonitoredItemSubscriptionAdapter
     : public opcua::MonitoredItemSubscription {
@@ -188,17 +223,19 @@ class MonitoredItemSubscriptionAdapter
 
  private:
   // Converts a single core notification to its standard wire form, projecting
-  // core events onto the per-item EventFilter select clauses stored in
-  // `field_paths_by_handle_`.
+  // core events onto the per-item EventFilter select clauses compiled in
+  // `projections_by_handle_`.
   opcua::ItemNotification ToItemNotification(
-      const scada::MonitoredItemNotification& notification) const;
+      scada::MonitoredItemNotification&& notification) const;
+
+  // The item's projection, or the default one for unknown handles.
+  const EventProjection& GetEventProjection(std::uint32_t client_handle) const;
 
   std::unique_ptr<scada::MonitoredItemSubscription> inner_;
-  // Event-field select-clause paths parsed from each item's wire filter, keyed
-  // by client_handle. Populated in AddItems; consumed in ReadNext to project
-  // events into EventFieldList.
-  std::unordered_map<std::uint32_t, std::vector<std::vector<std::string>>>
-      field_paths_by_handle_;
+  // Projections compiled from each item's wire filter, keyed by client_handle.
+  // Populated in AddItems; consumed in ReadNext to project events into
+  // EventFieldList.
+  std::unordered_map<std::uint32_t, EventProjection> projections_by_handle_;
   // The first event item's (EventNotifier attribute) client handle. When set,
   // a queue overflow surfaces as an EventQueueOverflowEventType notification
   // on this handle (OPC UA Part 4 §7.22); data-only subscriptions keep the
@@ -245,6 +282,10 @@ struct ServerServiceAdapters {
   // `tracer` (typically the core module's) makes every context-carrying
   // service call emit a SERVER span, continuing the caller's trace from the
   // request header traceparent that opcuapp placed in the ServiceContext.
+  // `attribute_dispatch` and `view_dispatch` serve large Read and
+  // Browse/TranslateBrowsePaths batches in parallel chunks. Leave
+  // `attribute_dispatch` off unless `attribute` takes concurrent Reads;
+  // AddressSpaceImpl does not.
   ServerServiceAdapters(
       scada::AttributeService& attribute SCADA_LIFETIME_BOUND,
       scada::ViewService& view SCADA_LIFETIME_BOUND,
@@ -253,9 +294,11 @@ struct ServerServiceAdapters {
       scada::HistoryService& history SCADA_LIFETIME_BOUND,
       scada::HistoryUpdateService& history_update SCADA_LIFETIME_BOUND,
       scada::MonitoredItemService& monitored_item SCADA_LIFETIME_BOUND,
-      Tracer& tracer = Tracer::None())
-      : attribute{attribute, tracer},
-        view{view, tracer},
+      Tracer& tracer = Tracer::None(),
+      std::optional<ChunkedDispatchConfig> attribute_dispatch = std::nullopt,
+      std::optional<ChunkedDispatchConfig> view_dispatch = std::nullopt)
+      : attribute{attribute, tracer, std::move(attribute_dispatch)},
+        view{view, tracer, std::move(view_dispatch)},
         method{method, tracer},
         node_management{node_management, tracer},
         history{history, tracer},
@@ -6,9 +6,12 @@
 
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
+#include <boost/asio/executor_work_guard.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
 
 #include <any>
+#include <atomic>
 #include <optional>
 #include <variant>
 
@@ -74,6 +77,102 @@ TEST(ServerAdapterTest, ViewServiceBrowseDelegatesAndConverts) {
   EXPECT_EQ(browse_result.references[0].node_id, opcua::NodeId{2253u});
 }
 
+// A core ViewService answering each description with a reference to the
+// browsed node itself, so the order of reassembled chunk results shows.
+class EchoViewService : public scada::ViewService {
+ public:
+  Awaitable<scada::StatusOr<std::vector<scada::BrowseResult>>> Browse(
+      scada::ServiceContext,
+      std::vector<scada::BrowseDescription> inputs) override {
+    ++browse_count;
+    std::vector<scada::BrowseResult> results;
+    for (const auto& input : inputs) {
+      if (input.node_id == failing_node_id)
+        co_return scada::Status{scada::StatusCode::Bad_WrongNodeId};
+      scada::BrowseResult result;
+      result.status_code = scada::StatusCode::Good;
+      result.references.push_back(
+          scada::ReferenceDescription{.node_id = input.node_id});
+      results.push_back(std::move(result));
+    }
+    co_return results;
+  }
+  Awaitable<scada::StatusOr<std::vector<scada::BrowsePathResult>>>
+  TranslateBrowsePaths(std::vector<scada::BrowsePath>) override {
+    co_return std::vector<scada::BrowsePathResult>{};
+  }
+
+  std::atomic<int> browse_count = 0;
+  scada::NodeId failing_node_id;
+};
+
+// Browses nodes 1..`count` through `adapter` and runs `io` until it completes.
+opcua::StatusOr<std::vector<opcua::BrowseResult>> BrowseNodes(
+    ViewServiceAdapter& adapter,
+    unsigned count) {
+  std::vector<opcua::BrowseDescription> inputs;
+  for (unsigned i = 1; i <= count; ++i)
+    inputs.push_back(opcua::BrowseDescription{.node_id = opcua::NodeId{i}});
+
+  boost::asio::io_context io;
+  // Keeps `io` running while the chunks are served on the pool.
+  auto work = boost::asio::make_work_guard(io);
+  std::optional<opcua::StatusOr<std::vector<opcua::BrowseResult>>> result;
+  boost::asio::co_spawn(
+      io,
+      [&]() -> opcua::Awaitable<void> {
+        result = co_await adapter.Browse(opcua::ServiceContext{}, inputs);
+        work.reset();
+      },
+      boost::asio::detached);
+  io.run();
+  return std::move(*result);
+}
+
+TEST(ServerAdapterTest, ChunkedBrowseReassemblesResultsInOrder) {
+  EchoViewService fake;
+  boost::asio::thread_pool pool{2};
+  ViewServiceAdapter adapter{
+      fake, Tracer::None(),
+      ChunkedDispatchConfig{.executor = pool.get_executor(), .chunk_size = 2}};
+
+  const auto result = BrowseNodes(adapter, 5);
+
+  // Three chunks: {1, 2}, {3, 4}, {5}.
+  EXPECT_EQ(fake.browse_count, 3);
+  ASSERT_TRUE(result.ok());
+  ASSERT_EQ(result->size(), 5u);
+  for (unsigned i = 0; i < 5; ++i) {
+    ASSERT_EQ((*result)[i].references.size(), 1u);
+    EXPECT_EQ((*result)[i].references[0].node_id, opcua::NodeId{i + 1});
+  }
+}
+
+TEST(ServerAdapterTest, ChunkedBrowseFailsWithFailedChunk) {
+  EchoViewService fake;
+  fake.failing_node_id = scada::NodeId{4u};
+  boost::asio::thread_pool pool{2};
+  ViewServiceAdapter adapter{
+      fake, Tracer::None(),
+      ChunkedDispatchConfig{.executor = pool.get_executor(), .chunk_size = 2}};
+
+  EXPECT_FALSE(BrowseNodes(adapter, 5).ok());
+}
+
+TEST(ServerAdapterTest, SmallBatchIsNotChunked) {
+  EchoViewService fake;
+  boost::asio::thread_pool pool{2};
+  ViewServiceAdapter adapter{
+      fake, Tracer::None(),
+      ChunkedDispatchConfig{.executor = pool.get_executor(), .chunk_size = 8}};
+
+  const auto result = BrowseNodes(adapter, 5);
+
+  EXPECT_EQ(fake.browse_count, 1);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->size(), 5u);
+}
+
 // A core MonitoredItemSubscription whose ReadNext returns a single, fixed
 // notification supplied by the test, so the adapter's core->wire conversion can
 // be observed.
@@ -8,6 +8,7 @@
 #include "opcua/events/event_util.h"
 
 #include <any>
+#include <utility>
 #include <variant>
 
 namespace scada::opcua_bridge {
@@ -98,6 +99,36 @@ scada::BrowseResult ToScada(const opcua::BrowseResult& v) {
           .references = ToScadaVector(v.references)};
 }
 
+opcua::ReferenceDescription ToOpcua(scada::ReferenceDescription&& v) {
+  return {.reference_type_id = ToOpcua(v.reference_type_id),
+          .forward = v.forward,
+          .node_id = ToOpcua(v.node_id),
+          .node_class = ToOpcua(v.node_class),
+          .browse_name = ToOpcua(v.browse_name),
+          .display_name = ToOpcua(std::move(v.display_name)),
+          .type_definition = ToOpcua(v.type_definition)};
+}
+scada::ReferenceDescription ToScada(opcua::ReferenceDescription&& v) {
+  return {.reference_type_id = ToScada(v.reference_type_id),
+          .forward = v.forward,
+          .node_id = ToScada(v.node_id),
+          .node_class = ToScada(v.node_class),
+          .browse_name = ToScada(v.browse_name),
+          .display_name = ToScada(std::move(v.display_name)),
+          .type_definition = ToScada(v.type_definition)};
+}
+
+opcua::BrowseResult ToOpcua(scada::BrowseResult&& v) {
+  return {.status_code = ToOpcua(v.status_code),
+          .continuation_point = std::move(v.continuation_point),
+          .references = ToOpcuaVector(std::move(v.references))};
+}
+scada::BrowseResult ToScada(opcua::BrowseResult&& v) {
+  return {.status_code = ToScada(v.status_code),
+          .continuation_point = std::move(v.continuation_point),
+          .references = ToScadaVector(std::move(v.references))};
+}
+
 opcua::RelativePathElement ToOpcua(const scada::RelativePathElement& v) {
   return {.reference_type_id = ToOpcua(v.reference_type_id),
           .inverse = v.inverse,
@@ -457,6 +488,16 @@ scada::HistoryReadRawResult ToScada(const opcua::HistoryReadRawResult& v) {
           .values = ToScadaVector(v.values),
           .continuation_point = v.continuation_point};
 }
+opcua::HistoryReadRawResult ToOpcua(scada::HistoryReadRawResult&& v) {
+  return {.status = ToOpcua(v.status),
+          .values = ToOpcuaVector(std::move(v.values)),
+          .continuation_point = std::move(v.continuation_point)};
+}
+scada::HistoryReadRawResult ToScada(opcua::HistoryReadRawResult&& v) {
+  return {.status = ToScada(v.status),
+          .values = ToScadaVector(std::move(v.values)),
+          .continuation_point = std::move(v.continuation_point)};
+}
 
 opcua::HistoryReadEventsResult ToOpcua(
     const scada::HistoryReadEventsResult& v) {
@@ -579,6 +620,24 @@ scada::MonitoredItemNotification ToScada(const opcua::ItemNotification& n) {
       n);
 }
 
+scada::MonitoredItemNotification ToScada(opcua::ItemNotification&& n) {
+  // Data changes are the bulk of a Publish; their values move across. Events
+  // are reassembled from their fields either way.
+  return std::visit(
+      [&n](auto& x) -> scada::MonitoredItemNotification {
+        using T = std::decay_t<decltype(x)>;
+        if constexpr (std::is_same_v<T, opcua::MonitoredItemNotification>) {
+          return scada::DataChangeNotification{
+              .item_id = 0,
+              .client_handle = x.client_handle,
+              .value = ToScada(std::move(x.value))};
+        } else {
+          return ToScada(std::as_const(n));
+        }
+      },
+      n);
+}
+
 opcua::SessionSecuritySettings ToOpcua(
     const scada::SessionSecuritySettings& v) {
   return {.mode = static_cast<opcua::SessionSecuritySettings::Mode>(v.mode),
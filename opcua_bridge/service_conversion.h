@@ -119,11 +119,17 @@ scada::WriteValue ToScada(const opcua::WriteValue&);
 opcua::BrowseDescription ToOpcua(const scada::BrowseDescription&);
 scada::BrowseDescription ToScada(const opcua::BrowseDescription&);
 
+// The rvalue overloads of result types move their payloads (names, texts,
+// values) across instead of copying them.
 opcua::ReferenceDescription ToOpcua(const scada::ReferenceDescription&);
 scada::ReferenceDescription ToScada(const opcua::ReferenceDescription&);
+opcua::ReferenceDescription ToOpcua(scada::ReferenceDescription&&);
+scada::ReferenceDescription ToScada(opcua::ReferenceDescription&&);
 
 opcua::BrowseResult ToOpcua(const scada::BrowseResult&);
 scada::BrowseResult ToScada(const opcua::BrowseResult&);
+opcua::BrowseResult ToOpcua(scada::BrowseResult&&);
+scada::BrowseResult ToScada(opcua::BrowseResult&&);
 
 opcua::RelativePathElement ToOpcua(const scada::RelativePathElement&);
 scada::RelativePathElement ToScada(const opcua::RelativePathElement&);
@@ -192,6 +198,7 @@ scada::MonitoredItemCreateResult ToScada(
 // EventNotification whose std::any payload is reassembled from the event
 // fields. Consumers correlate by client_handle.
 scada::MonitoredItemNotification ToScada(const opcua::ItemNotification&);
+scada::MonitoredItemNotification ToScada(opcua::ItemNotification&&);
 
 opcua::HistoryReadRawDetails ToOpcua(const scada::HistoryReadRawDetails&);
 scada::HistoryReadRawDetails ToScada(const opcua::HistoryReadRawDetails&);
@@ -201,6 +208,8 @@ scada::HistoryReadEventsDetails ToScada(const opcua::HistoryReadEventsDetails&);
 
 opcua::HistoryReadRawResult ToOpcua(const scada::HistoryReadRawResult&);
 scada::HistoryReadRawResult ToScada(const opcua::HistoryReadRawResult&);
+opcua::HistoryReadRawResult ToOpcua(scada::HistoryReadRawResult&&);
+scada::HistoryReadRawResult ToScada(opcua::HistoryReadRawResult&&);
 
 opcua::HistoryReadEventsResult ToOpcua(const scada::HistoryReadEventsResult&);
 scada::HistoryReadEventsResult ToScada(const opcua::HistoryReadEventsResult&);
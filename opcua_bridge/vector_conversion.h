@@ -8,7 +8,9 @@
 #include "opcua/types/status_or.h"
 #include "scada/status_or.h"
 
+#include <span>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace scada::opcua_bridge {
@@ -23,7 +25,7 @@ auto ToOpcuaVector(const std::vector<T>& in) {
 }
 
 template <class T>
-auto ToScadaVector(const std::vector<T>& in) {
+auto ToScadaVector(std::span<const T> in) {
   std::vector<std::decay_t<decltype(ToScada(in.front()))>> out;
   out.reserve(in.size());
   for (const auto& x : in)
@@ -31,6 +33,31 @@ auto ToScadaVector(const std::vector<T>& in) {
   return out;
 }
 
+template <class T>
+auto ToScadaVector(const std::vector<T>& in) {
+  return ToScadaVector(std::span<const T>{in});
+}
+
+// Vectors the caller gave up: elements go through their rvalue converters
+// where one exists, so element payloads are moved rather than copied.
+template <class T>
+auto ToOpcuaVector(std::vector<T>&& in) {
+  std::vector<std::decay_t<decltype(ToOpcua(std::move(in.front())))>> out;
+  out.reserve(in.size());
+  for (auto& x : in)
+    out.push_back(ToOpcua(std::move(x)));
+  return out;
+}
+
+template <class T>
+auto ToScadaVector(std::vector<T>&& in) {
+  std::vector<std::decay_t<decltype(ToScada(std::move(in.front())))>> out;
+  out.reserve(in.size());
+  for (auto& x : in)
+    out.push_back(ToScada(std::move(x)));
+  return out;
+}
+
 // StatusOr<vector<T>> — propagate the status on failure, convert the vector on
 // success. (Covers every StatusOr the service interfaces return.)
 template <class T>
@@ -47,5 +74,19 @@ auto ToScada(const opcua::StatusOr<std::vector<T>>& s) -> scada::StatusOr<
     return ToScada(s.status());
   return ToScadaVector(*s);
 }
+template <class T>
+auto ToOpcua(scada::StatusOr<std::vector<T>>&& s) -> opcua::StatusOr<
+    std::vector<std::decay_t<decltype(ToOpcua(std::declval<T>()))>>> {
+  if (!s.ok())
+    return ToOpcua(s.status());
+  return ToOpcuaVector(std::move(*s));
+}
+template <class T>
+auto ToScada(opcua::StatusOr<std::vector<T>>&& s) -> scada::StatusOr<
+    std::vector<std::decay_t<decltype(ToScada(std::declval<T>()))>>> {
+  if (!s.ok())
+    return ToScada(s.status());
+  return ToScadaVector(std::move(*s));
+}
 
 }  // namespace scada::opcua_bridge
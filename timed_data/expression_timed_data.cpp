@@ -8,10 +8,45 @@
 #include "timed_data/timed_data_spec.h"
 #include "timed_data/timed_data_util.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// How far SeekOperand() walks forward from a cursor before it gives up and
+// binary-searches. Covers a few samples appended since the last calculation.
+const size_t kMaxCursorSteps = 4;
+
+// Returns the start of the ready range that covers the end of `range`,
+// clamped to `range.first`. Unlike GetReadyFrom(), finds a ready range open
+// to kTimedDataCurrentOnly, since operands are observed up to the current
+// time. Returns kTimedDataCurrentOnly if the end of `range` is not ready.
+scada::DateTime GetOperandReadyFrom(
+    std::span<const scada::DateTimeRange> ready_ranges,
+    const scada::DateTimeRange& range) {
+  auto i = std::lower_bound(
+      ready_ranges.begin(), ready_ranges.end(), range.second,
+      [](const scada::DateTimeRange& range, scada::DateTime time) {
+        return range.second < time;
+      });
+  if (i == ready_ranges.end() || i->first > range.second)
+    return kTimedDataCurrentOnly;
+
+  if (i->second <= range.first)
+    return kTimedDataCurrentOnly;
+
+  return std::max(range.first, i->first);
+}
+
+}  // namespace
+
 ExpressionTimedData::ExpressionTimedData(
     std::unique_ptr<ScadaExpression> expression,
     std::vector<std::shared_ptr<TimedData>> operands)
-    : expression_{std::move(expression)}, operands_{std::move(operands)} {
+    : expression_{std::move(expression)},
+      operands_{std::move(operands)},
+      operand_cursors_(operands_.size()) {
   for (const auto& operand : operands_) {
     operand->AddObserver(*this);
     operand->AddViewObserver(*this, {from_, kTimedDataCurrentOnly});
@@ -37,6 +72,11 @@ scada::LocalizedText ExpressionTimedData::GetTitle() const {
 void ExpressionTimedData::OnObservedRangesChanged() {
   size_t num_operands = operands_.size();
 
+  // Operands are observed from the earliest time observed here.
+  const auto& observed_ranges = buffer_.observed_ranges();
+  if (!observed_ranges.empty())
+    from_ = std::min(from_, observed_ranges.front().first);
+
   // connect operands
   for (size_t i = 0; i < num_operands; ++i) {
     operands_[i]->AddObserver(*this);
@@ -62,7 +102,7 @@ scada::base::Time ExpressionTimedData::GetOperandsReadyFrom() const {
   for (size_t i = 0; i < operands_.size(); ++i) {
     const auto& operand = *operands_[i];
     scada::base::Time operand_ready_from =
-        GetReadyFrom(operand.GetReadyRanges(), range);
+        GetOperandReadyFrom(operand.GetReadyRanges(), range);
 
     if (operand_ready_from == kTimedDataCurrentOnly)
       return kTimedDataCurrentOnly;
@@ -90,69 +130,73 @@ void ExpressionTimedData::CalculateValuesInRange(
     const auto& operand = *operands_[i];
     const auto& values = operand.GetValues();
 
-    size_t& iterator = iters[i];
-    iterator = LowerBound(values, range.first);
-
-    auto& initial_value = expression_->items[i].value;
-    if (iterator != values.size()) {
-      initial_value = values[iterator];
-    } else {
-      scada::base::Check(values.back().source_timestamp <= range.first);
-      initial_value = values.back();
-    }
+    iters[i] = SeekOperand(i, values, range.first);
+
+    // The operand value in effect when the range starts.
+    expression_->items[i].value =
+        iters[i] != 0 ? values[iters[i] - 1] : scada::DataValue{};
   }
 
-  // Run calculation.
-  for (;;) {
-    // Setup operand values and find next calculation time.
-    scada::base::Time update_time;
-    scada::Qualifier total_qualifier;
-    bool calculation_finished = true;
+  if (!expression_->is_compiled() || !CalculateColumnsInRange(range, iters))
+    CalculateRowsInRange(range, iters);
 
-    for (size_t i = 0; i < operands_.size(); ++i) {
-      const auto& operand = *operands_[i];
-      const auto& values = operand.GetValues();
+  operand_cursors_ = std::move(iters);
+}
 
-      ScadaExpression::Item& item = expression_->items[i];
+bool ExpressionTimedData::NextRow(const scada::DateTimeRange& range,
+                                  std::span<size_t> iters,
+                                  scada::DateTime& update_time,
+                                  scada::Qualifier& total_qualifier) {
+  // The row is at the earliest operand value not calculated yet.
+  update_time = {};
+  for (size_t i = 0; i < operands_.size(); ++i) {
+    const auto& values = operands_[i]->GetValues();
+    if (iters[i] == values.size())
+      continue;
 
-      if (update_time.is_null() || update_time < item.value.source_timestamp)
-        update_time = item.value.source_timestamp;
+    const scada::DateTime& time = values[iters[i]].source_timestamp;
 
-      // Check iterator reached end.
-      size_t& iterator = iters[i];
-      if (iterator == values.size()) {
-        continue;
-      }
-      const scada::base::Time& time = values[iterator].source_timestamp;
-
-      // Warning: condition "time >= to" is incorrect here.
-      if (!range.second.is_null() && time > range.second) {
-        continue;
-      }
+    if (!range.second.is_null() && time > range.second)
+      continue;
 
-      calculation_finished = false;
+    if (update_time.is_null() || time < update_time)
+      update_time = time;
+  }
 
-      // Setup operand value.
-      item.value = values[iterator];
+  if (update_time.is_null())
+    return false;
 
-      // Update total qualifier.
-      if (item.value.qualifier.bad())
-        total_qualifier.set_bad(true);
+  // Advance the operands that change at `update_time`; the others keep their
+  // previous value.
+  total_qualifier = {};
+  for (size_t i = 0; i < operands_.size(); ++i) {
+    const auto& values = operands_[i]->GetValues();
+    ScadaExpression::Item& item = expression_->items[i];
 
+    size_t& iterator = iters[i];
+    if (iterator != values.size() &&
+        values[iterator].source_timestamp == update_time) {
+      item.value = values[iterator];
       ++iterator;
     }
 
-    // Stop if all iterator are at the end.
-    if (calculation_finished)
-      break;
+    if (item.value.qualifier.bad())
+      total_qualifier.set_bad(true);
+  }
 
-    scada::base::Check(!update_time.is_null());
+  return true;
+}
 
-    // calculate
+void ExpressionTimedData::CalculateRowsInRange(
+    const scada::DateTimeRange& range,
+    std::span<size_t> iters) {
+  scada::DateTime update_time;
+  scada::Qualifier total_qualifier;
+  while (NextRow(range, iters, update_time, total_qualifier)) {
     auto total_value = expression_->Calculate();
     if (!total_value.is_null()) {
       scada::DataValue tvq(std::move(total_value), total_qualifier, update_time,
-                           scada::base::Time());
+                           scada::DateTime());
 
       // The insert may be rejected in favor of an existing value with the
       // same timestamp; that is data-dependent, not an invariant.
@@ -161,6 +205,73 @@ void ExpressionTimedData::CalculateValuesInRange(
   }
 }
 
+bool ExpressionTimedData::CalculateColumnsInRange(
+    const scada::DateTimeRange& range,
+    std::vector<size_t>& iters) {
+  const auto start_iters = iters;
+  std::vector<scada::DataValue> start_values(operands_.size());
+  for (size_t i = 0; i < operands_.size(); ++i)
+    start_values[i] = expression_->items[i].value;
+
+  for (auto& column : operand_columns_)
+    column.clear();
+  operand_columns_.resize(operands_.size());
+  row_times_.clear();
+  row_qualifiers_.clear();
+
+  scada::DateTime update_time;
+  scada::Qualifier total_qualifier;
+  while (NextRow(range, iters, update_time, total_qualifier)) {
+    for (size_t i = 0; i < operands_.size(); ++i) {
+      const auto& value = expression_->items[i].value.value;
+      if (value.is_null()) {
+        operand_columns_[i].emplace_back(
+            std::numeric_limits<double>::quiet_NaN());
+      } else if (value.type() == scada::Variant::DOUBLE) {
+        operand_columns_[i].emplace_back(value.as_double());
+      } else {
+        // Leave other types to the token tree, from the first row.
+        iters = start_iters;
+        for (size_t j = 0; j < operands_.size(); ++j)
+          expression_->items[j].value = std::move(start_values[j]);
+        return false;
+      }
+    }
+    row_times_.emplace_back(update_time);
+    row_qualifiers_.emplace_back(total_qualifier);
+  }
+
+  std::vector<std::span<const double>> operands(operand_columns_.begin(),
+                                                operand_columns_.end());
+  row_results_.resize(row_times_.size());
+  expression_->CalculateColumn(operands, row_results_);
+
+  for (size_t row = 0; row < row_results_.size(); ++row) {
+    // NaN stands for a row without a value, like a null Calculate() result.
+    if (std::isnan(row_results_[row]))
+      continue;
+    buffer_.InsertOrUpdate(scada::DataValue{row_results_[row],
+                                            row_qualifiers_[row],
+                                            row_times_[row], {}});
+  }
+  return true;
+}
+
+size_t ExpressionTimedData::SeekOperand(size_t index,
+                                        std::span<const scada::DataValue> values,
+                                        scada::DateTime time) const {
+  size_t cursor = std::min(operand_cursors_[index], values.size());
+  for (size_t step = 0; step < kMaxCursorSteps; ++step) {
+    // The cursor is past `time`: an out-of-order or historical update.
+    if (cursor != 0 && values[cursor - 1].source_timestamp >= time)
+      break;
+    if (cursor == values.size() || values[cursor].source_timestamp >= time)
+      return cursor;
+    ++cursor;
+  }
+  return LowerBound(values, time);
+}
+
 void ExpressionTimedData::UpdateReadyRange() {
   scada::base::Check(historical());
 
@@ -171,8 +282,13 @@ void ExpressionTimedData::UpdateReadyRange() {
 
   scada::base::Check(!operands_ready_from.is_null());
 
+  // Only the part before the calculated range is new.
+  if (operands_ready_from >= ready_from_)
+    return;
+
   auto range = scada::DateTimeRange{operands_ready_from, ready_from_};
   CalculateValuesInRange(range);
+  ready_from_ = operands_ready_from;
   buffer_.AddReadyRange(range);
 }
 
@@ -224,15 +340,23 @@ void ExpressionTimedData::OnTimedDataUpdates(
     std::span<const scada::DataValue> values) {
   scada::base::Check(historical());
   scada::base::Check(!values.empty());
-  scada::base::Check(values.front().source_timestamp >= ready_from_);
 
-  scada::DateTimeRange range{values.front().source_timestamp,
-                             values.back().source_timestamp};
+  // Values before the ready range are calculated once it grows over them.
+  if (values.back().source_timestamp < ready_from_)
+    return;
+
+  // A changed operand value holds until the next value of that operand, which
+  // may lie anywhere later, so everything from the update on is recalculated.
+  // A tail update has nothing to clear and seeks each operand in O(1).
+  scada::DateTimeRange range{
+      std::max(values.front().source_timestamp, ready_from_),
+      kTimedDataCurrentOnly};
 
-  // Clear then recompute the affected range as one logical change; the batch
-  // inside CalculateValuesInRange coalesces the recomputed values into a single
-  // notification, so no manual NotifyUpdates is needed.
-  buffer_.ClearRange(range);
+  // Clear then recompute the affected range as one logical change.
+  auto batch = buffer_.BeginUpdate();
+  const auto& computed = buffer_.values();
+  if (!computed.empty() && computed.back().source_timestamp >= range.first)
+    buffer_.ClearRange(range);
   CalculateValuesInRange(range);
 }
 
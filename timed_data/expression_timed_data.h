@@ -4,6 +4,7 @@
 #include "timed_data/timed_data_observer.h"
 
 #include <memory>
+#include <span>
 #include <vector>
 
 class ScadaExpression;
@@ -34,8 +35,36 @@ class ExpressionTimedData final : public BaseTimedData,
   // Computes expression values across `range` from the operands and inserts
   // them into the buffer (coalescing the inserts into one notification).
   void CalculateValuesInRange(const scada::DateTimeRange& range);
+
+  // Advances `iters` to the next calculation row within `range` and loads its
+  // operand values into the expression items. Returns false when no operand
+  // has values left in `range`.
+  bool NextRow(const scada::DateTimeRange& range,
+               std::span<size_t> iters,
+               scada::DateTime& update_time,
+               scada::Qualifier& total_qualifier);
+
+  // Calculates the remaining rows one by one through the expression.
+  void CalculateRowsInRange(const scada::DateTimeRange& range,
+                            std::span<size_t> iters);
+
+  // Gathers the remaining rows into operand columns and calculates them in one
+  // ScadaExpression::CalculateColumn() call. Returns false, leaving `iters` and
+  // the items as they were, when an operand value is neither a double nor
+  // null.
+  bool CalculateColumnsInRange(const scada::DateTimeRange& range,
+                               std::vector<size_t>& iters);
+
   bool CalculateCurrent();
 
+  // Returns the index of the first value of operand `index` at or after
+  // `time`, starting from the cursor the previous calculation left for that
+  // operand. A tail update lands on or right after the cursor, which makes it
+  // O(1); out-of-order and historical updates fall back to a binary search.
+  size_t SeekOperand(size_t index,
+                     std::span<const scada::DataValue> values,
+                     scada::DateTime time) const;
+
   // TimedData
   virtual void OnObservedRangesChanged() override;
 
@@ -50,6 +79,16 @@ class ExpressionTimedData final : public BaseTimedData,
   std::unique_ptr<ScadaExpression> expression_;
   std::vector<std::shared_ptr<TimedData>> operands_;
 
+  // Per-operand position where the last calculation stopped. Kept between
+  // updates so appending a tail sample does not re-search every operand.
+  std::vector<size_t> operand_cursors_;
+
+  // Scratch of CalculateColumnsInRange(), kept to reuse the allocations.
+  std::vector<std::vector<double>> operand_columns_;
+  std::vector<scada::DateTime> row_times_;
+  std::vector<scada::Qualifier> row_qualifiers_;
+  std::vector<double> row_results_;
+
   scada::DateTime from_ = kTimedDataCurrentOnly;
   scada::DateTime ready_from_ = kTimedDataCurrentOnly;
 };
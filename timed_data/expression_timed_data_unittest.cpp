@@ -4,19 +4,95 @@
 
 #include <gmock/gmock.h>
 
+#include <string>
+#include <utility>
+#include <vector>
+
 using namespace testing;
 
 namespace {
 
+// Distinct, ordered timestamps.
+scada::DateTime At(int seconds) {
+  static const scada::DateTime kBase = scada::DateTime::Now();
+  return kBase + scada::base::TimeDelta::FromSeconds(seconds);
+}
+
+scada::DataValue Sample(int seconds, double value) {
+  return scada::DataValue{value, {}, At(seconds), At(seconds)};
+}
+
 class TestTimedData : public BaseTimedData {
  public:
   using BaseTimedData::UpdateCurrent;
 
+  void AddValues(std::vector<scada::DataValue> values) {
+    buffer_.ReplaceRange(values);
+  }
+
+  void SetReady() { buffer_.AddReadyRange({At(0), kTimedDataCurrentOnly}); }
+
   // BaseTimedData
   virtual std::string GetFormula(bool aliases) const { return "x"; }
   virtual scada::LocalizedText GetTitle() const override { return u"x"; }
 };
 
+using Samples = std::vector<std::pair<scada::DateTime, double>>;
+
+// An ExpressionTimedData over fresh operands, observed from At(0).
+class HistoricalExpression {
+ public:
+  HistoricalExpression(const std::string& formula, size_t operand_count) {
+    auto expression = std::make_unique<ScadaExpression>();
+    expression->Parse(formula.c_str());
+
+    std::vector<std::shared_ptr<TimedData>> operands;
+    for (size_t i = 0; i < operand_count; ++i)
+      operands.emplace_back(
+          operands_.emplace_back(std::make_shared<TestTimedData>()));
+
+    timed_data_ = std::make_shared<ExpressionTimedData>(std::move(expression),
+                                                        std::move(operands));
+    timed_data_->AddViewObserver(observer_, {At(0), kTimedDataCurrentOnly});
+  }
+
+  ~HistoricalExpression() { timed_data_->RemoveViewObserver(observer_); }
+
+  TestTimedData& operand(size_t index) { return *operands_[index]; }
+
+  void SetReady() {
+    for (const auto& operand : operands_)
+      operand->SetReady();
+  }
+
+  Samples samples() const {
+    Samples samples;
+    for (const auto& data_value : timed_data_->GetValues()) {
+      double value = 0;
+      EXPECT_TRUE(data_value.value.get(value));
+      samples.emplace_back(data_value.source_timestamp, value);
+    }
+    return samples;
+  }
+
+  // The samples an expression calculates at once from the current operand
+  // values.
+  Samples fresh_samples(const std::string& formula) {
+    HistoricalExpression fresh{formula, operands_.size()};
+    for (size_t i = 0; i < operands_.size(); ++i) {
+      auto values = operands_[i]->GetValues();
+      fresh.operand(i).AddValues({values.begin(), values.end()});
+    }
+    fresh.SetReady();
+    return fresh.samples();
+  }
+
+ private:
+  std::vector<std::shared_ptr<TestTimedData>> operands_;
+  TimedDataViewObserver observer_;
+  std::shared_ptr<ExpressionTimedData> timed_data_;
+};
+
 }  // namespace
 
 TEST(ExpressionTimedData, Test) {
@@ -35,3 +111,64 @@ TEST(ExpressionTimedData, Test) {
       timed_data->GetDataValue(),
       FieldsAre(15, scada::Qualifier{}, time, _, scada::StatusCode::Good));
 }
+
+TEST(ExpressionTimedData, History) {
+  HistoricalExpression expression{"x * 2", 1};
+  expression.operand(0).AddValues(
+      {Sample(10, 1), Sample(20, 2), Sample(30, 3)});
+  EXPECT_TRUE(expression.samples().empty());
+
+  expression.SetReady();
+  EXPECT_THAT(expression.samples(),
+              ElementsAre(Pair(At(10), 2), Pair(At(20), 4), Pair(At(30), 6)));
+}
+
+TEST(ExpressionTimedData, HistoryTailAppend) {
+  HistoricalExpression expression{"x * 2", 1};
+  expression.operand(0).AddValues({Sample(10, 1), Sample(20, 2)});
+  expression.SetReady();
+
+  expression.operand(0).AddValues({Sample(30, 3)});
+  expression.operand(0).AddValues({Sample(40, 4)});
+
+  EXPECT_THAT(expression.samples(),
+              ElementsAre(Pair(At(10), 2), Pair(At(20), 4), Pair(At(30), 6),
+                          Pair(At(40), 8)));
+  EXPECT_EQ(expression.samples(), expression.fresh_samples("x * 2"));
+}
+
+// An insert before the calculated tail seeks past the operand cursor and
+// recalculates everything from the insert on.
+TEST(ExpressionTimedData, HistoryInsertAfterTailAppend) {
+  HistoricalExpression expression{"x * 2", 1};
+  expression.operand(0).AddValues({Sample(10, 1), Sample(20, 2)});
+  expression.SetReady();
+  expression.operand(0).AddValues({Sample(30, 3)});
+
+  expression.operand(0).AddValues({Sample(15, 7)});
+
+  EXPECT_THAT(expression.samples(),
+              ElementsAre(Pair(At(10), 2), Pair(At(15), 14), Pair(At(20), 4),
+                          Pair(At(30), 6)));
+  EXPECT_EQ(expression.samples(), expression.fresh_samples("x * 2"));
+}
+
+// A value inserted behind the cursor of one operand holds for the rows the
+// other operand produced after it.
+TEST(ExpressionTimedData, HistoryOperandGainsValueBehindCursor) {
+  HistoricalExpression expression{"x + y", 2};
+  expression.operand(0).AddValues(
+      {Sample(10, 1), Sample(20, 2), Sample(30, 3)});
+  expression.operand(1).AddValues({Sample(10, 100)});
+  expression.SetReady();
+  EXPECT_THAT(expression.samples(),
+              ElementsAre(Pair(At(10), 101), Pair(At(20), 102),
+                          Pair(At(30), 103)));
+
+  expression.operand(1).AddValues({Sample(15, 200)});
+
+  EXPECT_THAT(expression.samples(),
+              ElementsAre(Pair(At(10), 101), Pair(At(15), 201),
+                          Pair(At(20), 202), Pair(At(30), 203)));
+  EXPECT_EQ(expression.samples(), expression.fresh_samples("x + y"));
+}
@@ -18,7 +18,9 @@ module;
 #include "timed_data/timed_data.h"
 #include "timed_data/timed_data_context.h"
 #include "timed_data/timed_data_fake.h"
+#include "timed_data/timed_data_fetch_scheduler.h"
 #include "timed_data/timed_data_fetcher.h"
+#include "timed_data/timed_data_history_cache.h"
 #include "timed_data/timed_data_impl.h"
 #include "timed_data/timed_data_buffer.h"
 #include "timed_data/timed_data_buffer_fwd.h"
@@ -58,6 +60,13 @@ export {
   using ::TimedDataContext;
   using ::TimedDataFetcher;
   using ::TimedDataFetcherContext;
+  using ::TimedDataFetchScheduler;
+  using ::TimedDataFetchSchedulerOptions;
+  using ::TimedDataReadSlot;
+
+  // timed_data_history_cache.h
+  using ::TimedDataHistoryCache;
+  using ::TimedDataHistoryCacheOptions;
 
   // timed_data_observer.h / timed_data_property.h
   using ::PROPERTY_CURRENT;
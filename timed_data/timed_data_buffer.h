@@ -152,6 +152,12 @@ class BasicTimedDataBuffer final {
                    const scada::DateTimeRange& range);
   void RemoveObserver(BasicTimedDataViewObserver<T>& observer);
 
+  // The union of the historical ranges of the observers, sorted.
+  const std::vector<scada::DateTimeRange>& observed_ranges() const
+      SCADA_LIFETIME_BOUND {
+    return observed_ranges_;
+  }
+
   // Readiness.
 
   const std::vector<scada::DateTimeRange>& ready_ranges() const
@@ -9,6 +9,7 @@
 
 class NodeEventProvider;
 class NodeService;
+class TimedDataFetchScheduler;
 
 namespace scada {
 class HistoryService;
@@ -21,6 +22,9 @@ struct TimedDataContext {
   DataServices data_services_;
   std::shared_ptr<scada::HistoryService> history_service_;
   NodeEventProvider& node_event_provider_;
+  // Shared by the history fetchers of all timed data. TimedDataServiceImpl
+  // creates one when none is provided.
+  std::shared_ptr<TimedDataFetchScheduler> fetch_scheduler_;
 };
 
 struct CoroutineTimedDataContext {
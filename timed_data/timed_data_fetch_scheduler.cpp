@@ -0,0 +1,102 @@
+#include "timed_data/timed_data_fetch_scheduler.h"
+
+#include "base/check.h"
+
+#include <algorithm>
+
+struct TimedDataReadSlot::Lease {
+  ~Lease() {
+    if (auto scheduler = weak_scheduler.lock())
+      scheduler->Release();
+  }
+
+  std::weak_ptr<TimedDataFetchScheduler> weak_scheduler;
+  size_t read_count = 0;
+  scada::base::TimeTicks start_ticks;
+};
+
+size_t TimedDataReadSlot::read_count() const {
+  scada::base::Check(lease_ != nullptr);
+  return lease_->read_count;
+}
+
+void TimedDataReadSlot::Complete(size_t value_count) {
+  if (!lease_)
+    return;
+
+  if (auto scheduler = lease_->weak_scheduler.lock()) {
+    scheduler->OnReadComplete(
+        lease_->read_count, value_count,
+        scada::base::TimeTicks::Now() - lease_->start_ticks);
+  }
+
+  lease_.reset();
+}
+
+// TimedDataFetchScheduler
+
+TimedDataFetchScheduler::TimedDataFetchScheduler(
+    TimedDataFetchSchedulerOptions options)
+    : options_{std::move(options)}, read_count_{options_.initial_read_count} {
+  scada::base::Check(options_.max_parallel_reads != 0);
+  scada::base::Check(options_.min_read_count <= options_.initial_read_count &&
+                     options_.initial_read_count <= options_.max_read_count);
+}
+
+TimedDataFetchScheduler::~TimedDataFetchScheduler() = default;
+
+void TimedDataFetchScheduler::Schedule(StartHandler start) {
+  queue_.emplace_back(std::move(start));
+  StartQueued();
+}
+
+void TimedDataFetchScheduler::StartQueued() {
+  // A handler may drop its slot synchronously, which re-enters through
+  // Release(); the outer loop picks up the freed capacity.
+  if (starting_)
+    return;
+
+  starting_ = true;
+  while (running_count_ < options_.max_parallel_reads && !queue_.empty()) {
+    auto start = std::move(queue_.front());
+    queue_.pop_front();
+
+    auto lease = std::make_shared<TimedDataReadSlot::Lease>();
+    lease->weak_scheduler = weak_from_this();
+    lease->read_count = read_count_;
+    lease->start_ticks = scada::base::TimeTicks::Now();
+
+    ++running_count_;
+    start(TimedDataReadSlot{std::move(lease)});
+  }
+  starting_ = false;
+}
+
+void TimedDataFetchScheduler::Release() {
+  scada::base::Check(running_count_ != 0);
+  --running_count_;
+  StartQueued();
+}
+
+void TimedDataFetchScheduler::OnReadComplete(size_t requested_count,
+                                             size_t value_count,
+                                             scada::base::TimeDelta duration) {
+  const size_t old_read_count = read_count_;
+
+  // AIMD-like: a fast full page means the server can take more per round
+  // trip; a slow read of any size means pages are too large.
+  if (duration > options_.target_read_duration) {
+    read_count_ = std::max(options_.min_read_count, read_count_ / 2);
+  } else if (value_count >= requested_count &&
+             duration * 2 < options_.target_read_duration) {
+    read_count_ = std::min(options_.max_read_count, read_count_ * 2);
+  }
+
+  if (read_count_ != old_read_count) {
+    LOG_INFO(logger_) << "Read count changed"
+                      << LOG_TAG("DurationMs", duration.InMilliseconds())
+                      << LOG_TAG("ValueCount", value_count)
+                      << LOG_TAG("OldReadCount", old_read_count)
+                      << LOG_TAG("NewReadCount", read_count_);
+  }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "base/boost_log.h"
+#include "scada/date_time.h"
+
+#include <deque>
+#include <functional>
+#include <memory>
+
+class TimedDataFetchScheduler;
+
+struct TimedDataFetchSchedulerOptions {
+  // Bound on history reads in flight across all fetchers.
+  size_t max_parallel_reads = 8;
+
+  // Page size (values per read) bounds for the adaptive controller.
+  size_t initial_read_count = 10000;
+  size_t min_read_count = 1000;
+  size_t max_read_count = 100000;
+
+  // A full page answered faster than half of this grows the page size; any
+  // read slower than this shrinks it.
+  scada::base::TimeDelta target_read_duration =
+      scada::base::TimeDelta::FromSeconds(1);
+};
+
+// A granted history read. The slot is returned to the scheduler when the last
+// copy is destroyed, so a read abandoned halfway never leaks capacity.
+class TimedDataReadSlot {
+ public:
+  TimedDataReadSlot() = default;
+
+  bool empty() const { return !lease_; }
+
+  // The page size to request.
+  size_t read_count() const;
+
+  // Feeds the read outcome into the page-size controller and releases the
+  // slot.
+  void Complete(size_t value_count);
+
+ private:
+  struct Lease;
+
+  explicit TimedDataReadSlot(std::shared_ptr<Lease> lease)
+      : lease_{std::move(lease)} {}
+
+  std::shared_ptr<Lease> lease_;
+
+  friend class TimedDataFetchScheduler;
+};
+
+// Shares history read capacity between the TimedDataFetchers of one
+// TimedDataServiceImpl: bounds the reads in flight globally, serves waiting
+// fetchers in FIFO order (a fetcher re-queues for every page, so pens
+// round-robin instead of one long history starving the rest), and sizes pages
+// from observed response times.
+class TimedDataFetchScheduler
+    : public std::enable_shared_from_this<TimedDataFetchScheduler> {
+ public:
+  explicit TimedDataFetchScheduler(TimedDataFetchSchedulerOptions options = {});
+  ~TimedDataFetchScheduler();
+
+  TimedDataFetchScheduler(const TimedDataFetchScheduler&) = delete;
+  TimedDataFetchScheduler& operator=(const TimedDataFetchScheduler&) = delete;
+
+  using StartHandler = std::function<void(TimedDataReadSlot slot)>;
+
+  // Calls `start` once a read slot is free. The handler owns the slot; if it
+  // drops the slot (e.g. its fetcher is gone), the next read starts.
+  void Schedule(StartHandler start);
+
+  // Diagnostics.
+  size_t read_count() const { return read_count_; }
+  size_t running_count() const { return running_count_; }
+  size_t queued_count() const { return queue_.size(); }
+
+ private:
+  void StartQueued();
+  void Release();
+  void OnReadComplete(size_t requested_count,
+                      size_t value_count,
+                      scada::base::TimeDelta duration);
+
+  const TimedDataFetchSchedulerOptions options_;
+
+  std::deque<StartHandler> queue_;
+  size_t running_count_ = 0;
+  size_t read_count_ = 0;
+  bool starting_ = false;
+
+  inline static BoostLogger logger_{LOG_NAME("TimedDataFetchScheduler")};
+
+  friend class TimedDataReadSlot;
+};
@@ -0,0 +1,74 @@
+#include "timed_data/timed_data_fetch_scheduler.h"
+
+#include <gmock/gmock.h>
+
+#include <vector>
+
+using namespace testing;
+
+namespace {
+
+std::shared_ptr<TimedDataFetchScheduler> MakeScheduler(
+    size_t max_parallel_reads) {
+  return std::make_shared<TimedDataFetchScheduler>(
+      TimedDataFetchSchedulerOptions{.max_parallel_reads = max_parallel_reads});
+}
+
+}  // namespace
+
+TEST(TimedDataFetchScheduler, BoundsParallelReads) {
+  auto scheduler = MakeScheduler(2);
+
+  std::vector<TimedDataReadSlot> slots;
+  for (int i = 0; i < 5; ++i) {
+    scheduler->Schedule(
+        [&](TimedDataReadSlot slot) { slots.emplace_back(std::move(slot)); });
+  }
+
+  EXPECT_EQ(slots.size(), 2u);
+  EXPECT_EQ(scheduler->running_count(), 2u);
+  EXPECT_EQ(scheduler->queued_count(), 3u);
+
+  // Completing a read starts the next queued one.
+  slots.front().Complete(0);
+  EXPECT_EQ(slots.size(), 3u);
+  EXPECT_EQ(scheduler->running_count(), 2u);
+  EXPECT_EQ(scheduler->queued_count(), 2u);
+}
+
+TEST(TimedDataFetchScheduler, DroppedSlotIsReleased) {
+  auto scheduler = MakeScheduler(1);
+
+  int started = 0;
+  // The first handler's fetcher is gone: it drops the slot right away.
+  scheduler->Schedule([&](TimedDataReadSlot slot) { ++started; });
+  std::vector<TimedDataReadSlot> slots;
+  scheduler->Schedule([&](TimedDataReadSlot slot) {
+    ++started;
+    slots.emplace_back(std::move(slot));
+  });
+
+  EXPECT_EQ(started, 2);
+  EXPECT_EQ(scheduler->running_count(), 1u);
+
+  slots.clear();
+  EXPECT_EQ(scheduler->running_count(), 0u);
+}
+
+TEST(TimedDataFetchScheduler, FastFullPageGrowsReadCount) {
+  auto scheduler = MakeScheduler(1);
+  const size_t initial_read_count = scheduler->read_count();
+
+  TimedDataReadSlot slot;
+  scheduler->Schedule([&](TimedDataReadSlot granted) { slot = granted; });
+  ASSERT_FALSE(slot.empty());
+  EXPECT_EQ(slot.read_count(), initial_read_count);
+
+  slot.Complete(initial_read_count);
+  EXPECT_EQ(scheduler->read_count(), initial_read_count * 2);
+
+  // A partial page says nothing about capacity.
+  scheduler->Schedule([&](TimedDataReadSlot granted) { slot = granted; });
+  slot.Complete(1);
+  EXPECT_EQ(scheduler->read_count(), initial_read_count * 2);
+}
@@ -15,6 +15,7 @@
 #include "timed_data/timed_data_util.h"
 
 namespace {
+// Page size when no fetch scheduler sizes pages adaptively.
 const size_t kMaxReadCount = 10000;
 }
 
@@ -42,19 +43,11 @@ void TimedDataFetcher::FetchNextGap() {
                     << LOG_TAG("To", FormatTime(querying_range_.second));
 
   // Query history in the backward direction.
-  scada::HistoryReadRawDetails details{node_.node_id(), querying_range_.first,
-                                       querying_range_.second, kMaxReadCount,
-                                       aggregate_filter_};
-  CoSpawn(executor_, weak_from_this(),
-          [details](std::shared_ptr<TimedDataFetcher> self) -> Awaitable<void> {
-            auto result =
-                co_await self->history_service_.HistoryReadRaw(details);
-            ScopedContinuationPoint scoped_continuation_point{
-                self->executor_, self->history_service_, details,
-                std::move(result.continuation_point)};
-            self->OnHistoryReadRawComplete(
-                std::move(result.values), std::move(scoped_continuation_point));
-          });
+  StartRead([node_id = node_.node_id(), range = querying_range_,
+             aggregate_filter = aggregate_filter_](size_t read_count) {
+    return scada::HistoryReadRawDetails{node_id, range.first, range.second,
+                                        read_count, aggregate_filter};
+  });
 }
 
 void TimedDataFetcher::FetchMore(ScopedContinuationPoint continuation_point) {
@@ -84,18 +77,47 @@ void TimedDataFetcher::FetchMore(ScopedContinuationPoint continuation_point) {
                     << LOG_TAG("Range",
                                ToString(scada::base::AsPair(querying_range_)));
 
-  // Query history in the backward direction.
-  scada::HistoryReadRawDetails details{node_.node_id(),
-                                       querying_range_.second,
-                                       querying_range_.first,
-                                       kMaxReadCount,
-                                       aggregate_filter_,
-                                       false,
-                                       continuation_point.release()};
+  // Query history in the backward direction. The continuation point moves
+  // into the request only once the read is granted, so a fetcher destroyed
+  // while queued still releases it.
+  auto pending_continuation_point =
+      std::make_shared<ScopedContinuationPoint>(std::move(continuation_point));
+  StartRead([node_id = node_.node_id(), range = querying_range_,
+             aggregate_filter = aggregate_filter_,
+             pending_continuation_point](size_t read_count) {
+    return scada::HistoryReadRawDetails{node_id,
+                                        range.second,
+                                        range.first,
+                                        read_count,
+                                        aggregate_filter,
+                                        false,
+                                        pending_continuation_point->release()};
+  });
+}
+
+void TimedDataFetcher::StartRead(DetailsFactory make_details) {
+  if (!fetch_scheduler_) {
+    SpawnRead(make_details(kMaxReadCount), TimedDataReadSlot{});
+    return;
+  }
+
+  fetch_scheduler_->Schedule(
+      [weak_self = weak_from_this(),
+       make_details = std::move(make_details)](TimedDataReadSlot slot) {
+        if (auto self = weak_self.lock()) {
+          self->SpawnRead(make_details(slot.read_count()), std::move(slot));
+        }
+      });
+}
+
+void TimedDataFetcher::SpawnRead(scada::HistoryReadRawDetails details,
+                                 TimedDataReadSlot slot) {
   CoSpawn(executor_, weak_from_this(),
-          [details](std::shared_ptr<TimedDataFetcher> self) -> Awaitable<void> {
+          [details, slot](std::shared_ptr<TimedDataFetcher> self) mutable
+              -> Awaitable<void> {
             auto result =
                 co_await self->history_service_.HistoryReadRaw(details);
+            slot.Complete(result.values.size());
             ScopedContinuationPoint scoped_continuation_point{
                 self->executor_, self->history_service_, details,
                 std::move(result.continuation_point)};
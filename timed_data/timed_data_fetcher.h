@@ -6,12 +6,19 @@
 #include "node_service/node_ref.h"
 #include "scada/date_time_range.h"
 #include "timed_data/timed_data_buffer_fwd.h"
+#include "timed_data/timed_data_fetch_scheduler.h"
+
+#include <functional>
+#include <memory>
 
 struct TimedDataFetcherContext {
   TimedDataBuffer& buffer_;
   AnyExecutor executor_;
   scada::HistoryService& history_service_;
   const scada::AggregateFilter aggregate_filter_;
+  // Optional. Without a scheduler every read starts at once with a fixed
+  // page size.
+  const std::shared_ptr<TimedDataFetchScheduler> fetch_scheduler_;
 };
 
 class TimedDataFetcher : private TimedDataFetcherContext,
@@ -26,6 +33,13 @@ class TimedDataFetcher : private TimedDataFetcherContext,
  private:
   void FetchMore(ScopedContinuationPoint continuation_point);
 
+  // Reads a page through the fetch scheduler, if any. `make_details` builds
+  // the request for the granted page size.
+  using DetailsFactory =
+      std::function<scada::HistoryReadRawDetails(size_t read_count)>;
+  void StartRead(DetailsFactory make_details);
+  void SpawnRead(scada::HistoryReadRawDetails details, TimedDataReadSlot slot);
+
   void OnHistoryReadRawComplete(std::vector<scada::DataValue> values,
                                 ScopedContinuationPoint continuation_point);
 
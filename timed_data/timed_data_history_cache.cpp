@@ -0,0 +1,527 @@
+#include "timed_data/timed_data_history_cache.h"
+
+#include "base/awaitable.h"
+#include "base/check.h"
+#include "common/data_value_traits.h"
+#include "common/timed_data_util.h"
+#include "model/node_id_util.h"
+#include "scada/aggregate_filter.h"
+#include "timed_data/timed_data_util.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <optional>
+
+// Segment file layout, native byte order (the cache never leaves the host):
+//
+//   header:  "TDHC" u32:version u32:key_size key
+//   records: 'V' u32:count count * sample
+//            'R' i64:from i64:to
+//   sample:  i64:source_timestamp i64:server_timestamp u8:value_type
+//            u64:value u32:qualifier u32:status_code
+//
+// Version 2 keeps INT32 values apart from INT64 ones; version 1 files, which
+// widened them, are discarded.
+//
+// Records are replayed in order on load; a later 'V' batch replaces the
+// samples its time span overlaps. A torn record at the end, left by a crash
+// mid-append, is cut off.
+
+namespace {
+
+constexpr char kMagic[4] = {'T', 'D', 'H', 'C'};
+constexpr uint32_t kVersion = 2;
+
+constexpr char kValuesRecord = 'V';
+constexpr char kReadyRecord = 'R';
+
+enum class ValueType : uint8_t { Empty, Boolean, Int64, Double, Int32 };
+
+struct EncodedValue {
+  ValueType type = ValueType::Empty;
+  uint64_t bits = 0;
+};
+
+std::optional<EncodedValue> EncodeValue(const scada::Variant& value) {
+  if (value.is_array())
+    return std::nullopt;
+
+  switch (value.type()) {
+    case scada::Variant::EMPTY:
+      return EncodedValue{};
+    case scada::Variant::BOOL:
+      return EncodedValue{ValueType::Boolean, value.as_bool() ? 1u : 0u};
+    case scada::Variant::INT32:
+      return EncodedValue{ValueType::Int32,
+                          std::bit_cast<uint32_t>(value.get<scada::Int32>())};
+    case scada::Variant::INT64:
+      return EncodedValue{ValueType::Int64,
+                          std::bit_cast<uint64_t>(value.get<scada::Int64>())};
+    case scada::Variant::DOUBLE:
+      return EncodedValue{ValueType::Double,
+                          std::bit_cast<uint64_t>(value.get<scada::Double>())};
+    default:
+      return std::nullopt;
+  }
+}
+
+std::optional<scada::Variant> DecodeValue(uint8_t type, uint64_t bits) {
+  switch (static_cast<ValueType>(type)) {
+    case ValueType::Empty:
+      return scada::Variant{};
+    case ValueType::Boolean:
+      return scada::Variant{bits != 0};
+    case ValueType::Int32:
+      return scada::Variant{
+          std::bit_cast<scada::Int32>(static_cast<uint32_t>(bits))};
+    case ValueType::Int64:
+      return scada::Variant{std::bit_cast<scada::Int64>(bits)};
+    case ValueType::Double:
+      return scada::Variant{std::bit_cast<scada::Double>(bits)};
+  }
+  return std::nullopt;
+}
+
+template <class T>
+void Put(std::string& out, const T& value) {
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  out.append(bytes, sizeof(value));
+}
+
+class Reader {
+ public:
+  explicit Reader(std::string_view data) : data_{data} {}
+
+  size_t position() const { return position_; }
+  bool at_end() const { return position_ == data_.size(); }
+
+  template <class T>
+  bool Get(T& value) {
+    if (data_.size() - position_ < sizeof(value))
+      return false;
+    std::memcpy(&value, data_.data() + position_, sizeof(value));
+    position_ += sizeof(value);
+    return true;
+  }
+
+  bool Get(std::string& value, size_t size) {
+    if (data_.size() - position_ < size)
+      return false;
+    value.assign(data_.substr(position_, size));
+    position_ += size;
+    return true;
+  }
+
+ private:
+  const std::string_view data_;
+  size_t position_ = 0;
+};
+
+std::string MakeSegmentKey(const scada::NodeId& node_id,
+                           const scada::AggregateFilter& aggregation) {
+  return std::format("{}|{}|{}|{}", NodeIdToScadaString(node_id),
+                     NodeIdToScadaString(aggregation.aggregate_type),
+                     aggregation.start_time.ToInternalValue(),
+                     aggregation.interval.InMicroseconds());
+}
+
+// FNV-1a: stable across runs and builds, unlike std::hash. Collisions are
+// caught by the key stored in the file header.
+uint64_t HashSegmentKey(std::string_view key) {
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : key) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string EncodeHeader(std::string_view key) {
+  std::string out{kMagic, sizeof(kMagic)};
+  Put(out, kVersion);
+  Put(out, static_cast<uint32_t>(key.size()));
+  out.append(key);
+  return out;
+}
+
+bool IsValidRange(const scada::DateTimeRange& range) {
+  return !range.first.is_null() && !range.second.is_null() &&
+         range.first < range.second;
+}
+
+}  // namespace
+
+struct TimedDataHistoryCache::Segment {
+  std::string key;
+  std::filesystem::path path;
+  bool loaded = false;
+
+  // Set when the series holds a value type the file can't keep, or the file
+  // can't be written. Reads then pass through.
+  bool disabled = false;
+
+  // Sorted by source timestamp.
+  std::vector<scada::DataValue> values;
+  std::vector<scada::DateTimeRange> ready_ranges;
+
+  void Merge(std::span<const scada::DataValue> batch) {
+    if (batch.empty())
+      return;
+
+    auto first = std::ranges::lower_bound(
+        values, batch.front().source_timestamp, std::less{},
+        &scada::DataValue::source_timestamp);
+    auto last = std::ranges::upper_bound(
+        first, values.end(), batch.back().source_timestamp, std::less{},
+        &scada::DataValue::source_timestamp);
+    auto i = values.erase(first, last);
+    values.insert(i, batch.begin(), batch.end());
+  }
+
+  std::vector<scada::DataValue> Copy(const scada::DateTimeRange& range) const {
+    auto first =
+        std::ranges::lower_bound(values, range.first, std::less{},
+                                 &scada::DataValue::source_timestamp);
+    auto last = std::ranges::upper_bound(first, values.end(), range.second,
+                                         std::less{},
+                                         &scada::DataValue::source_timestamp);
+    return {first, last};
+  }
+};
+
+TimedDataHistoryCache::TimedDataHistoryCache(
+    std::shared_ptr<scada::HistoryService> history_service,
+    TimedDataHistoryCacheOptions options)
+    : history_service_{std::move(history_service)},
+      options_{std::move(options)} {
+  scada::base::Check(history_service_ != nullptr);
+  scada::base::Check(!options_.directory.empty());
+}
+
+TimedDataHistoryCache::~TimedDataHistoryCache() = default;
+
+Awaitable<scada::HistoryReadRawResult> TimedDataHistoryCache::HistoryReadRaw(
+    scada::HistoryReadRawDetails details) {
+  if (!details.continuation_point.empty()) {
+    // A next page of a read answered from the segment.
+    if (auto local = local_reads_.extract(details.continuation_point);
+        !local.empty()) {
+      if (details.release_continuation_point) {
+        co_return scada::HistoryReadRawResult{
+            .status = scada::StatusCode::Good};
+      }
+      co_return co_await HistoryReadRaw(std::move(local.mapped()));
+    }
+
+    // A next page of a server read started below.
+    auto pending = pending_reads_.extract(details.continuation_point);
+    const bool release = details.release_continuation_point;
+    auto result = co_await history_service_->HistoryReadRaw(std::move(details));
+    ++remote_read_count_;
+    if (!pending.empty() && !release) {
+      auto next = OnRemoteRead(pending.mapped(), result);
+      if (next.segment && !result.continuation_point.empty())
+        pending_reads_.insert_or_assign(result.continuation_point, next);
+    }
+    co_return result;
+  }
+
+  // Only forward reads are cached; a backward read expects its answer in
+  // descending order and is rare enough to pass through.
+  const scada::DateTimeRange range{details.from, details.to};
+  auto& segment = GetSegment(details.node_id, details.aggregation);
+  if (segment.disabled || !IsValidRange(range)) {
+    ++remote_read_count_;
+    co_return co_await history_service_->HistoryReadRaw(std::move(details));
+  }
+
+  auto gap = FindFirstGap(std::vector{range}, segment.ready_ranges);
+  if (!gap) {
+    ++local_read_count_;
+    auto values = segment.Copy(range);
+    const bool more =
+        details.max_count != 0 && values.size() > details.max_count;
+    co_return MakeLocalPage(std::move(values), std::move(details), more);
+  }
+
+  // Ask the server from the first uncovered moment on, and put the covered
+  // head in front of its answer.
+  auto head = segment.Copy({range.first, gap->first});
+  if (!head.empty() && head.back().source_timestamp == gap->first)
+    head.pop_back();
+
+  // A head that fills the page is answered locally; the server is asked once
+  // the client gets to the gap.
+  if (details.max_count != 0 && head.size() >= details.max_count) {
+    ++local_read_count_;
+    co_return MakeLocalPage(std::move(head), std::move(details), /*more=*/true);
+  }
+
+  const PendingRead pending{.segment = &segment,
+                            .from = gap->first,
+                            .ready_limit = std::min(
+                                range.second, scada::DateTime::Now())};
+
+  details.from = gap->first;
+  if (details.max_count != 0)
+    details.max_count -= head.size();
+  auto result = co_await history_service_->HistoryReadRaw(std::move(details));
+  ++remote_read_count_;
+
+  auto next = OnRemoteRead(pending, result);
+  if (next.segment && !result.continuation_point.empty())
+    pending_reads_.insert_or_assign(result.continuation_point, next);
+
+  if (!head.empty()) {
+    result.values.insert(result.values.begin(),
+                         std::make_move_iterator(head.begin()),
+                         std::make_move_iterator(head.end()));
+  }
+
+  co_return result;
+}
+
+scada::HistoryReadRawResult TimedDataHistoryCache::MakeLocalPage(
+    std::vector<scada::DataValue> values,
+    scada::HistoryReadRawDetails details,
+    bool more) {
+  scada::HistoryReadRawResult result{.status = scada::StatusCode::Good};
+
+  if (more) {
+    if (values.size() > details.max_count)
+      values.resize(details.max_count);
+    // The next page starts right after the last value of this one.
+    details.from = values.back().source_timestamp +
+                   scada::base::TimeDelta::FromMicroseconds(1);
+    auto id = std::format("tdhc:{}", ++next_local_read_id_);
+    result.continuation_point = scada::ByteString{id.begin(), id.end()};
+    local_reads_.insert_or_assign(result.continuation_point,
+                                  std::move(details));
+  }
+
+  result.values = std::move(values);
+  return result;
+}
+
+Awaitable<scada::HistoryReadEventsResult>
+TimedDataHistoryCache::HistoryReadEvents(scada::NodeId node_id,
+                                         scada::base::Time from,
+                                         scada::base::Time to,
+                                         scada::EventFilter filter) {
+  co_return co_await history_service_->HistoryReadEvents(
+      std::move(node_id), from, to, std::move(filter));
+}
+
+TimedDataHistoryCache::Segment& TimedDataHistoryCache::GetSegment(
+    const scada::NodeId& node_id,
+    const scada::AggregateFilter& aggregation) {
+  auto key = MakeSegmentKey(node_id, aggregation);
+  auto& segment = segments_[key];
+  if (!segment) {
+    segment = std::make_unique<Segment>();
+    segment->path = options_.directory /
+                    std::format("{:016x}.tdhc", HashSegmentKey(key));
+    segment->key = std::move(key);
+  }
+
+  if (!segment->loaded) {
+    segment->loaded = true;
+    Load(*segment);
+  }
+
+  return *segment;
+}
+
+void TimedDataHistoryCache::Load(Segment& segment) {
+  std::string data;
+  {
+    std::ifstream file{segment.path, std::ios::binary};
+    if (!file)
+      return;
+    data.assign(std::istreambuf_iterator<char>{file},
+                std::istreambuf_iterator<char>{});
+  }
+
+  Reader reader{data};
+
+  char magic[sizeof(kMagic)] = {};
+  uint32_t version = 0;
+  uint32_t key_size = 0;
+  std::string key;
+  if (!reader.Get(magic) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+      !reader.Get(version) || version != kVersion || !reader.Get(key_size) ||
+      !reader.Get(key, key_size) || key != segment.key) {
+    // A foreign, outdated or colliding file: start over.
+    LOG_WARNING(logger_) << "Discarding history cache segment"
+                         << LOG_TAG("Path", segment.path.string());
+    std::error_code error;
+    std::filesystem::remove(segment.path, error);
+    return;
+  }
+
+  size_t good_size = reader.position();
+  std::vector<scada::DataValue> batch;
+  while (!reader.at_end()) {
+    char kind = 0;
+    if (!reader.Get(kind))
+      break;
+
+    if (kind == kValuesRecord) {
+      uint32_t count = 0;
+      if (!reader.Get(count))
+        break;
+
+      batch.clear();
+      bool complete = true;
+      for (uint32_t i = 0; i < count && complete; ++i) {
+        int64_t source_timestamp = 0;
+        int64_t server_timestamp = 0;
+        uint8_t value_type = 0;
+        uint64_t value_bits = 0;
+        uint32_t qualifier = 0;
+        uint32_t status_code = 0;
+        complete = reader.Get(source_timestamp) &&
+                   reader.Get(server_timestamp) && reader.Get(value_type) &&
+                   reader.Get(value_bits) && reader.Get(qualifier) &&
+                   reader.Get(status_code);
+        if (!complete)
+          break;
+
+        auto value = DecodeValue(value_type, value_bits);
+        complete = value.has_value();
+        if (!complete)
+          break;
+
+        auto& data_value = batch.emplace_back(
+            std::move(*value), scada::Qualifier{qualifier},
+            scada::DateTime::FromInternalValue(source_timestamp),
+            scada::DateTime::FromInternalValue(server_timestamp));
+        data_value.status_code = static_cast<scada::StatusCode>(status_code);
+      }
+      if (!complete)
+        break;
+
+      segment.Merge(batch);
+
+    } else if (kind == kReadyRecord) {
+      int64_t from = 0;
+      int64_t to = 0;
+      if (!reader.Get(from) || !reader.Get(to))
+        break;
+      scada::DateTimeRange range{scada::DateTime::FromInternalValue(from),
+                                 scada::DateTime::FromInternalValue(to)};
+      if (IsValidRange(range))
+        UnionIntervals(segment.ready_ranges, range);
+
+    } else {
+      break;
+    }
+
+    good_size = reader.position();
+  }
+
+  if (good_size != data.size()) {
+    LOG_WARNING(logger_) << "Truncating torn history cache segment"
+                         << LOG_TAG("Path", segment.path.string())
+                         << LOG_TAG("Size", data.size())
+                         << LOG_TAG("GoodSize", good_size);
+    std::error_code error;
+    std::filesystem::resize_file(segment.path, good_size, error);
+  }
+}
+
+TimedDataHistoryCache::PendingRead TimedDataHistoryCache::OnRemoteRead(
+    const PendingRead& pending,
+    const scada::HistoryReadRawResult& result) {
+  if (!result.status)
+    return {};
+
+  // Mirrors TimedDataFetcher: a complete answer covers the whole request, a
+  // paged one covers up to its last value.
+  scada::DateTime ready_to = pending.ready_limit;
+  if (!result.continuation_point.empty()) {
+    ready_to = result.values.empty()
+                   ? pending.from
+                   : std::clamp(result.values.back().source_timestamp,
+                                pending.from, pending.ready_limit);
+  }
+
+  Store(*pending.segment, result.values, {pending.from, ready_to});
+
+  return {.segment = pending.segment,
+          .from = std::max(pending.from, ready_to),
+          .ready_limit = pending.ready_limit};
+}
+
+void TimedDataHistoryCache::Store(Segment& segment,
+                                  std::span<const scada::DataValue> values,
+                                  const scada::DateTimeRange& ready_range) {
+  if (segment.disabled)
+    return;
+
+  std::string record;
+  if (!values.empty()) {
+    // Leave malformed answers uncached; TimedDataFetcher sanitizes its copy.
+    if (!IsTimeSorted(values))
+      return;
+
+    record.reserve(1 + sizeof(uint32_t) + values.size() * 33);
+    Put(record, kValuesRecord);
+    Put(record, static_cast<uint32_t>(values.size()));
+    for (const auto& value : values) {
+      auto encoded = EncodeValue(value.value);
+      if (!encoded) {
+        LOG_INFO(logger_) << "Series is not cacheable"
+                          << LOG_TAG("Key", segment.key);
+        segment.disabled = true;
+        segment.values.clear();
+        segment.ready_ranges.clear();
+        std::error_code error;
+        std::filesystem::remove(segment.path, error);
+        return;
+      }
+      Put(record, value.source_timestamp.ToInternalValue());
+      Put(record, value.server_timestamp.ToInternalValue());
+      Put(record, static_cast<uint8_t>(encoded->type));
+      Put(record, encoded->bits);
+      Put(record, static_cast<uint32_t>(value.qualifier.raw()));
+      Put(record, static_cast<uint32_t>(value.status_code));
+    }
+  }
+
+  const bool ready = IsValidRange(ready_range);
+  if (ready) {
+    Put(record, kReadyRecord);
+    Put(record, ready_range.first.ToInternalValue());
+    Put(record, ready_range.second.ToInternalValue());
+  }
+
+  if (record.empty())
+    return;
+
+  segment.Merge(values);
+  if (ready)
+    UnionIntervals(segment.ready_ranges, ready_range);
+
+  std::error_code error;
+  const bool exists = std::filesystem::exists(segment.path, error);
+  if (!exists)
+    std::filesystem::create_directories(options_.directory, error);
+
+  std::ofstream file{segment.path, std::ios::binary | std::ios::app};
+  if (!exists)
+    file << EncodeHeader(segment.key);
+  file.write(record.data(), static_cast<std::streamsize>(record.size()));
+  file.flush();
+
+  if (!file) {
+    // The file now lags behind memory; fall back to the server for good.
+    LOG_WARNING(logger_) << "Can't write history cache segment"
+                         << LOG_TAG("Path", segment.path.string());
+    segment.disabled = true;
+  }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "base/boost_log.h"
+#include "scada/data_value.h"
+#include "scada/date_time_range.h"
+#include "scada/history_service.h"
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TimedDataHistoryCacheOptions {
+  // Holds one segment file per (node, aggregate filter). Created on the first
+  // write.
+  std::filesystem::path directory;
+};
+
+// A scada::HistoryService decorator that keeps raw history reads in local
+// append-only segment files, so a restarted client reopens trends from disk
+// and only asks the server for what it has never seen - usually the tail
+// since the last run. Optional: wrap the history service passed in
+// TimedDataContext to enable it.
+//
+// A segment holds the values read for one (node, aggregate filter) and the
+// ranges those reads covered. A forward read inside the covered ranges is
+// answered locally, paged by `max_count` with local continuation points; a
+// read whose head is covered goes to the server for the rest only. Coverage
+// never extends past the moment a read was issued, so newer values are always
+// fetched.
+//
+// Only empty, boolean and integer or double scalar values are cached; a series
+// holding any other type passes through. Must be used from a single executor.
+class TimedDataHistoryCache : public scada::HistoryService {
+ public:
+  TimedDataHistoryCache(std::shared_ptr<scada::HistoryService> history_service,
+                        TimedDataHistoryCacheOptions options);
+  ~TimedDataHistoryCache() override;
+
+  TimedDataHistoryCache(const TimedDataHistoryCache&) = delete;
+  TimedDataHistoryCache& operator=(const TimedDataHistoryCache&) = delete;
+
+  // scada::HistoryService
+  Awaitable<scada::HistoryReadRawResult> HistoryReadRaw(
+      scada::HistoryReadRawDetails details) override;
+  Awaitable<scada::HistoryReadEventsResult> HistoryReadEvents(
+      scada::NodeId node_id,
+      scada::base::Time from,
+      scada::base::Time to,
+      scada::EventFilter filter) override;
+
+  // Diagnostics.
+  size_t local_read_count() const { return local_read_count_; }
+  size_t remote_read_count() const { return remote_read_count_; }
+
+ private:
+  struct Segment;
+
+  // A paged server read whose pages are still to come.
+  struct PendingRead {
+    Segment* segment = nullptr;
+    scada::DateTime from;
+    scada::DateTime ready_limit;
+  };
+
+  Segment& GetSegment(const scada::NodeId& node_id,
+                      const scada::AggregateFilter& aggregation);
+
+  void Load(Segment& segment);
+
+  // Records a server answer that starts at `pending.from`. Returns the
+  // continuation of `pending` if the answer is paged.
+  PendingRead OnRemoteRead(const PendingRead& pending,
+                           const scada::HistoryReadRawResult& result);
+
+  // Returns `values` as one page of the local read `details`. If `more`,
+  // truncates them to `details.max_count` and stores the rest of the read
+  // under a new continuation point.
+  scada::HistoryReadRawResult MakeLocalPage(
+      std::vector<scada::DataValue> values,
+      scada::HistoryReadRawDetails details,
+      bool more);
+
+  void Store(Segment& segment,
+             std::span<const scada::DataValue> values,
+             const scada::DateTimeRange& ready_range);
+
+  const std::shared_ptr<scada::HistoryService> history_service_;
+  const TimedDataHistoryCacheOptions options_;
+
+  std::unordered_map<std::string, std::unique_ptr<Segment>> segments_;
+  std::map<scada::ByteString, PendingRead> pending_reads_;
+
+  // Local reads with pages still to come, by continuation point.
+  std::map<scada::ByteString, scada::HistoryReadRawDetails> local_reads_;
+  size_t next_local_read_id_ = 0;
+
+  size_t local_read_count_ = 0;
+  size_t remote_read_count_ = 0;
+
+  inline static BoostLogger logger_{LOG_NAME("TimedDataHistoryCache")};
+};
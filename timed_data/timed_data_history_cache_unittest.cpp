@@ -0,0 +1,231 @@
+#include "timed_data/timed_data_history_cache.h"
+
+#include "base/test/awaitable_test.h"
+#include "base/test/test_executor.h"
+#include "scada/standard_node_ids.h"
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+
+using namespace testing;
+
+namespace {
+
+// Serves a fixed series and counts the reads that reach it.
+class SeriesHistoryService final : public scada::HistoryService {
+ public:
+  Awaitable<scada::HistoryReadRawResult> HistoryReadRaw(
+      scada::HistoryReadRawDetails details) override {
+    ++read_count;
+    last_details = details;
+    std::vector<scada::DataValue> result;
+    for (const auto& value : values) {
+      if (value.source_timestamp >= details.from &&
+          value.source_timestamp <= details.to) {
+        result.emplace_back(value);
+      }
+    }
+    co_return scada::HistoryReadRawResult{
+        .status = scada::StatusCode::Good,
+        .values = std::move(result),
+        .continuation_point = continuation_point,
+    };
+  }
+
+  Awaitable<scada::HistoryReadEventsResult> HistoryReadEvents(
+      scada::NodeId node_id,
+      scada::base::Time from,
+      scada::base::Time to,
+      scada::EventFilter filter) override {
+    co_return scada::HistoryReadEventsResult{.status = scada::StatusCode::Bad};
+  }
+
+  std::vector<scada::DataValue> values;
+  scada::ByteString continuation_point;
+  int read_count = 0;
+  scada::HistoryReadRawDetails last_details;
+};
+
+class TimedDataHistoryCacheTest : public Test {
+ protected:
+  TimedDataHistoryCacheTest() {
+    std::filesystem::remove_all(directory_);
+    for (int i = 0; i < 100; ++i) {
+      auto time = Time(i);
+      history_service_->values.emplace_back(scada::Variant{i * 1.5},
+                                            scada::Qualifier{}, time, time);
+    }
+  }
+
+  ~TimedDataHistoryCacheTest() override {
+    std::filesystem::remove_all(directory_);
+  }
+
+  std::unique_ptr<TimedDataHistoryCache> MakeCache() {
+    return std::make_unique<TimedDataHistoryCache>(
+        history_service_,
+        TimedDataHistoryCacheOptions{.directory = directory_});
+  }
+
+  // Fixed in the past, so no read is clipped at "now".
+  scada::DateTime Time(int minutes) const {
+    return base_time_ + scada::base::TimeDelta::FromMinutes(minutes);
+  }
+
+  scada::HistoryReadRawResult Read(TimedDataHistoryCache& cache,
+                                   int from,
+                                   int to) {
+    return WaitAwaitable(
+        executor_,
+        cache.HistoryReadRaw({.node_id = scada::id::RootFolder,
+                              .from = Time(from),
+                              .to = Time(to)}));
+  }
+
+  TestExecutor executor_;
+
+  const std::filesystem::path directory_ =
+      std::filesystem::temp_directory_path() / "timed_data_history_cache_test";
+  const scada::DateTime base_time_ =
+      scada::DateTime::Now() - scada::base::TimeDelta::FromDays(1);
+
+  const std::shared_ptr<SeriesHistoryService> history_service_ =
+      std::make_shared<SeriesHistoryService>();
+};
+
+}  // namespace
+
+TEST_F(TimedDataHistoryCacheTest, ServesCoveredRangeLocally) {
+  auto cache = MakeCache();
+
+  EXPECT_THAT(Read(*cache, 0, 50).values, SizeIs(51));
+  EXPECT_EQ(history_service_->read_count, 1);
+
+  auto result = Read(*cache, 10, 20);
+  EXPECT_EQ(history_service_->read_count, 1);
+  EXPECT_EQ(cache->local_read_count(), 1u);
+  ASSERT_THAT(result.values, SizeIs(11));
+  EXPECT_EQ(result.values.front().source_timestamp, Time(10));
+  EXPECT_EQ(result.values.front().value, scada::Variant{10 * 1.5});
+}
+
+TEST_F(TimedDataHistoryCacheTest, ReopenedCacheFetchesOnlyTail) {
+  Read(*MakeCache(), 0, 50);
+  ASSERT_EQ(history_service_->read_count, 1);
+
+  auto cache = MakeCache();
+  auto result = Read(*cache, 0, 80);
+
+  EXPECT_EQ(history_service_->read_count, 2);
+  EXPECT_EQ(history_service_->last_details.from, Time(50));
+  EXPECT_EQ(history_service_->last_details.to, Time(80));
+  ASSERT_THAT(result.values, SizeIs(81));
+  EXPECT_EQ(result.values.front().source_timestamp, Time(0));
+  EXPECT_EQ(result.values.back().source_timestamp, Time(80));
+}
+
+TEST_F(TimedDataHistoryCacheTest, PagedReadCoversItsPages) {
+  auto cache = MakeCache();
+
+  history_service_->continuation_point = {'1'};
+  auto result = Read(*cache, 0, 50);
+  ASSERT_FALSE(result.continuation_point.empty());
+
+  history_service_->continuation_point.clear();
+  WaitAwaitable(executor_, cache->HistoryReadRaw(
+                               {.node_id = scada::id::RootFolder,
+                                .from = Time(50),
+                                .to = Time(0),
+                                .continuation_point = result.continuation_point}));
+  ASSERT_EQ(history_service_->read_count, 2);
+
+  Read(*cache, 0, 50);
+  EXPECT_EQ(history_service_->read_count, 2);
+}
+
+TEST_F(TimedDataHistoryCacheTest, TornSegmentIsTruncated) {
+  Read(*MakeCache(), 0, 50);
+
+  auto path = std::filesystem::directory_iterator{directory_}->path();
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+  // The lost ready record makes the range a gap again.
+  auto cache = MakeCache();
+  EXPECT_THAT(Read(*cache, 0, 50).values, SizeIs(51));
+  EXPECT_EQ(history_service_->read_count, 2);
+}
+
+TEST_F(TimedDataHistoryCacheTest, UncacheableSeriesPassesThrough) {
+  history_service_->values[5].value = scada::Variant{std::string{"text"}};
+  auto cache = MakeCache();
+
+  Read(*cache, 0, 50);
+  Read(*cache, 0, 50);
+
+  EXPECT_EQ(history_service_->read_count, 2);
+  EXPECT_EQ(cache->local_read_count(), 0u);
+}
+
+TEST_F(TimedDataHistoryCacheTest, CoveredReadIsPaged) {
+  auto cache = MakeCache();
+  Read(*cache, 0, 50);
+  ASSERT_EQ(history_service_->read_count, 1);
+
+  scada::HistoryReadRawDetails details{.node_id = scada::id::RootFolder,
+                                       .from = Time(0),
+                                       .to = Time(10),
+                                       .max_count = 4};
+  std::vector<size_t> page_sizes;
+  std::vector<scada::DataValue> values;
+  for (;;) {
+    auto result = WaitAwaitable(executor_, cache->HistoryReadRaw(details));
+    page_sizes.emplace_back(result.values.size());
+    values.insert(values.end(), result.values.begin(), result.values.end());
+    if (result.continuation_point.empty())
+      break;
+    details.continuation_point = result.continuation_point;
+  }
+
+  EXPECT_THAT(page_sizes, ElementsAre(4, 4, 3));
+  ASSERT_THAT(values, SizeIs(11));
+  for (int i = 0; i < 11; ++i)
+    EXPECT_EQ(values[i].source_timestamp, Time(i));
+  EXPECT_EQ(history_service_->read_count, 1);
+}
+
+TEST_F(TimedDataHistoryCacheTest, ReleasedLocalPageEndsRead) {
+  auto cache = MakeCache();
+  Read(*cache, 0, 50);
+
+  auto result = WaitAwaitable(
+      executor_, cache->HistoryReadRaw({.node_id = scada::id::RootFolder,
+                                        .from = Time(0),
+                                        .to = Time(10),
+                                        .max_count = 4}));
+  ASSERT_FALSE(result.continuation_point.empty());
+
+  auto released = WaitAwaitable(
+      executor_, cache->HistoryReadRaw(
+                     {.node_id = scada::id::RootFolder,
+                      .release_continuation_point = true,
+                      .continuation_point = result.continuation_point}));
+  EXPECT_TRUE(released.values.empty());
+  EXPECT_TRUE(released.continuation_point.empty());
+  EXPECT_EQ(history_service_->read_count, 1);
+}
+
+TEST_F(TimedDataHistoryCacheTest, Int32ValuesKeepTheirType) {
+  for (int i = 0; i < 100; ++i)
+    history_service_->values[i].value = scada::Variant{scada::Int32{-i}};
+
+  Read(*MakeCache(), 0, 50);
+
+  // Read back from the segment file.
+  auto cache = MakeCache();
+  auto result = Read(*cache, 0, 50);
+  EXPECT_EQ(history_service_->read_count, 1);
+  ASSERT_THAT(result.values, SizeIs(51));
+  EXPECT_EQ(result.values[7].value.type(), scada::Variant::INT32);
+  EXPECT_EQ(result.values[7].value, scada::Variant{scada::Int32{-7}});
+}
@@ -22,7 +22,8 @@ TimedDataImpl::TimedDataImpl(scada::AggregateFilter aggregate_filter,
       timed_data_fetcher_{
           history_service_
               ? std::make_shared<TimedDataFetcher>(TimedDataFetcherContext{
-                    buffer_, executor_, *history_service_, aggregate_filter_})
+                    buffer_, executor_, *history_service_, aggregate_filter_,
+                    fetch_scheduler_})
               : nullptr} {}
 
 TimedDataImpl::~TimedDataImpl() {
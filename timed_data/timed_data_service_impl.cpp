@@ -8,6 +8,7 @@
 #include "timed_data/alias_timed_data.h"
 #include "timed_data/error_timed_data.h"
 #include "timed_data/expression_timed_data.h"
+#include "timed_data/timed_data_fetch_scheduler.h"
 #include "timed_data/timed_data_impl.h"
 
 template <class T>
@@ -26,6 +27,9 @@ TimedDataServiceImpl::TimedDataServiceImpl(TimedDataContext&& context)
   if (!history_service_) {
     history_service_ = data_services_.history_service_;
   }
+  if (!fetch_scheduler_) {
+    fetch_scheduler_ = std::make_shared<TimedDataFetchScheduler>();
+  }
 }
 
 TimedDataServiceImpl::TimedDataServiceImpl(CoroutineTimedDataContext&& context)